@@ -0,0 +1,1283 @@
+//
+// Micro benchmarks for the containers. Runs all benchmarks if no argument is given,
+// otherwise only the ones whose name is given as argument.
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <pthread.h>
+#include <queue>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "map.hpp"
+#include "set.hpp"
+#include "concurrent.hpp"
+#include "queue.hpp"
+#include "deque.hpp"
+#include "incremental_vector.hpp"
+#include "stack.hpp"
+#include "frozen_map.hpp"
+#include "small_vector.hpp"
+#include "mmap_allocator.hpp"
+#include "arena_allocator.hpp"
+#include "counting_allocator.hpp"
+#include "algorithm.hpp"
+#include "parallel.hpp"
+#include "serialize.hpp"
+#include "region_allocator.hpp"
+
+/**
+ * Returns a monotonic timestamp in nanoseconds.
+ *
+ * @return The current time in nanoseconds.
+ */
+static inline double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Prints one result line of a benchmark.
+ *
+ * @param what The name of the measured operation.
+ * @param nanos The measured total time in nanoseconds.
+ * @param ops The count of operations performed during the measured time.
+ */
+static inline void report(const std::string & what, double nanos, std::size_t ops) {
+    std::cout << "  " << std::left << std::setw(40) << what
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << nanos / ops << " ns/op" << std::endl;
+}
+
+/**
+ * Prints one result line that is not a time.
+ *
+ * @param what The name of the value.
+ * @param value The value.
+ */
+static inline void reportValue(const std::string & what, double value) {
+    std::cout << "  " << std::left << std::setw(40) << what
+              << std::right << std::setw(12) << value << std::endl;
+}
+
+/**
+ * A sink for computed values, prevents the compiler from removing the measured code.
+ */
+static volatile long sink;
+
+/**
+ * Compares the lookups of the map with the ones of the frozen map.
+ */
+static void benchFrozenMap() {
+    const std::size_t sizes[] = { 1000, 100000, 1000000 };
+    const std::size_t lookups = 2000000;
+
+    for (std::size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); ++s) {
+        ft::map<int, int> m;
+        for (std::size_t i = 0; i < sizes[s]; ++i) {
+            m[static_cast<int>(random())] = static_cast<int>(i);
+        }
+        int * keys = new int[lookups];
+        for (std::size_t i = 0; i < lookups; ++i) {
+            keys[i] = static_cast<int>(random());
+        }
+        std::cout << " n = " << m.size() << std::endl;
+
+        long sum = 0;
+        double start = now();
+        for (std::size_t i = 0; i < lookups; ++i) {
+            ft::map<int, int>::iterator it = m.find(keys[i]);
+            sum += it == m.end() ? 0 : it->second;
+            sum += m.lower_bound(keys[i]) == m.end();
+        }
+        report("ft::map find + lower_bound", now() - start, lookups);
+
+        start = now();
+        ft::frozen_map<int, int> f = m.freeze();
+        report("ft::map::freeze (per element)", now() - start, m.size());
+
+        start = now();
+        for (std::size_t i = 0; i < lookups; ++i) {
+            ft::frozen_map<int, int>::const_iterator it = f.find(keys[i]);
+            sum -= it == f.end() ? 0 : it->second;
+            sum -= f.lower_bound(keys[i]) == f.end();
+        }
+        report("ft::frozen_map find + lower_bound", now() - start, lookups);
+        sink = sum;
+        delete[] keys;
+    }
+}
+
+/**
+ * The tag of the statistics recorded by the counting allocators of the benchmarks.
+ */
+struct BenchTag {};
+
+/**
+ * Returns the statistics recorded by the counting allocators of the benchmarks.
+ *
+ * @return The statistics.
+ */
+static ft::allocation_stats & benchStats() {
+    return ft::tag_allocation_stats<BenchTag>();
+}
+
+/**
+ * Builds, queries and destroys many small maps of the given type.
+ *
+ * @tparam Map The type of the map.
+ * @param what The name of the benchmarked map.
+ */
+template<class Map>
+static void benchSmallMap(const std::string & what) {
+    const std::size_t rounds = 200000;
+    const std::size_t size   = 6;
+
+    long sum = 0;
+    benchStats().reset();
+    double start = now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        Map m;
+        for (std::size_t i = 0; i < size; ++i) {
+            m[static_cast<int>((r + i * 7) % 13)] = static_cast<int>(i);
+        }
+        for (int k = 0; k < 13; ++k) {
+            sum += m.count(k);
+        }
+    }
+    report(what, now() - start, rounds);
+    reportValue("  allocations per map", static_cast<double>(benchStats().allocations) / rounds);
+    sink = sum;
+}
+
+/**
+ * Compares small maps with and without inline nodes.
+ */
+static void benchSmallMaps() {
+    typedef ft::pair<const int, int> value;
+
+    benchSmallMap<ft::map<int, int, ft::less<int>, ft::counting_allocator<value, BenchTag> > >("ft::map, 6 elements");
+    benchSmallMap<ft::map<int, int, ft::less<int>, ft::counting_allocator<value, BenchTag>, ft::tree_options<8> > >("ft::map, 8 inline nodes, 6 elements");
+}
+
+/**
+ * Fills and sums many short-lived vectors of the given type.
+ *
+ * @tparam Vector The type of the vector.
+ * @param what The name of the benchmarked vector.
+ */
+template<class Vector>
+static void benchShortVector(const std::string & what) {
+    const std::size_t rounds = 1000000;
+
+    long sum = 0;
+    benchStats().reset();
+    double start = now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        Vector v;
+        for (std::size_t i = 0; i < 1 + r % 16; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        for (typename Vector::const_iterator it = v.begin(); it != v.end(); ++it) {
+            sum += *it;
+        }
+    }
+    report(what, now() - start, rounds);
+    reportValue("  allocations per vector", static_cast<double>(benchStats().allocations) / rounds);
+    sink = sum;
+}
+
+/**
+ * Compares short vectors with and without an inline buffer.
+ */
+static void benchSmallVectors() {
+    benchShortVector<ft::vector<int, ft::counting_allocator<int, BenchTag> > >("ft::vector, 1 - 16 elements");
+    benchShortVector<ft::small_vector<int, 16, ft::counting_allocator<int, BenchTag> > >("ft::small_vector<16>, 1 - 16 elements");
+    benchShortVector<ft::small_vector<int, 8, ft::counting_allocator<int, BenchTag> > >("ft::small_vector<8>, 1 - 16 elements");
+}
+
+/**
+ * Grows a big vector by pushing back elements, measuring the total and the longest single push.
+ *
+ * @tparam Vector The type of the vector.
+ * @param what The name of the benchmarked vector.
+ */
+template<class Vector>
+static void benchGrowingVector(const std::string & what) {
+    const std::size_t count = 1 << 27;
+
+    Vector v;
+    double longest = 0;
+    double start   = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (v.size() == v.capacity()) {
+            double before = now();
+            v.push_back(static_cast<int>(i));
+            double took = now() - before;
+            longest = took > longest ? took : longest;
+        } else {
+            v.push_back(static_cast<int>(i));
+        }
+    }
+    report(what, now() - start, count);
+    reportValue("  longest push (ms)", longest / 1e6);
+    sink = v.back();
+}
+
+/**
+ * Compares the growth of a vector of 512 MiB using the default and the mmap allocator.
+ */
+static void benchBigVectors() {
+    benchGrowingVector<ft::vector<int> >("ft::vector, 2^27 push_back");
+    benchGrowingVector<ft::vector<int, ft::mmap_allocator<int> > >("ft::vector, mmap_allocator, 2^27 push_back");
+}
+
+/**
+ * Compares growing vectors of integers by resize, which zeroes the new elements, and by
+ * resize_uninitialized, which leaves them to be written by the caller.
+ */
+static void benchResize() {
+    const std::size_t count  = 1 << 24;
+    const std::size_t rounds = 32;
+
+    long   sum   = 0;
+    double start = now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        ft::vector<int> v;
+        v.resize(count);
+        v[r] = static_cast<int>(r);
+        sum += v[r];
+    }
+    report("ft::vector, resize to 2^24", now() - start, rounds);
+
+    start = now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        ft::vector<int> v;
+        v.resize_uninitialized(count);
+        v[r] = static_cast<int>(r);
+        sum += v[r];
+    }
+    report("ft::vector, resize_uninitialized 2^24", now() - start, rounds);
+    sink = sum;
+}
+
+/**
+ * Fills a vector of the given type and empties it again by popping, many times.
+ *
+ * @tparam Vector The type of the vector.
+ * @param what The name of the benchmarked vector.
+ */
+template<class Vector>
+static void benchFillAndDrain(const std::string & what) {
+    const std::size_t count  = 1 << 20;
+    const std::size_t rounds = 32;
+
+    Vector v;
+    double start = now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        for (std::size_t i = 0; i < count; ++i) {
+            v.push_back(static_cast<int>(i));
+        }
+        while (!v.empty()) {
+            v.pop_back();
+        }
+    }
+    report(what, now() - start, rounds * count);
+    reportValue("  capacity when drained", static_cast<double>(v.capacity()));
+}
+
+/**
+ * Compares the growth policies keeping and releasing the spare memory, and times shrink_to_fit.
+ */
+static void benchShrink() {
+    benchFillAndDrain<ft::vector<int> >("ft::vector, push and pop 2^20");
+    benchFillAndDrain<ft::vector<int, std::allocator<int>, ft::shrink_hysteresis<> > >("shrink_hysteresis, push and pop 2^20");
+
+    const std::size_t count  = 1 << 22;
+    const std::size_t rounds = 32;
+
+    std::size_t total = 0;
+    double      start = now();
+    for (std::size_t r = 0; r < rounds; ++r) {
+        ft::vector<int> v(count, static_cast<int>(r));
+        v.resize(count / 8);
+        v.shrink_to_fit();
+        total += v.capacity();
+    }
+    report("ft::vector, shrink_to_fit 2^22 to 2^19", now() - start, rounds);
+    sink = static_cast<long>(total);
+}
+
+/**
+ * Pushes many elements onto a stack of the given type, timing every single push, and prints
+ * the median and the tail latencies.
+ *
+ * @tparam Stack The type of the stack.
+ * @param what The name of the benchmarked stack.
+ */
+template<class Stack>
+static void benchStackPush(const std::string & what) {
+    const std::size_t count = 1 << 23;
+
+    float * latencies = new float[count];
+    Stack st;
+    double start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        double before = now();
+        st.push(static_cast<int>(i));
+        latencies[i] = static_cast<float>(now() - before);
+    }
+    report(what, now() - start, count);
+    const char *       names[]     = { "  p50 (ns)", "  p99 (ns)", "  p999 (ns)", "  max (ns)" };
+    const std::size_t  positions[] = { count / 2, count / 100 * 99, count / 1000 * 999, count - 1 };
+    for (std::size_t i = 0; i < sizeof(positions) / sizeof(*positions); ++i) {
+        std::nth_element(latencies, latencies + positions[i], latencies + count);
+        reportValue(names[i], latencies[positions[i]]);
+    }
+    sink = st.top();
+    delete[] latencies;
+}
+
+/**
+ * Compares the push latencies of stacks on top of a vector, a deque and an incremental vector.
+ */
+static void benchStacks() {
+    benchStackPush<ft::stack<int, ft::vector<int> > >("ft::stack on ft::vector, 2^23 push");
+    benchStackPush<ft::stack<int, ft::deque<int> > >("ft::stack on ft::deque, 2^23 push");
+    benchStackPush<ft::stack<int, ft::incremental_vector<int> > >("ft::stack on incremental_vector, 2^23 push");
+}
+
+/**
+ * Simulates a timer wheel on a priority queue of the given type: the queue is built from a range,
+ * the earliest timers are rescheduled many times and then all of them are popped.
+ *
+ * @tparam Queue The type of the priority queue.
+ * @param what The name of the benchmarked queue.
+ * @param reschedule The function replacing the top element by the given value.
+ */
+template<class Queue>
+static void benchTimers(const std::string & what, void (*reschedule)(Queue &, int)) {
+    const std::size_t count  = 1000000;
+    const std::size_t rounds = 4000000;
+
+    int * deadlines = new int[count];
+    for (std::size_t i = 0; i < count; ++i) {
+        deadlines[i] = static_cast<int>(random());
+    }
+    long sum = 0;
+    double start = now();
+    Queue q(deadlines, deadlines + count);
+    report(what + ": build (per element)", now() - start, count);
+
+    start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        sum += q.top();
+        reschedule(q, q.top() - static_cast<int>(random() % 1000000));
+    }
+    report(what + ": reschedule", now() - start, rounds);
+
+    start = now();
+    while (!q.empty()) {
+        sum += q.top();
+        q.pop();
+    }
+    report(what + ": pop", now() - start, count);
+    sink = sum;
+    delete[] deadlines;
+}
+
+template<class Queue>
+static void popPush(Queue & q, int value) {
+    q.pop();
+    q.push(value);
+}
+
+template<class Queue>
+static void replaceTop(Queue & q, int value) {
+    q.replace_top(value);
+}
+
+/**
+ * Compares std::priority_queue with the priority queue using different arities.
+ */
+static void benchPriorityQueues() {
+    typedef std::priority_queue<int>                                       stdQueue;
+    typedef ft::priority_queue<int, ft::vector<int>, ft::less<int>, 2>     binaryQueue;
+    typedef ft::priority_queue<int, ft::vector<int>, ft::less<int>, 4>     quaternaryQueue;
+    typedef ft::priority_queue<int, ft::vector<int>, ft::less<int>, 8>     octaryQueue;
+
+    benchTimers<stdQueue>("std, pop+push", popPush<stdQueue>);
+    benchTimers<binaryQueue>("ft 2-ary, pop+push", popPush<binaryQueue>);
+    benchTimers<binaryQueue>("ft 2-ary, replace", replaceTop<binaryQueue>);
+    benchTimers<quaternaryQueue>("ft 4-ary, replace", replaceTop<quaternaryQueue>);
+    benchTimers<octaryQueue>("ft 8-ary, replace", replaceTop<octaryQueue>);
+}
+
+/**
+ * A stack protected by a mutex, offering the interface of the concurrent containers.
+ */
+class LockedStack {
+public:
+    explicit LockedStack(std::size_t) { pthread_mutex_init(&mutex, NULL); }
+   ~LockedStack()                     { pthread_mutex_destroy(&mutex);    }
+
+    bool push(const long & value) {
+        pthread_mutex_lock(&mutex);
+        st.push(value);
+        pthread_mutex_unlock(&mutex);
+        return true;
+    }
+
+    bool pop(long & value) {
+        pthread_mutex_lock(&mutex);
+        const bool popped = !st.empty();
+        if (popped) {
+            value = st.top();
+            st.pop();
+        }
+        pthread_mutex_unlock(&mutex);
+        return popped;
+    }
+
+private:
+    pthread_mutex_t mutex;
+    ft::stack<long> st;
+};
+
+/**
+ * A FIFO queue protected by a mutex, offering the interface of the concurrent containers.
+ */
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t) { pthread_mutex_init(&mutex, NULL); }
+   ~LockedQueue()                     { pthread_mutex_destroy(&mutex);    }
+
+    bool push(const long & value) {
+        pthread_mutex_lock(&mutex);
+        q.push_back(value);
+        pthread_mutex_unlock(&mutex);
+        return true;
+    }
+
+    bool pop(long & value) {
+        pthread_mutex_lock(&mutex);
+        const bool popped = !q.empty();
+        if (popped) {
+            value = q.front();
+            q.pop_front();
+        }
+        pthread_mutex_unlock(&mutex);
+        return popped;
+    }
+
+private:
+    pthread_mutex_t mutex;
+    ft::deque<long> q;
+};
+
+/**
+ * The work of one thread handing values over through a shared container.
+ *
+ * @tparam Container The type of the shared container.
+ */
+template<class Container>
+struct HandOff {
+    Container * container;
+    std::size_t items;
+    long        sum;
+};
+
+template<class Container>
+static void * produce(void * arg) {
+    HandOff<Container> * work = static_cast<HandOff<Container> *>(arg);
+    for (std::size_t i = 0; i < work->items; ++i) {
+        while (!work->container->push(static_cast<long>(i))) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+template<class Container>
+static void * consume(void * arg) {
+    HandOff<Container> * work = static_cast<HandOff<Container> *>(arg);
+    long value;
+    for (std::size_t i = 0; i < work->items; ++i) {
+        while (!work->container->pop(value)) {
+            sched_yield();
+        }
+        work->sum += value;
+    }
+    return NULL;
+}
+
+/**
+ * Hands values from the given count of producing threads over to the given count of consuming
+ * threads through a container of the given type, and prints the time per handed over value.
+ *
+ * @tparam Container The type of the shared container.
+ * @param what The name of the benchmarked container.
+ * @param producers The count of producing threads.
+ * @param consumers The count of consuming threads.
+ */
+template<class Container>
+static void benchHandOff(const std::string & what, std::size_t producers, std::size_t consumers) {
+    const std::size_t items = 1 << 21;
+
+    Container                        container(1024);
+    std::vector<pthread_t>           threads(producers + consumers);
+    std::vector<HandOff<Container> > work(producers + consumers);
+    double start = now();
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        work[i].container = &container;
+        work[i].items     = items / (i < producers ? producers : consumers);
+        work[i].sum       = 0;
+        pthread_create(&threads[i], NULL, i < producers ? produce<Container> : consume<Container>, &work[i]);
+    }
+    long sum = 0;
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        pthread_join(threads[i], NULL);
+        sum += work[i].sum;
+    }
+    report(what, now() - start, items);
+    sink = sum;
+}
+
+/**
+ * Compares the concurrent containers with the mutex protected stack and queue.
+ */
+static void benchConcurrent() {
+    benchHandOff<LockedStack>("mutex + ft::stack, 4 -> 4 threads", 4, 4);
+    benchHandOff<ft::treiber_stack<long> >("ft::treiber_stack, 4 -> 4 threads", 4, 4);
+    benchHandOff<LockedQueue>("mutex + ft::deque, 1 -> 1 thread", 1, 1);
+    benchHandOff<ft::spsc_queue<long> >("ft::spsc_queue, 1 -> 1 thread", 1, 1);
+    benchHandOff<LockedQueue>("mutex + ft::deque, 4 -> 4 threads", 4, 4);
+    benchHandOff<ft::mpmc_queue<long> >("ft::mpmc_queue, 4 -> 4 threads", 4, 4);
+}
+
+/**
+ * Builds and tears down the containers of one simulated request.
+ *
+ * @tparam Map The type of the map.
+ * @tparam Vector The type of the vector.
+ * @param m An empty map.
+ * @param v An empty vector.
+ * @param request The number of the request.
+ * @return A value computed from the containers.
+ */
+template<class Map, class Vector>
+static long handleRequest(Map & m, Vector & v, std::size_t request) {
+    for (std::size_t i = 0; i < 500; ++i) {
+        const int key = static_cast<int>((request * 31 + i * 7919) % 100003);
+        m[key] = static_cast<int>(i);
+        v.push_back(key);
+    }
+    long sum = 0;
+    for (std::size_t i = 0; i < v.size(); i += 3) {
+        sum += m.find(v[i])->second;
+    }
+    return sum;
+}
+
+/**
+ * Compares request-scoped maps and vectors using the default allocator with the ones using
+ * an arena that is released after every request.
+ */
+static void benchArena() {
+    typedef ft::pair<const int, int> value;
+    const std::size_t requests = 20000;
+
+    long sum = 0;
+    double start = now();
+    for (std::size_t r = 0; r < requests; ++r) {
+        ft::map<int, int> m;
+        ft::vector<int>   v;
+        sum += handleRequest(m, v, r);
+    }
+    report("std::allocator, per request", now() - start, requests);
+
+    ft::arena memory;
+    start = now();
+    for (std::size_t r = 0; r < requests; ++r) {
+        {
+            ft::map<int, int, ft::less<int>, ft::arena_allocator<value> > m((ft::less<int>()), memory);
+            ft::vector<int, ft::arena_allocator<int> >                    v(memory);
+            sum -= handleRequest(m, v, r);
+        }
+        memory.release();
+    }
+    report("ft::arena_allocator, per request", now() - start, requests);
+    sink = sum;
+}
+
+/**
+ * Fills a container of the given type using a counting allocator, then prints its memory
+ * usage and the recorded allocation statistics.
+ *
+ * @tparam Container The type of the container.
+ * @tparam Inserter The type of the function inserting one element.
+ * @param what The name of the container.
+ * @param insert The function inserting the element with the given number.
+ */
+template<class Container, class Inserter>
+static void benchMemoryOf(const std::string & what, Inserter insert) {
+    const std::size_t count = 100000;
+
+    benchStats().reset();
+    {
+        Container c;
+        for (std::size_t i = 0; i < count; ++i) {
+            insert(c, static_cast<int>(i));
+        }
+        const ft::memory_report usage = c.memory_usage();
+        std::cout << " " << what << std::endl;
+        reportValue("  payload bytes per element", static_cast<double>(usage.payload_bytes) / count);
+        reportValue("  overhead bytes per element", static_cast<double>(usage.overhead_bytes) / count);
+        reportValue("  allocated bytes per element", static_cast<double>(benchStats().live_bytes) / count);
+    }
+    const ft::allocation_stats & stats = benchStats();
+    reportValue("  allocations", stats.allocations);
+    reportValue("  peak bytes per element", static_cast<double>(stats.peak_bytes) / count);
+    for (std::size_t i = 0; i < ft::allocation_stats::buckets; ++i) {
+        if (stats.histogram[i] != 0) {
+            std::ostringstream bucket;
+            bucket << "  requests of " << (static_cast<std::size_t>(1) << i) << " - " << (static_cast<std::size_t>(2) << i) - 1 << " bytes";
+            reportValue(bucket.str(), stats.histogram[i]);
+        }
+    }
+}
+
+template<class Map>
+static void insertIntoMap(Map & m, int i) { m[i] = i; }
+
+template<class Set>
+static void insertIntoSet(Set & s, int i) { s.insert(i); }
+
+template<class Vector>
+static void pushIntoVector(Vector & v, int i) { v.push_back(i); }
+
+/**
+ * Reports the memory used by maps, sets and vectors of integers.
+ */
+static void benchMemory() {
+    typedef ft::map<int, int, ft::less<int>, ft::counting_allocator<ft::pair<const int, int>, BenchTag> > countedMap;
+    typedef ft::set<int, ft::less<int>, ft::counting_allocator<int, BenchTag> >                          countedSet;
+    typedef ft::vector<int, ft::counting_allocator<int, BenchTag> >                                      countedVector;
+
+    benchMemoryOf<countedMap>("ft::map<int, int>", insertIntoMap<countedMap>);
+    benchMemoryOf<countedSet>("ft::set<int>", insertIntoSet<countedSet>);
+    benchMemoryOf<countedVector>("ft::vector<int>", pushIntoVector<countedVector>);
+}
+
+/**
+ * Inserts keys produced by the given function into a counting map, then looks up every key
+ * once, reporting the shape of the tree and the counted work per operation.
+ *
+ * @param what The name of the key order.
+ * @param key The function producing the key with the given number.
+ */
+static void benchTreeStatsOf(const std::string & what, int (*key)(int)) {
+    const int count = 100000;
+
+    ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, ft::tree_options<0, ft::tree_stats> > m;
+    for (int i = 0; i < count; ++i) {
+        m[key(i)] = i;
+    }
+    const ft::tree_counters inserts = m.stats().counters;
+    m.reset_stats();
+    for (int i = 0; i < count; ++i) {
+        sink += m.find(key(i))->second;
+    }
+    const ft::tree_statistics stats = m.stats();
+    std::cout << " " << what << std::endl;
+    reportValue("  height", stats.height);
+    reportValue("  black height", stats.black_height);
+    reportValue("  comparisons per insert", static_cast<double>(inserts.comparisons) / count);
+    reportValue("  rotations per insert", static_cast<double>(inserts.rotations) / count);
+    reportValue("  recolours per insert", static_cast<double>(inserts.recolours) / count);
+    reportValue("  fixups per insert", static_cast<double>(inserts.fixups) / count);
+    reportValue("  comparisons per find", static_cast<double>(stats.counters.comparisons) / count);
+    reportValue("  average search depth", stats.counters.average_search_depth());
+}
+
+static int sequentialKey(int i) { return i; }
+
+static int scatteredKey(int i) { return static_cast<int>((i * 2654435761u) % 1000003u); }
+
+/**
+ * Reports the work done by the tree for sequential and for scattered keys.
+ */
+static void benchTreeStats() {
+    benchTreeStatsOf("sequential keys", sequentialKey);
+    benchTreeStatsOf("scattered keys", scatteredKey);
+}
+
+/**
+ * Measures the main operations of the given map type and the memory allocated per element.
+ *
+ * @tparam Map The type of the map, using the counting allocator of the benchmarks.
+ * @param what The name of the map.
+ * @param keys The keys to be inserted, looked up and erased.
+ * @param count The count of keys.
+ */
+template<class Map>
+static void benchNodeLayoutOf(const std::string & what, const int * keys, std::size_t count) {
+    benchStats().reset();
+    Map m;
+    std::cout << " " << what << std::endl;
+
+    double start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        m[keys[i]] = static_cast<int>(i);
+    }
+    report("  insert", now() - start, count);
+    reportValue("  allocated bytes per element", static_cast<double>(benchStats().live_bytes) / m.size());
+
+    long sum = 0;
+    start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += m.find(keys[i])->second;
+    }
+    report("  find", now() - start, count);
+
+    start = now();
+    for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+        sum += it->second;
+    }
+    report("  iterate", now() - start, m.size());
+
+    start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        m.erase(keys[i]);
+    }
+    report("  erase", now() - start, count);
+    sink = sum;
+}
+
+/**
+ * Compares the default node layout of the map with the compact one.
+ */
+static void benchNodeLayout() {
+    typedef ft::counting_allocator<ft::pair<const int, int>, BenchTag>                                 allocator;
+    typedef ft::map<int, int, ft::less<int>, allocator>                                                defaultMap;
+    typedef ft::map<int, int, ft::less<int>, allocator, ft::tree_options<0, ft::no_tree_stats, true> > compactMap;
+
+    const std::size_t count = 1000000;
+    int * keys = new int[count];
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = static_cast<int>(random());
+    }
+    benchNodeLayoutOf<defaultMap>("ft::map<int, int>", keys, count);
+    benchNodeLayoutOf<compactMap>("ft::map<int, int>, compact nodes", keys, count);
+    delete[] keys;
+}
+
+/**
+ * Refreshes a map from a master copy of the same size, once by assigning it onto the existing
+ * map and once by replacing the map with a new copy.
+ */
+static void benchAssign() {
+    typedef ft::map<int, int, ft::less<int>, ft::counting_allocator<ft::pair<const int, int>, BenchTag> > countedMap;
+
+    const std::size_t count  = 1000000;
+    const std::size_t rounds = 5;
+
+    countedMap master;
+    for (std::size_t i = 0; i < count; ++i) {
+        master[static_cast<int>(random())] = static_cast<int>(i);
+    }
+    countedMap table(master);
+
+    benchStats().reset();
+    double start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        table = master;
+    }
+    report("ft::map assignment (per element)", now() - start, rounds * count);
+    reportValue("  allocations per assignment", static_cast<double>(benchStats().allocations) / rounds);
+
+    benchStats().reset();
+    start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        countedMap fresh(master);
+        table.swap(fresh);
+    }
+    report("ft::map copy and swap (per element)", now() - start, rounds * count);
+    reportValue("  allocations per copy", static_cast<double>(benchStats().allocations) / rounds);
+    sink = static_cast<long>(table.size());
+}
+
+/**
+ * Assigns a vector of the given values repeatedly onto a vector of the same size.
+ *
+ * @tparam Vector The type of the vector.
+ * @param what The name of the vector.
+ * @param value The value of the elements.
+ */
+template<class Vector>
+static void benchVectorAssignOf(const std::string & what, const typename Vector::value_type & value) {
+    const std::size_t count  = 100000;
+    const std::size_t rounds = 50;
+
+    Vector source(count, value);
+    Vector target(count, value);
+    double start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        target = source;
+    }
+    report(what + " operator=", now() - start, rounds * count);
+
+    start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        target.assign(source.begin(), source.end());
+    }
+    report(what + " assign", now() - start, rounds * count);
+    sink = static_cast<long>(target.size());
+}
+
+/**
+ * Compares the assignment of vectors of integers and of strings with the one of std::vector.
+ */
+static void benchVectorAssign() {
+    const std::string text("a string too long to be stored inline");
+
+    benchVectorAssignOf<ft::vector<int> >("ft::vector<int>", 42);
+    benchVectorAssignOf<std::vector<int> >("std::vector<int>", 42);
+    benchVectorAssignOf<ft::vector<std::string> >("ft::vector<string>", text);
+    benchVectorAssignOf<std::vector<std::string> >("std::vector<string>", text);
+}
+
+/**
+ * Compares two equal vectors of the given type, reporting the throughput of the equality and
+ * the ordering operators.
+ *
+ * @tparam Vector The type of the vector.
+ * @param what The name of the vector.
+ */
+template<class Vector>
+static void benchCompareOf(const std::string & what) {
+    const std::size_t bytes  = 1 << 24;
+    const std::size_t count  = bytes / sizeof(typename Vector::value_type);
+    const std::size_t rounds = 20;
+
+    Vector lhs(count, 7), rhs(count, 7);
+    long   sum   = 0;
+    double start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        lhs[i] = 7;
+        sum += lhs == rhs;
+    }
+    reportValue(what + " == (GB/s)", rounds * bytes / (now() - start));
+
+    start = now();
+    for (std::size_t i = 0; i < rounds; ++i) {
+        lhs[i] = 7;
+        sum += lhs < rhs;
+    }
+    reportValue(what + " < (GB/s)", rounds * bytes / (now() - start));
+    sink = sum;
+}
+
+/**
+ * Compares the comparison operators of vectors of bytes and integers with the ones of std::vector.
+ */
+static void benchCompare() {
+    benchCompareOf<ft::vector<unsigned char> >("ft::vector<unsigned char>");
+    benchCompareOf<std::vector<unsigned char> >("std::vector<unsigned char>");
+    benchCompareOf<ft::vector<int> >("ft::vector<int>");
+    benchCompareOf<std::vector<int> >("std::vector<int>");
+}
+
+/**
+ * The sorting algorithms compared by the sort benchmark, each in the ft and in the std version.
+ */
+struct FtSort         { template<class It> void operator()(It first, It last) const { ft::sort(first, last); } };
+struct StdSort        { template<class It> void operator()(It first, It last) const { std::sort(first, last); } };
+struct FtStableSort   { template<class It> void operator()(It first, It last) const { ft::stable_sort(first, last); } };
+struct StdStableSort  { template<class It> void operator()(It first, It last) const { std::stable_sort(first, last); } };
+struct FtPartialSort  { template<class It> void operator()(It first, It last) const { ft::partial_sort(first, first + (last - first) / 16, last); } };
+struct StdPartialSort { template<class It> void operator()(It first, It last) const { std::partial_sort(first, first + (last - first) / 16, last); } };
+struct FtNthElement   { template<class It> void operator()(It first, It last) const { ft::nth_element(first, first + (last - first) / 2, last); } };
+struct StdNthElement  { template<class It> void operator()(It first, It last) const { std::nth_element(first, first + (last - first) / 2, last); } };
+
+/**
+ * Runs the given algorithm repeatedly on fresh copies of the given values, timing only the
+ * algorithm.
+ *
+ * @tparam Algorithm The algorithm to be run.
+ * @param what The name of the algorithm and the elements.
+ * @param values The unsorted values.
+ */
+template<class Algorithm, class T>
+static void benchSortWith(const std::string & what, const ft::vector<T> & values) {
+    const std::size_t rounds = 10;
+
+    double total = 0;
+    for (std::size_t i = 0; i < rounds; ++i) {
+        ft::vector<T> copy(values);
+        const double start = now();
+        Algorithm()(copy.begin(), copy.end());
+        total += now() - start;
+        sink = static_cast<long>(copy.size());
+    }
+    report(what, total, rounds * values.size());
+}
+
+/**
+ * Compares the sorting algorithms with the std ones on the given unsorted values.
+ *
+ * @param what The name of the elements.
+ * @param values The unsorted values.
+ */
+template<class T>
+static void benchSortOf(const std::string & what, const ft::vector<T> & values) {
+    benchSortWith<FtSort>("ft::sort " + what, values);
+    benchSortWith<StdSort>("std::sort " + what, values);
+    benchSortWith<FtStableSort>("ft::stable_sort " + what, values);
+    benchSortWith<StdStableSort>("std::stable_sort " + what, values);
+    benchSortWith<FtPartialSort>("ft::partial_sort " + what, values);
+    benchSortWith<StdPartialSort>("std::partial_sort " + what, values);
+    benchSortWith<FtNthElement>("ft::nth_element " + what, values);
+    benchSortWith<StdNthElement>("std::nth_element " + what, values);
+}
+
+/**
+ * Sorts a million random integers, which ft::sort sorts by their radix, and a hundred thousand
+ * random strings in an ft::vector.
+ */
+static void benchSort() {
+    ft::vector<int>         integers;
+    ft::vector<std::string> strings;
+    for (int i = 0; i < 1000000; ++i) {
+        integers.push_back(static_cast<int>(random()) - RAND_MAX / 2);
+    }
+    for (int i = 0; i < 100000; ++i) {
+        std::ostringstream stream;
+        stream << "key " << random();
+        strings.push_back(stream.str());
+    }
+    benchSortOf("ints", integers);
+    benchSortOf("strings", strings);
+}
+
+/**
+ * Adds one to the given value, the work done per element by the parallel for_each.
+ */
+struct Increment { void operator()(int & value) const { ++value; } };
+
+/**
+ * Runs the parallel algorithms on four million integers in an ft::vector with pools of one
+ * thread up to one thread per processor, doubling the count of threads each time.
+ */
+static void benchParallel() {
+    const std::size_t count = 1 << 22;
+
+    ft::vector<int> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        values.push_back(static_cast<int>(random() % 1000));
+    }
+    const std::size_t hardware = ft::thread_pool::hardware_threads();
+    for (std::size_t threads = 1;; threads = threads * 2 < hardware ? threads * 2 : hardware) {
+        ft::thread_pool    pool(threads);
+        std::ostringstream name;
+        name << " (" << threads << (threads == 1 ? " thread)" : " threads)");
+
+        ft::vector<int> copy(values);
+        double start = now();
+        ft::parallel::sort(pool, copy.begin(), copy.end());
+        report("sort" + name.str(), now() - start, count);
+
+        start = now();
+        ft::parallel::for_each(pool, copy.begin(), copy.end(), Increment());
+        report("for_each" + name.str(), now() - start, count);
+
+        start = now();
+        sink = ft::parallel::reduce(pool, copy.begin(), copy.end(), 0L, ft::plus<long>());
+        report("reduce" + name.str(), now() - start, count);
+
+        start = now();
+        ft::parallel::inclusive_scan(pool, copy.begin(), copy.end(), copy.begin(), ft::plus<int>());
+        report("inclusive_scan" + name.str(), now() - start, count);
+        if (threads == hardware) break;
+    }
+}
+
+/**
+ * Returns the mapped value of the given element, summed up by the parallel map benchmark.
+ */
+struct MappedValue { long operator()(const ft::pair<const int, long> & element) const { return element.second; } };
+
+/**
+ * Tells whether the mapped value of the given element is odd.
+ */
+struct OddValue { bool operator()(const ft::pair<const int, long> & element) const { return element.second % 2 != 0; } };
+
+/**
+ * Sums up the mapped values of a map of two million elements by its iterators and by the
+ * parallel reductions over its subtrees, with pools of one thread up to one per processor.
+ */
+static void benchParallelMap() {
+    ft::map<int, long> m;
+    for (long i = 0; i < 2000000; ++i) {
+        m[static_cast<int>(random())] = i;
+    }
+    double start = now();
+    long   sum   = 0;
+    for (ft::map<int, long>::const_iterator it = m.begin(); it != m.end(); ++it) {
+        sum += it->second;
+    }
+    report("iterators", now() - start, m.size());
+    sink = sum;
+
+    const std::size_t hardware = ft::thread_pool::hardware_threads();
+    for (std::size_t threads = 1;; threads = threads * 2 < hardware ? threads * 2 : hardware) {
+        ft::thread_pool    pool(threads);
+        std::ostringstream name;
+        name << " (" << threads << (threads == 1 ? " thread)" : " threads)");
+
+        start = now();
+        sink  = ft::parallel::transform_reduce(pool, m, 0L, ft::plus<long>(), MappedValue());
+        report("transform_reduce" + name.str(), now() - start, m.size());
+
+        start = now();
+        sink  = static_cast<long>(ft::parallel::count_if(pool, m, OddValue()));
+        report("count_if" + name.str(), now() - start, m.size());
+        if (threads == hardware) break;
+    }
+}
+
+/**
+ * Loads four million unsorted keys into a set: one by one, sorted by ft::sort and assigned
+ * bottom up, and by parallel::bulk_load.
+ */
+static void benchBulkLoad() {
+    std::vector<int> keys;
+    for (int i = 0; i < 4000000; ++i) {
+        keys.push_back(static_cast<int>(random()));
+    }
+    double start = now();
+    {
+        ft::set<int> s(keys.begin(), keys.end());
+        report("insert", now() - start, keys.size());
+        sink = static_cast<long>(s.size());
+    }
+
+    start = now();
+    {
+        std::vector<int> sorted(keys);
+        ft::sort(sorted.begin(), sorted.end());
+        ft::set<int> s;
+        s.assign_sorted(sorted.begin(), ft::unique(sorted.begin(), sorted.end()));
+        report("sort + assign_sorted", now() - start, keys.size());
+        sink = static_cast<long>(s.size());
+    }
+
+    const std::size_t hardware = ft::thread_pool::hardware_threads();
+    for (std::size_t threads = 1;; threads = threads * 2 < hardware ? threads * 2 : hardware) {
+        ft::thread_pool    pool(threads);
+        std::ostringstream name;
+        name << " (" << threads << (threads == 1 ? " thread)" : " threads)");
+
+        ft::set<int> s;
+        start = now();
+        ft::parallel::bulk_load(pool, s, keys.begin(), keys.end());
+        report("bulk_load" + name.str(), now() - start, keys.size());
+        sink = static_cast<long>(s.size());
+        if (threads == hardware) break;
+    }
+}
+
+/**
+ * Restores a map of four million elements from a text dump, inserting them one by one, and
+ * from a snapshot, then a vector of the same size from a snapshot, copied and mapped.
+ */
+static void benchSnapshot() {
+    const char * const text     = "bench_snapshot.txt";
+    const char * const snapshot = "bench_snapshot.bin";
+
+    ft::map<int, long> m;
+    for (long i = 0; static_cast<long>(m.size()) < 4000000; ++i) {
+        m[static_cast<int>(random())] = i;
+    }
+    double start = now();
+    {
+        std::ofstream out(text);
+        for (ft::map<int, long>::const_iterator it = m.begin(); it != m.end(); ++it) {
+            out << it->first << ' ' << it->second << '\n';
+        }
+    }
+    report("text dump", now() - start, m.size());
+
+    start = now();
+    {
+        ft::map<int, long> loaded;
+        std::ifstream      in(text);
+        int                key;
+        long               value;
+        while (in >> key >> value) {
+            loaded[key] = value;
+        }
+        report("text restore", now() - start, m.size());
+        sink = static_cast<long>(loaded.size());
+    }
+
+    start = now();
+    ft::save(snapshot, m);
+    report("save map", now() - start, m.size());
+
+    start = now();
+    {
+        ft::map<int, long> loaded;
+        ft::load(snapshot, loaded);
+        report("load map", now() - start, m.size());
+        sink = static_cast<long>(loaded.size());
+    }
+
+    ft::vector<long> v;
+    for (long i = 0; i < 4000000; ++i) {
+        v.push_back(random());
+    }
+    start = now();
+    ft::save(snapshot, v);
+    report("save vector", now() - start, v.size());
+
+    start = now();
+    {
+        ft::vector<long> loaded;
+        ft::load(snapshot, loaded);
+        report("load vector", now() - start, v.size());
+        sink = loaded.back();
+    }
+
+    start = now();
+    {
+        ft::vector_view<long> view(snapshot, false);
+        sink = view[view.size() / 2];
+        report("vector_view", now() - start, v.size());
+    }
+    std::remove(text);
+    std::remove(snapshot);
+}
+
+/**
+ * Measures a map placed in a memory region with offset pointers against the default map,
+ * then searches a copy of the region mapped read-only at another address.
+ */
+static void benchRegion() {
+    typedef ft::pair<const int, int>                                                                  valueType;
+    typedef ft::tree_options<0, ft::no_tree_stats, true, ft::offset_pointers>                          offsetOptions;
+    typedef ft::map<int, int, ft::less<int>, ft::region_allocator<valueType>, offsetOptions>           regionMap;
+
+    const std::size_t count = 1000000;
+    const std::size_t size  = 64 << 20;
+    int * keys = new int[count];
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = static_cast<int>(random());
+    }
+    ft::map<int, int> plain;
+    double start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        plain[keys[i]] = static_cast<int>(i);
+    }
+    report("insert, ft::map<int, int>", now() - start, count);
+
+    void * memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    void * copy   = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ft::memory_region * region = ft::memory_region::create(memory, size);
+    ft::region_allocator<regionMap> allocator(*region);
+    regionMap * m = new (allocator.allocate(1)) regionMap(ft::less<int>(), ft::region_allocator<valueType>(*region));
+    region->set_root(m);
+    start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        (*m)[keys[i]] = static_cast<int>(i);
+    }
+    report("insert, offset pointers", now() - start, count);
+
+    long sum = 0;
+    start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += plain.find(keys[i])->second;
+    }
+    report("find, ft::map<int, int>", now() - start, count);
+
+    start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += m->find(keys[i])->second;
+    }
+    report("find, offset pointers", now() - start, count);
+
+    std::memcpy(copy, memory, size - region->bytes_free());
+    mprotect(copy, size, PROT_READ);
+    const regionMap & attached = *ft::memory_region::attach(static_cast<const void *>(copy))->get_root<regionMap>();
+    start = now();
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += attached.find(keys[i])->second;
+    }
+    report("find, attached read-only", now() - start, count);
+    sink = sum;
+
+    m->~regionMap();
+    munmap(copy, size);
+    munmap(memory, size);
+    delete[] keys;
+}
+
+/**
+ * A named benchmark.
+ */
+struct Benchmark {
+    const char * name;
+    void (*run)();
+};
+
+static const Benchmark benchmarks[] = {
+    { "frozen_map",     benchFrozenMap      },
+    { "small_map",      benchSmallMaps      },
+    { "small_vector",   benchSmallVectors   },
+    { "big_vector",     benchBigVectors     },
+    { "resize",         benchResize         },
+    { "shrink",         benchShrink         },
+    { "stack",          benchStacks         },
+    { "priority_queue", benchPriorityQueues },
+    { "concurrent",     benchConcurrent     },
+    { "arena",          benchArena          },
+    { "memory",         benchMemory         },
+    { "tree_stats",     benchTreeStats      },
+    { "node_layout",    benchNodeLayout     },
+    { "assign",         benchAssign         },
+    { "vector_assign",  benchVectorAssign   },
+    { "compare",        benchCompare        },
+    { "sort",           benchSort           },
+    { "parallel",       benchParallel       },
+    { "parallel_map",   benchParallelMap    },
+    { "bulk_load",      benchBulkLoad       },
+    { "snapshot",       benchSnapshot       },
+    { "region",         benchRegion         },
+};
+
+int main(int argc, char ** argv) {
+    srandom(42);
+    for (std::size_t i = 0; i < sizeof(benchmarks) / sizeof(*benchmarks); ++i) {
+        bool selected = argc < 2;
+        for (int j = 1; j < argc && !selected; ++j) {
+            selected = std::strcmp(argv[j], benchmarks[i].name) == 0;
+        }
+        if (selected) {
+            std::cout << "\033[1m" << benchmarks[i].name << "\033[0m" << std::endl;
+            benchmarks[i].run();
+            std::cout << std::endl;
+        }
+    }
+}
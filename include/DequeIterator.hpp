@@ -0,0 +1,165 @@
+#ifndef FT_CONTAINERS_DEQUEITERATOR_HPP
+#define FT_CONTAINERS_DEQUEITERATOR_HPP
+
+#include <cstddef>
+#include "iterator.hpp"
+
+namespace ft {
+    /**
+     * @brief A random access iterator over the chunks of a deque.
+     *
+     * The iterator remembers the chunk it is in and its slot inside of that chunk,
+     * crossing over to the neighbouring chunk through the chunk map of the deque.
+     *
+     * @tparam T The type of the elements.
+     * @tparam Pointer The pointer type of this iterator.
+     * @tparam Reference The reference type of this iterator.
+     * @tparam ChunkSize The count of elements in one chunk.
+     */
+    template<class T, class Pointer, class Reference, std::size_t ChunkSize>
+    class DequeIterator: public  ft::iterator <ft::random_access_iterator_tag, T, std::ptrdiff_t, Pointer, Reference>,
+                         public std::iterator<std::random_access_iterator_tag, T, std::ptrdiff_t, Pointer, Reference> {
+        template<class, class, class, std::size_t> friend class DequeIterator;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef Pointer                         pointer;
+        typedef Reference                       reference;
+        /**
+         * The type of a cell in the chunk map.
+         */
+        typedef T * const *                     nodeType;
+
+        DequeIterator(): current(), first(), node() {}
+
+        /**
+         * Constructs an iterator pointing to the given slot of the given chunk.
+         *
+         * @param current The slot.
+         * @param node The cell of the chunk map holding the chunk.
+         */
+        DequeIterator(pointer current, nodeType node): current(current), first(*node), node(node) {}
+
+        template<class P, class R>
+        DequeIterator(const DequeIterator<T, P, R, ChunkSize> & other)
+            : current(other.current), first(other.first), node(other.node) {}
+
+        reference operator*()  const { return *current;  }
+        pointer   operator->() const { return current;   }
+
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        DequeIterator & operator++() {
+            if (++current == first + ChunkSize) {
+                setNode(node + 1);
+                current = first;
+            }
+            return *this;
+        }
+
+        DequeIterator & operator--() {
+            if (current == first) {
+                setNode(node - 1);
+                current = first + ChunkSize;
+            }
+            --current;
+            return *this;
+        }
+
+        DequeIterator operator++(int) {
+            DequeIterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        DequeIterator operator--(int) {
+            DequeIterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        DequeIterator & operator+=(difference_type n) {
+            const difference_type chunk  = static_cast<difference_type>(ChunkSize);
+            const difference_type offset = (current - first) + n;
+            if (offset >= 0 && offset < chunk) {
+                current += n;
+            } else {
+                const difference_type nodes = offset > 0 ? offset / chunk : -((-offset - 1) / chunk) - 1;
+                setNode(node + nodes);
+                current = first + (offset - nodes * chunk);
+            }
+            return *this;
+        }
+
+        DequeIterator & operator-=(difference_type n) { return *this += -n; }
+
+        DequeIterator operator+(difference_type n) const {
+            DequeIterator tmp = *this;
+            return tmp += n;
+        }
+
+        DequeIterator operator-(difference_type n) const {
+            DequeIterator tmp = *this;
+            return tmp -= n;
+        }
+
+        template<class P, class R>
+        difference_type operator-(const DequeIterator<T, P, R, ChunkSize> & other) const {
+            return static_cast<difference_type>(ChunkSize) * (node - other.node)
+                   + (current - first) - (other.current - other.first);
+        }
+
+        template<class P, class R>
+        bool operator==(const DequeIterator<T, P, R, ChunkSize> & other) const { return current == other.current && node == other.node; }
+
+        template<class P, class R>
+        bool operator!=(const DequeIterator<T, P, R, ChunkSize> & other) const { return !(*this == other); }
+
+        template<class P, class R>
+        bool operator<(const DequeIterator<T, P, R, ChunkSize> & other) const {
+            return node == other.node ? current < other.current : node < other.node;
+        }
+
+        template<class P, class R>
+        bool operator>(const DequeIterator<T, P, R, ChunkSize> & other) const { return other < *this; }
+
+        template<class P, class R>
+        bool operator<=(const DequeIterator<T, P, R, ChunkSize> & other) const { return !(other < *this); }
+
+        template<class P, class R>
+        bool operator>=(const DequeIterator<T, P, R, ChunkSize> & other) const { return !(*this < other); }
+
+    private:
+        /**
+         * The slot this iterator points to.
+         */
+        pointer  current;
+        /**
+         * The first slot of the current chunk.
+         */
+        pointer  first;
+        /**
+         * The cell of the chunk map holding the current chunk.
+         */
+        nodeType node;
+
+        /**
+         * Moves this iterator to the chunk held by the given cell.
+         *
+         * @param newNode The new cell.
+         */
+        void setNode(nodeType newNode) {
+            node  = newNode;
+            first = *newNode;
+        }
+    };
+
+    template<class T, class Pointer, class Reference, std::size_t ChunkSize>
+    DequeIterator<T, Pointer, Reference, ChunkSize> operator+(std::ptrdiff_t n, const DequeIterator<T, Pointer, Reference, ChunkSize> & it) {
+        return it + n;
+    }
+}
+
+#endif //FT_CONTAINERS_DEQUEITERATOR_HPP
@@ -0,0 +1,109 @@
+#ifndef FT_CONTAINERS_INDEXITERATOR_HPP
+#define FT_CONTAINERS_INDEXITERATOR_HPP
+
+#include <cstddef>
+#include "iterator.hpp"
+
+namespace ft {
+    /**
+     * @brief A random access iterator accessing the elements of a container by their index.
+     *
+     * Used for containers whose elements are not stored in one contiguous block.
+     *
+     * @tparam Container The type of the container, const for the const iterator.
+     * @tparam T The type of the elements.
+     * @tparam Pointer The pointer type of this iterator.
+     * @tparam Reference The reference type of this iterator.
+     */
+    template<class Container, class T, class Pointer, class Reference>
+    class IndexIterator: public  ft::iterator <ft::random_access_iterator_tag, T, std::ptrdiff_t, Pointer, Reference>,
+                         public std::iterator<std::random_access_iterator_tag, T, std::ptrdiff_t, Pointer, Reference> {
+        template<class, class, class, class> friend class IndexIterator;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef Pointer                         pointer;
+        typedef Reference                       reference;
+
+        IndexIterator(): container(NULL), index() {}
+
+        /**
+         * Constructs an iterator pointing to the given index of the given container.
+         *
+         * @param container The container.
+         * @param index The index of the element.
+         */
+        IndexIterator(Container * container, std::size_t index): container(container), index(index) {}
+
+        template<class C, class P, class R>
+        IndexIterator(const IndexIterator<C, T, P, R> & other): container(other.container), index(other.index) {}
+
+        reference operator*()  const { return (*container)[index];  }
+        pointer   operator->() const { return &(*container)[index]; }
+
+        reference operator[](difference_type n) const { return (*container)[index + n]; }
+
+        IndexIterator & operator++() { ++index; return *this; }
+        IndexIterator & operator--() { --index; return *this; }
+
+        IndexIterator operator++(int) {
+            IndexIterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+
+        IndexIterator operator--(int) {
+            IndexIterator tmp = *this;
+            --index;
+            return tmp;
+        }
+
+        IndexIterator & operator+=(difference_type n) { index += n; return *this; }
+        IndexIterator & operator-=(difference_type n) { index -= n; return *this; }
+
+        IndexIterator operator+(difference_type n) const { return IndexIterator(container, index + n); }
+        IndexIterator operator-(difference_type n) const { return IndexIterator(container, index - n); }
+
+        template<class C, class P, class R>
+        difference_type operator-(const IndexIterator<C, T, P, R> & other) const {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        template<class C, class P, class R>
+        bool operator==(const IndexIterator<C, T, P, R> & other) const { return index == other.index; }
+
+        template<class C, class P, class R>
+        bool operator!=(const IndexIterator<C, T, P, R> & other) const { return index != other.index; }
+
+        template<class C, class P, class R>
+        bool operator<(const IndexIterator<C, T, P, R> & other) const { return index < other.index; }
+
+        template<class C, class P, class R>
+        bool operator>(const IndexIterator<C, T, P, R> & other) const { return index > other.index; }
+
+        template<class C, class P, class R>
+        bool operator<=(const IndexIterator<C, T, P, R> & other) const { return index <= other.index; }
+
+        template<class C, class P, class R>
+        bool operator>=(const IndexIterator<C, T, P, R> & other) const { return index >= other.index; }
+
+    private:
+        /**
+         * The container iterated over.
+         */
+        Container * container;
+        /**
+         * The index of the element this iterator points to.
+         */
+        std::size_t index;
+    };
+
+    template<class Container, class T, class Pointer, class Reference>
+    IndexIterator<Container, T, Pointer, Reference> operator+(std::ptrdiff_t n, const IndexIterator<Container, T, Pointer, Reference> & it) {
+        return it + n;
+    }
+}
+
+#endif //FT_CONTAINERS_INDEXITERATOR_HPP
@@ -139,7 +139,7 @@ namespace ft {
                 nodeType tmp;
                 do {
                     tmp = baseNode;
-                    baseNode = baseNode->root;
+                    baseNode = baseNode->parent();
                 } while ((baseNode->right == NULL || baseNode->right == tmp) && baseNode->left != tmp);
             }
             return *this;
@@ -160,7 +160,7 @@ namespace ft {
                 nodeType tmp;
                 do {
                     tmp = baseNode;
-                    baseNode = baseNode->root;
+                    baseNode = baseNode->parent();
                 } while ((baseNode->left == NULL || baseNode->left == tmp) && baseNode->right != tmp);
             }
             return *this;
@@ -336,7 +336,7 @@ namespace ft {
                 nodeType tmp;
                 do {
                     tmp = baseNode;
-                    baseNode = baseNode->root;
+                    baseNode = baseNode->parent();
                 } while ((baseNode->right == NULL || baseNode->right == tmp) && baseNode->left != tmp);
             }
             return *this;
@@ -357,7 +357,7 @@ namespace ft {
                 nodeType tmp;
                 do {
                     tmp = baseNode;
-                    baseNode = baseNode->root;
+                    baseNode = baseNode->parent();
                 } while ((baseNode->left == NULL || baseNode->left == tmp) && baseNode->right != tmp);
             }
             return *this;
@@ -5,9 +5,119 @@
 #ifndef FT_CONTAINERS_ALGORITHM_HPP
 #define FT_CONTAINERS_ALGORITHM_HPP
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+
 namespace ft {
+    /**
+     * @brief Tells whether an iterator points into contiguous memory.
+     *
+     * Specialized for pointers and the iterators of the vector, which provide the address of
+     * the element they point to.
+     *
+     * @tparam It The type of the iterator.
+     */
+    template<class It>
+    struct ContiguousIterator {
+        enum { value = false };
+    };
+
+    template<class T>
+    struct ContiguousIterator<T *> {
+        enum { value = true };
+        typedef T valueType;
+
+        static const T * address(T * it) { return it; }
+    };
+
+    template<class T>
+    struct ContiguousIterator<const T *> {
+        enum { value = true };
+        typedef T valueType;
+
+        static const T * address(const T * it) { return it; }
+    };
+
+    template<class Iter>
+    struct ContiguousIterator<__wrap_iter<Iter> >: public ContiguousIterator<Iter> {
+        static const typename ContiguousIterator<Iter>::valueType * address(__wrap_iter<Iter> it) {
+            return ContiguousIterator<Iter>::address(it.base());
+        }
+    };
+
+    /**
+     * Whether two objects of type T are equal exactly if their bytes are, true for the integral
+     * types and pointers. Floating point types are not, because of the signed zeros and NaN.
+     *
+     * @tparam T The type to be checked.
+     */
+    template<class T>
+    struct is_bitwise_comparable: public integral_constant<bool, is_integral<T>::value> {};
+
+    template<class T>
+    struct is_bitwise_comparable<T *>: public true_type {};
+
+    /**
+     * Whether objects of type T are ordered like their bytes compared as unsigned characters,
+     * which is the case for the single byte types without a sign.
+     *
+     * @tparam T The type to be checked.
+     */
+    template<class T>
+    struct is_bytewise_ordered: public false_type {};
+
+    template<>
+    struct is_bytewise_ordered<bool>: public true_type {};
+
+    template<>
+    struct is_bytewise_ordered<unsigned char>: public true_type {};
+
+    template<>
+    struct is_bytewise_ordered<char>: public integral_constant<bool, CHAR_MIN == 0> {};
+
+    /**
+     * Whether the two ranges can be compared by their memory: both iterators point into contiguous
+     * memory of the same bitwise comparable type.
+     *
+     * @tparam It1 The type of the first iterator.
+     * @tparam It2 The type of the second iterator.
+     */
+    template<class It1, class It2, bool = ContiguousIterator<It1>::value && ContiguousIterator<It2>::value>
+    struct MemoryComparable: public false_type {};
+
+    template<class It1, class It2>
+    struct MemoryComparable<It1, It2, true>
+        : public integral_constant<bool, is_same<typename ContiguousIterator<It1>::valueType,
+                                                 typename ContiguousIterator<It2>::valueType>::value
+                                      && is_bitwise_comparable<typename ContiguousIterator<It1>::valueType>::value> {};
+
+    /**
+     * Returns the index of the first element differing in the given arrays. Blocks of elements
+     * are skipped using memcmp as long as they are equal.
+     *
+     * @param first1 The first array.
+     * @param first2 The second array.
+     * @param count The count of elements of both arrays.
+     * @return The index of the first differing element or the count if all are equal.
+     */
+    template<class T>
+    std::size_t mismatchMemory(const T * first1, const T * first2, std::size_t count) {
+        const std::size_t block = sizeof(T) < 4096 ? 4096 / sizeof(T) : 1;
+        std::size_t       i     = 0;
+        for (; i + block <= count && std::memcmp(first1 + i, first2 + i, block * sizeof(T)) == 0; i += block);
+        for (; i < count && first1[i] == first2[i]; ++i);
+        return i;
+    }
+
     template<class InputIt1, class InputIt2>
-    bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+    bool equalDispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, false_type) {
         for (; first1 != last1; ++first1, ++first2) {
             if (!(*first1 == *first2)) {
                 return false;
@@ -16,6 +126,28 @@ namespace ft {
         return true;
     }
 
+    template<class InputIt1, class InputIt2>
+    bool equalDispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, true_type) {
+        const std::size_t count = static_cast<std::size_t>(last1 - first1);
+        return count == 0 || std::memcmp(ContiguousIterator<InputIt1>::address(first1),
+                                         ContiguousIterator<InputIt2>::address(first2),
+                                         count * sizeof(*ContiguousIterator<InputIt1>::address(first1))) == 0;
+    }
+
+    /**
+     * Returns whether the given ranges are equal. Contiguous ranges of bitwise comparable
+     * elements are compared using memcmp.
+     *
+     * @param first1 The beginning of the first range.
+     * @param last1 The end of the first range.
+     * @param first2 The beginning of the second range, at least as long as the first one.
+     * @return Whether all elements of the ranges are equal.
+     */
+    template<class InputIt1, class InputIt2>
+    bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+        return equalDispatch(first1, last1, first2, integral_constant<bool, MemoryComparable<InputIt1, InputIt2>::value>());
+    }
+
     template<class InputIt1, class InputIt2, class BinaryPredicate>
     bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p) {
         for (; first1 != last1; ++first1, ++first2) {
@@ -27,16 +159,70 @@ namespace ft {
     }
 
     template<class InputIt1, class InputIt2>
-    bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
-                                 InputIt2 first2, InputIt2 last2) {
+    int compare3wayDispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, false_type) {
         for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
             if (*first1 < *first2) {
-                return true;
+                return -1;
             } else if (*first2 < *first1) {
-                return false;
+                return 1;
             }
         }
-        return first1 == last1 && first2 != last2;
+        return first1 != last1 ? 1 : first2 != last2 ? -1 : 0;
+    }
+
+    template<class InputIt1, class InputIt2>
+    int compare3wayDispatch(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, true_type) {
+        typedef typename ContiguousIterator<InputIt1>::valueType valueType;
+
+        const std::size_t count1 = static_cast<std::size_t>(last1 - first1),
+                          count2 = static_cast<std::size_t>(last2 - first2),
+                          count  = count1 < count2 ? count1 : count2;
+        const valueType * array1 = ContiguousIterator<InputIt1>::address(first1);
+        const valueType * array2 = ContiguousIterator<InputIt2>::address(first2);
+        if (is_bytewise_ordered<valueType>::value) {
+            const int result = count == 0 ? 0 : std::memcmp(array1, array2, count * sizeof(valueType));
+            if (result != 0) {
+                return result < 0 ? -1 : 1;
+            }
+        } else {
+            const std::size_t i = mismatchMemory(array1, array2, count);
+            if (i < count) {
+                return array1[i] < array2[i] ? -1 : 1;
+            }
+        }
+        return count1 < count2 ? -1 : count1 > count2 ? 1 : 0;
+    }
+
+    /**
+     * Compares the given ranges lexicographically in a single pass, using only the operator <
+     * of the elements. Contiguous ranges of bitwise comparable elements are compared using memcmp.
+     *
+     * @param first1 The beginning of the first range.
+     * @param last1 The end of the first range.
+     * @param first2 The beginning of the second range.
+     * @param last2 The end of the second range.
+     * @return A negative value if the first range is less than the second one, a positive value if
+     * it is greater and zero if they are equivalent.
+     */
+    template<class InputIt1, class InputIt2>
+    int lexicographical_compare_3way(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+        return compare3wayDispatch(first1, last1, first2, last2,
+                                   integral_constant<bool, MemoryComparable<InputIt1, InputIt2>::value>());
+    }
+
+    /**
+     * Returns whether the first range is lexicographically less than the second one.
+     *
+     * @param first1 The beginning of the first range.
+     * @param last1 The end of the first range.
+     * @param first2 The beginning of the second range.
+     * @param last2 The end of the second range.
+     * @return Whether the first range is less than the second one.
+     */
+    template<class InputIt1, class InputIt2>
+    bool lexicographical_compare(InputIt1 first1, InputIt1 last1,
+                                 InputIt2 first2, InputIt2 last2) {
+        return ft::lexicographical_compare_3way(first1, last1, first2, last2) < 0;
     }
 
     template<class InputIt1, class InputIt2, class Compare>
@@ -52,6 +238,600 @@ namespace ft {
         }
         return first1 == last1 && first2 != last2;
     }
+
+    template<class ForwardIt1, class ForwardIt2>
+    void iter_swap(ForwardIt1 a, ForwardIt2 b) {
+        using std::swap;
+        swap(*a, *b);
+    }
+
+    /**
+     * Rotates the given range so that middle becomes its first element.
+     *
+     * @param first The beginning of the range.
+     * @param middle The element that should become the first one.
+     * @param last The end of the range.
+     * @return The new position of the element previously pointed to by first.
+     */
+    template<class ForwardIt>
+    ForwardIt rotate(ForwardIt first, ForwardIt middle, ForwardIt last) {
+        if (first == middle) return last;
+        if (middle == last)  return first;
+
+        ForwardIt next = middle;
+        do {
+            ft::iter_swap(first++, next++);
+            if (first == middle) middle = next;
+        } while (next != last);
+
+        ForwardIt ret = first;
+        for (next = middle; next != last;) {
+            ft::iter_swap(first++, next++);
+            if (first == middle) {
+                middle = next;
+            } else if (next == last) {
+                next = middle;
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * Returns the first element of the given sorted range that is not less than the given value.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param value The value to be searched.
+     * @param comp The compare object the range is sorted with.
+     * @return The first element not less than the value or last if there is none.
+     */
+    template<class ForwardIt, class T, class Compare>
+    ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T & value, Compare comp) {
+        typename ft::iterator_traits<ForwardIt>::difference_type count = ft::distance(first, last);
+        while (count > 0) {
+            const typename ft::iterator_traits<ForwardIt>::difference_type half = count / 2;
+            ForwardIt middle = first;
+            ft::advance(middle, half);
+            if (comp(*middle, value)) {
+                first = ++middle;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    template<class ForwardIt, class T>
+    ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T & value) {
+        return ft::lower_bound(first, last, value, ft::less<T>());
+    }
+
+    /**
+     * Returns the first element of the given sorted range that is greater than the given value.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param value The value to be searched.
+     * @param comp The compare object the range is sorted with.
+     * @return The first element greater than the value or last if there is none.
+     */
+    template<class ForwardIt, class T, class Compare>
+    ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T & value, Compare comp) {
+        typename ft::iterator_traits<ForwardIt>::difference_type count = ft::distance(first, last);
+        while (count > 0) {
+            const typename ft::iterator_traits<ForwardIt>::difference_type half = count / 2;
+            ForwardIt middle = first;
+            ft::advance(middle, half);
+            if (!comp(value, *middle)) {
+                first = ++middle;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    template<class ForwardIt, class T>
+    ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T & value) {
+        return ft::upper_bound(first, last, value, ft::less<T>());
+    }
+
+    template<class ForwardIt, class T, class Compare>
+    bool binary_search(ForwardIt first, ForwardIt last, const T & value, Compare comp) {
+        first = ft::lower_bound(first, last, value, comp);
+        return first != last && !comp(value, *first);
+    }
+
+    template<class ForwardIt, class T>
+    bool binary_search(ForwardIt first, ForwardIt last, const T & value) {
+        return ft::binary_search(first, last, value, ft::less<T>());
+    }
+
+    /**
+     * Removes all but the first element of every group of consecutive equal elements.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param p The predicate telling whether two elements are equal.
+     * @return The new end of the range.
+     */
+    template<class ForwardIt, class BinaryPredicate>
+    ForwardIt unique(ForwardIt first, ForwardIt last, BinaryPredicate p) {
+        if (first == last) return last;
+
+        ForwardIt result = first;
+        while (++first != last) {
+            if (!p(*result, *first) && ++result != first) {
+                *result = *first;
+            }
+        }
+        return ++result;
+    }
+
+    template<class ForwardIt>
+    ForwardIt unique(ForwardIt first, ForwardIt last) {
+        if (first == last) return last;
+
+        ForwardIt result = first;
+        while (++first != last) {
+            if (!(*result == *first) && ++result != first) {
+                *result = *first;
+            }
+        }
+        return ++result;
+    }
+
+    /**
+     * The length below which ranges are sorted by insertion.
+     */
+    const std::ptrdiff_t insertionSortThreshold = 16;
+
+    /**
+     * Sorts the given range by insertion, keeping equal elements in their order.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     */
+    template<class RandomIt, class Compare>
+    void insertionSort(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type valueType;
+
+        if (first == last) return;
+        for (RandomIt i = first + 1; i != last; ++i) {
+            valueType value = *i;
+            RandomIt  hole  = i;
+            if (comp(value, *first)) {
+                std::copy_backward(first, i, i + 1);
+                hole = first;
+            } else {
+                for (RandomIt previous = hole - 1; comp(value, *previous); --previous) {
+                    *hole = *previous;
+                    hole  = previous;
+                }
+            }
+            *hole = value;
+        }
+    }
+
+    /**
+     * Moves the element at the given hole of the given heap down along the greatest children
+     * to a leaf, then sifts the given value up from there.
+     *
+     * @param first The beginning of the heap.
+     * @param hole The index of the element to be replaced.
+     * @param length The length of the heap.
+     * @param value The value replacing the element at the hole.
+     * @param comp The compare object, the greatest element according to it is on top.
+     */
+    template<class RandomIt, class Distance, class T, class Compare>
+    void adjustHeap(RandomIt first, Distance hole, Distance length, T value, Compare comp) {
+        const Distance top = hole;
+        for (Distance child = 2 * hole + 1; child < length; child = 2 * hole + 1) {
+            if (child + 1 < length && comp(first[child], first[child + 1])) ++child;
+            first[hole] = first[child];
+            hole        = child;
+        }
+        while (hole > top) {
+            const Distance parent = (hole - 1) / 2;
+            if (!comp(first[parent], value)) break;
+            first[hole] = first[parent];
+            hole        = parent;
+        }
+        first[hole] = value;
+    }
+
+    template<class RandomIt, class Compare>
+    void makeHeap(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::difference_type distance;
+
+        const distance length = last - first;
+        if (length < 2) return;
+        for (distance parent = (length - 2) / 2 + 1; parent > 0; --parent) {
+            ft::adjustHeap(first, parent - 1, length, first[parent - 1], comp);
+        }
+    }
+
+    /**
+     * Makes a heap out of the first part of the given range containing its smallest elements,
+     * the greatest of them on top.
+     *
+     * @param first The beginning of the range.
+     * @param middle The end of the heap.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     */
+    template<class RandomIt, class Compare>
+    void heapSelect(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type      valueType;
+        typedef typename ft::iterator_traits<RandomIt>::difference_type distance;
+
+        ft::makeHeap(first, middle, comp);
+        const distance length = middle - first;
+        for (RandomIt i = middle; i < last; ++i) {
+            if (comp(*i, *first)) {
+                valueType value = *i;
+                *i = *first;
+                ft::adjustHeap(first, distance(0), length, value, comp);
+            }
+        }
+    }
+
+    template<class RandomIt, class Compare>
+    void sortHeap(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type      valueType;
+        typedef typename ft::iterator_traits<RandomIt>::difference_type distance;
+
+        for (distance length = last - first; length > 1;) {
+            --length;
+            valueType value = first[length];
+            first[length] = *first;
+            ft::adjustHeap(first, distance(0), length, value, comp);
+        }
+    }
+
+    /**
+     * Moves the median of the elements a, b and c to the given position.
+     */
+    template<class RandomIt, class Compare>
+    void moveMedianTo(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+        if (comp(*a, *b)) {
+            if      (comp(*b, *c)) ft::iter_swap(result, b);
+            else if (comp(*a, *c)) ft::iter_swap(result, c);
+            else                   ft::iter_swap(result, a);
+        } else if (comp(*a, *c))   ft::iter_swap(result, a);
+        else if   (comp(*b, *c))   ft::iter_swap(result, c);
+        else                       ft::iter_swap(result, b);
+    }
+
+    /**
+     * Partitions the given range around the median of its first, middle and last element.
+     * As the pivot is a median, both scans stop at the latest at one of the other two
+     * candidates, so that they need no bounds checks.
+     *
+     * @param first The beginning of the range, at least three elements long.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     * @return The beginning of the upper partition, no element before it is greater than the
+     * pivot, no element from it on is less.
+     */
+    template<class RandomIt, class Compare>
+    RandomIt partitionPivot(RandomIt first, RandomIt last, Compare comp) {
+        ft::moveMedianTo(first, first + 1, first + (last - first) / 2, last - 1, comp);
+        RandomIt pivot = first;
+        ++first;
+        for (;;) {
+            while (comp(*first, *pivot)) ++first;
+            --last;
+            while (comp(*pivot, *last)) --last;
+            if (!(first < last)) return first;
+            ft::iter_swap(first, last);
+            ++first;
+        }
+    }
+
+    /**
+     * Returns the depth of recursion after which the introsort and the introselect fall back
+     * to the heap, twice the binary logarithm of the given length.
+     */
+    template<class Distance>
+    Distance introDepth(Distance length) {
+        Distance depth = 0;
+        for (; length > 1; length /= 2) depth += 2;
+        return depth;
+    }
+
+    /**
+     * Partitions the given range until every part is shorter than the insertion sort threshold,
+     * sorting parts by the heap once the recursion gets too deep.
+     */
+    template<class RandomIt, class Distance, class Compare>
+    void introsortLoop(RandomIt first, RandomIt last, Distance depth, Compare comp) {
+        while (last - first > insertionSortThreshold) {
+            if (depth == 0) {
+                ft::heapSelect(first, last, last, comp);
+                ft::sortHeap(first, last, comp);
+                return;
+            }
+            --depth;
+            RandomIt cut = ft::partitionPivot(first, last, comp);
+            ft::introsortLoop(cut, last, depth, comp);
+            last = cut;
+        }
+    }
+
+    /**
+     * Sorts the given range using the introsort: quicksort with median of three pivots, falling
+     * back to the heapsort if the recursion gets too deep, the remaining short parts being
+     * sorted by insertion in one final pass.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     */
+    template<class RandomIt, class Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp) {
+        if (last - first < 2) return;
+        ft::introsortLoop(first, last, ft::introDepth(last - first), comp);
+        ft::insertionSort(first, last, comp);
+    }
+
+    /**
+     * Whether ranges of the given iterator type are sorted by their radix: contiguous ranges
+     * of integers.
+     *
+     * @tparam It The type of the iterator.
+     */
+    template<class It, bool = ContiguousIterator<It>::value>
+    struct RadixSortable: public false_type {};
+
+    template<class It>
+    struct RadixSortable<It, true>: public integral_constant<bool, is_integral<typename ContiguousIterator<It>::valueType>::value> {};
+
+    /**
+     * The length below which integers are sorted by the introsort instead of their radix.
+     */
+    const std::ptrdiff_t radixSortThreshold = 256;
+
+    /**
+     * Returns the key of the given integer, ordered like the integers when compared unsigned:
+     * the sign bit of signed types is flipped.
+     */
+    template<class T>
+    unsigned long radixKey(T value) {
+        unsigned long key = static_cast<unsigned long>(value);
+        if (std::numeric_limits<T>::is_signed) {
+            key ^= 1UL << (sizeof(T) * CHAR_BIT - 1);
+        }
+        return key;
+    }
+
+    /**
+     * Sorts the given array of integers using a least significant digit radix sort, one byte
+     * per pass. The counts of all passes are gathered in one single read, passes whose byte is
+     * the same for all elements are skipped.
+     *
+     * @param first The beginning of the array.
+     * @param last The end of the array.
+     */
+    template<class T>
+    void radixSort(T * first, T * last) {
+        const std::size_t    length = static_cast<std::size_t>(last - first);
+        std::size_t          counts[sizeof(T)][256];
+        std::allocator<T>    alloc;
+
+        std::memset(counts, 0, sizeof(counts));
+        for (T * it = first; it != last; ++it) {
+            const unsigned long key = ft::radixKey(*it);
+            for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+                ++counts[byte][(key >> (byte * CHAR_BIT)) & 0xff];
+            }
+        }
+        T * buffer = alloc.allocate(length);
+        T * source = first, * target = buffer;
+        for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+            const unsigned int shift = static_cast<unsigned int>(byte * CHAR_BIT);
+            if (counts[byte][(ft::radixKey(*first) >> shift) & 0xff] == length) continue;
+
+            std::size_t offset = 0;
+            for (std::size_t digit = 0; digit < 256; ++digit) {
+                const std::size_t count = counts[byte][digit];
+                counts[byte][digit] = offset;
+                offset += count;
+            }
+            for (T * it = source; it != source + length; ++it) {
+                target[counts[byte][(ft::radixKey(*it) >> shift) & 0xff]++] = *it;
+            }
+            std::swap(source, target);
+        }
+        if (source != first) {
+            std::memcpy(first, source, length * sizeof(T));
+        }
+        alloc.deallocate(buffer, length);
+    }
+
+    template<class RandomIt>
+    void sortDispatch(RandomIt first, RandomIt last, false_type) {
+        ft::sort(first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+
+    template<class RandomIt>
+    void sortDispatch(RandomIt first, RandomIt last, true_type) {
+        typedef typename ContiguousIterator<RandomIt>::valueType valueType;
+
+        if (last - first < radixSortThreshold) {
+            ft::sort(first, last, ft::less<valueType>());
+        } else {
+            valueType * array = const_cast<valueType *>(ContiguousIterator<RandomIt>::address(first));
+            ft::radixSort(array, array + (last - first));
+        }
+    }
+
+    /**
+     * Sorts the given range in ascending order. Contiguous ranges of integers are sorted by
+     * their radix, all others using the introsort.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     */
+    template<class RandomIt>
+    void sort(RandomIt first, RandomIt last) {
+        ft::sortDispatch(first, last, integral_constant<bool, RadixSortable<RandomIt>::value>());
+    }
+
+    /**
+     * Sorts the given range so that its first part contains its smallest elements in order,
+     * the order of the remaining elements is unspecified.
+     *
+     * @param first The beginning of the range.
+     * @param middle The end of the part to be sorted.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     */
+    template<class RandomIt, class Compare>
+    void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+        ft::heapSelect(first, middle, last, comp);
+        ft::sortHeap(first, middle, comp);
+    }
+
+    template<class RandomIt>
+    void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+        ft::partial_sort(first, middle, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * Rearranges the given range so that the nth element is the one that would be there if the
+     * range was sorted, no element before it is greater and no element after it is less. Uses
+     * the introselect, falling back to the heap if the partitioning does not converge.
+     *
+     * @param first The beginning of the range.
+     * @param nth The position of the element to be selected.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     */
+    template<class RandomIt, class Compare>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+        if (first == last || nth == last) return;
+
+        for (typename ft::iterator_traits<RandomIt>::difference_type depth = ft::introDepth(last - first); last - first > 3; --depth) {
+            if (depth == 0) {
+                ft::heapSelect(first, nth + 1, last, comp);
+                ft::iter_swap(first, nth);
+                return;
+            }
+            RandomIt cut = ft::partitionPivot(first, last, comp);
+            if (cut <= nth) {
+                first = cut;
+            } else {
+                last = cut;
+            }
+        }
+        ft::insertionSort(first, last, comp);
+    }
+
+    template<class RandomIt>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+        ft::nth_element(first, nth, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
+
+    /**
+     * Merges the two sorted ranges into the given output, taking the element of the first
+     * range if two are equivalent.
+     *
+     * @return The end of the output.
+     */
+    template<class InputIt1, class InputIt2, class OutputIt, class Compare>
+    OutputIt mergeInto(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt out, Compare comp) {
+        for (; first1 != last1 && first2 != last2; ++out) {
+            if (comp(*first2, *first1)) {
+                *out = *first2;
+                ++first2;
+            } else {
+                *out = *first1;
+                ++first1;
+            }
+        }
+        return std::copy(first2, last2, std::copy(first1, last1, out));
+    }
+
+    /**
+     * Merges every two neighbouring runs of the given width of the source into the target.
+     */
+    template<class InputIt, class OutputIt, class Distance, class Compare>
+    void mergePass(InputIt source, OutputIt target, Distance length, Distance width, Compare comp) {
+        for (Distance i = 0; i < length; i += 2 * width) {
+            const Distance middle = i + width     < length ? i + width     : length;
+            const Distance end    = i + 2 * width < length ? i + 2 * width : length;
+            ft::mergeInto(source + i, source + middle, source + middle, source + end, target + i, comp);
+        }
+    }
+
+    /**
+     * Destroys the elements of the given buffer and deallocates it.
+     */
+    template<class Allocator, class Distance>
+    void releaseBuffer(Allocator & alloc, typename Allocator::pointer buffer, Distance length) {
+        for (Distance i = 0; i < length; ++i) {
+            alloc.destroy(buffer + i);
+        }
+        alloc.deallocate(buffer, static_cast<std::size_t>(length));
+    }
+
+    /**
+     * Sorts the given range keeping equivalent elements in their order. Runs of the insertion
+     * sort threshold are sorted by insertion, then merged bottom up, back and forth between the
+     * range and a buffer of the same length. If the compare object or an element throws, the
+     * buffer is released and the range holds its elements in an unspecified order, possibly
+     * with some of them copied over others.
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param comp The compare object.
+     */
+    template<class RandomIt, class Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename ft::iterator_traits<RandomIt>::value_type      valueType;
+        typedef typename ft::iterator_traits<RandomIt>::difference_type distance;
+
+        const distance length = last - first;
+        for (distance i = 0; i < length; i += insertionSortThreshold) {
+            ft::insertionSort(first + i, length - i < insertionSortThreshold ? last : first + i + insertionSortThreshold, comp);
+        }
+        if (length <= insertionSortThreshold) return;
+
+        std::allocator<valueType> alloc;
+        valueType * buffer = alloc.allocate(static_cast<std::size_t>(length));
+        try {
+            std::uninitialized_copy(first, last, buffer);
+        } catch (...) {
+            alloc.deallocate(buffer, static_cast<std::size_t>(length));
+            throw;
+        }
+        try {
+            bool inBuffer = false;
+            for (distance width = insertionSortThreshold; width < length; width *= 2, inBuffer = !inBuffer) {
+                if (inBuffer) {
+                    ft::mergePass(buffer, first, length, width, comp);
+                } else {
+                    ft::mergePass(first, buffer, length, width, comp);
+                }
+            }
+            if (inBuffer) {
+                std::copy(buffer, buffer + length, first);
+            }
+        } catch (...) {
+            ft::releaseBuffer(alloc, buffer, length);
+            throw;
+        }
+        ft::releaseBuffer(alloc, buffer, length);
+    }
+
+    template<class RandomIt>
+    void stable_sort(RandomIt first, RandomIt last) {
+        ft::stable_sort(first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+    }
 }
 
 #endif //FT_CONTAINERS_ALGORITHM_HPP
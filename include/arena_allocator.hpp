@@ -0,0 +1,263 @@
+#ifndef FT_CONTAINERS_ARENA_ALLOCATOR_HPP
+#define FT_CONTAINERS_ARENA_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include "memory.hpp"
+
+namespace ft {
+    /**
+     * @brief A monotonic memory arena.
+     *
+     * Memory is handed out by bumping a pointer through blocks obtained from the free store,
+     * each block twice as big as the previous one, up to a limit. Single allocations are not
+     * released, except for the most recent one, all blocks are released at once by release()
+     * or by the destructor. Objects living in the arena have to be destroyed beforehand.
+     */
+    class arena {
+    public:
+        /**
+         * Constructs an empty arena.
+         *
+         * @param initialBlockSize The size in bytes of the first block.
+         * @param maximumBlockSize The size in bytes blocks stop growing at.
+         */
+        explicit arena(std::size_t initialBlockSize = 4096, std::size_t maximumBlockSize = (1 << 24))
+            : current(NULL), next(NULL), end(NULL), last(NULL),
+              blockSize(initialBlockSize), maximumBlockSize(maximumBlockSize), used(0) {}
+
+       ~arena() { release(); }
+
+        /**
+         * Returns aligned memory of the given size.
+         *
+         * @param bytes The size of the memory.
+         * @param alignment The alignment of the memory, a power of two.
+         * @return The memory.
+         */
+        void * allocate(std::size_t bytes, std::size_t alignment) {
+            char * memory = align(next, alignment);
+            if (current == NULL || memory > end || bytes > static_cast<std::size_t>(end - memory)) {
+                addBlock(bytes + alignment);
+                memory = align(next, alignment);
+            }
+            last  = memory;
+            next  = memory + bytes;
+            used += bytes;
+            return memory;
+        }
+
+        /**
+         * Gives the given memory back if it has been the most recent allocation, does nothing
+         * otherwise.
+         *
+         * @param memory The memory.
+         * @param bytes The size of the memory.
+         */
+        void deallocate(void * memory, std::size_t bytes) {
+            if (memory != NULL && memory == last) {
+                next  = last;
+                last  = NULL;
+                used -= bytes;
+            }
+        }
+
+        /**
+         * Resizes the given memory in place, which is possible if it is the most recent
+         * allocation and the current block is big enough.
+         *
+         * @param memory The memory.
+         * @param oldBytes The current size of the memory.
+         * @param newBytes The requested size of the memory.
+         * @return Whether the memory has been resized.
+         */
+        bool extend(void * memory, std::size_t oldBytes, std::size_t newBytes) {
+            if (memory == NULL || memory != last || newBytes > static_cast<std::size_t>(end - last)) {
+                return false;
+            }
+            next  = last + newBytes;
+            used += newBytes - oldBytes;
+            return true;
+        }
+
+        /**
+         * Releases all blocks at once.
+         */
+        void release() {
+            while (current != NULL) {
+                Block * previous = current->previous;
+                ::operator delete(current);
+                current = previous;
+            }
+            next = end = last = NULL;
+            used = 0;
+        }
+
+        /**
+         * Returns the count of bytes handed out and not given back.
+         *
+         * @return The used bytes.
+         */
+        std::size_t bytes_used() const { return used; }
+
+    private:
+        /**
+         * The header of a block, followed by the memory of the block.
+         */
+        struct Block {
+            Block *     previous;
+            std::size_t size;
+        };
+
+        Block *     current;
+        char *      next;
+        char *      end;
+        /**
+         * The most recent allocation.
+         */
+        char *      last;
+        std::size_t blockSize;
+        std::size_t maximumBlockSize;
+        std::size_t used;
+
+        static char * align(char * pointer, std::size_t alignment) {
+            const std::size_t address = reinterpret_cast<std::size_t>(pointer);
+            return pointer + ((alignment - address % alignment) % alignment);
+        }
+
+        /**
+         * Adds a block big enough for the given count of bytes, the rest of the current block
+         * is no longer used.
+         *
+         * @param minimum The minimum size of the block.
+         */
+        void addBlock(std::size_t minimum) {
+            const std::size_t size = blockSize < minimum ? minimum : blockSize;
+            Block * block = static_cast<Block *>(::operator new(sizeof(Block) + size));
+            block->previous = current;
+            block->size     = size;
+            current = block;
+            next    = reinterpret_cast<char *>(block + 1);
+            end     = next + size;
+            last    = NULL;
+            if (blockSize < maximumBlockSize) {
+                blockSize *= 2;
+            }
+        }
+
+        arena(const arena &);
+        arena & operator=(const arena &);
+    };
+
+    /**
+     * @brief An allocator taking its memory from an arena.
+     *
+     * Deallocating is free, as the memory is only given back to the arena as a whole. The
+     * containers therefore skip destroying their elements one by one where this is only
+     * done to release them, if the elements are trivially destructible. Allocators
+     * compare equal if they use the same arena.
+     *
+     * @tparam T The type of the allocated objects.
+     */
+    template<class T>
+    class arena_allocator {
+        template<class> friend class arena_allocator;
+
+    public:
+        typedef T              value_type;
+        typedef T *            pointer;
+        typedef const T *      const_pointer;
+        typedef T &            reference;
+        typedef const T &      const_reference;
+        typedef std::size_t    size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template<class U>
+        struct rebind {
+            typedef arena_allocator<U> other;
+        };
+
+        /**
+         * Constructs an allocator using the given arena, which has to outlive all containers
+         * using this allocator.
+         *
+         * @param memory The arena.
+         */
+        arena_allocator(arena & memory): memory(&memory) {}
+        arena_allocator(const arena_allocator & other): memory(other.memory) {}
+        template<class U>
+        arena_allocator(const arena_allocator<U> & other): memory(other.memory) {}
+       ~arena_allocator() {}
+
+        arena_allocator & operator=(const arena_allocator & other) {
+            memory = other.memory;
+            return *this;
+        }
+
+        pointer       address(reference x)       const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, const T & value) { new (static_cast<void *>(p)) T(value); }
+        void destroy(pointer p)                    { p->~T();                               }
+
+        pointer allocate(size_type n, const void * = 0) {
+            if (n > max_size()) throw std::bad_alloc();
+            return static_cast<pointer>(memory->allocate(n * sizeof(T), __alignof__(T)));
+        }
+
+        void deallocate(pointer p, size_type n) {
+            memory->deallocate(p, n * sizeof(T));
+        }
+
+        /**
+         * Resizes the given block, in place if it is the most recent allocation of the arena.
+         * Otherwise, the bytes of the objects are copied into a new block.
+         *
+         * @param p The block to be resized.
+         * @param oldCount The count of objects the block was allocated for.
+         * @param newCount The count of objects the block should hold.
+         * @return The address of the resized block.
+         */
+        pointer reallocate(pointer p, size_type oldCount, size_type newCount) {
+            if (newCount > max_size()) throw std::bad_alloc();
+            if (memory->extend(p, oldCount * sizeof(T), newCount * sizeof(T))) {
+                return p;
+            }
+            pointer block = allocate(newCount);
+            std::memcpy(static_cast<void *>(block), static_cast<const void *>(p), (oldCount < newCount ? oldCount : newCount) * sizeof(T));
+            return block;
+        }
+
+        /**
+         * Returns the arena this allocator takes its memory from.
+         *
+         * @return The arena.
+         */
+        arena & get_arena() const { return *memory; }
+
+    private:
+        arena * memory;
+    };
+
+    template<class T>
+    struct allocator_can_reallocate<arena_allocator<T> >: public true_type {};
+
+    template<class T>
+    struct allocator_has_trivial_deallocate<arena_allocator<T> >: public true_type {};
+
+    template<class T, class U>
+    bool operator==(const arena_allocator<T> & lhs, const arena_allocator<U> & rhs) {
+        return &lhs.get_arena() == &rhs.get_arena();
+    }
+
+    template<class T, class U>
+    bool operator!=(const arena_allocator<T> & lhs, const arena_allocator<U> & rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_ARENA_ALLOCATOR_HPP
@@ -0,0 +1,480 @@
+#ifndef FT_CONTAINERS_CONCURRENT_HPP
+#define FT_CONTAINERS_CONCURRENT_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace ft {
+    /**
+     * The assumed size of a cache line in bytes.
+     */
+    enum { cache_line_size = 64 };
+
+    /**
+     * @brief Uninitialized storage for one object of type T.
+     *
+     * @tparam T The type of the object to be stored.
+     */
+    template<class T>
+    union ConcurrentStorage {
+        char        bytes[sizeof(T)];
+        void *      pointerAlign;
+        long        longAlign;
+        long double floatAlign;
+
+        T * value() { return reinterpret_cast<T *>(bytes); }
+    };
+
+    /**
+     * @brief A position shared between threads, together with the last value of the opposite
+     * position seen by the owning thread, on a cache line of its own.
+     */
+    struct ConcurrentPosition {
+        std::size_t position;
+        std::size_t cached;
+        char        padding[cache_line_size - 2 * sizeof(std::size_t)];
+
+        ConcurrentPosition(): position(0), cached(0) {}
+    };
+
+    /**
+     * Returns the smallest power of two not less than the given count, at least two.
+     *
+     * @param count The requested count.
+     * @return The rounded count.
+     */
+    inline std::size_t concurrentCapacity(std::size_t count) {
+        std::size_t capacity = 2;
+        while (capacity < count) {
+            if (capacity > static_cast<std::size_t>(-1) / 2) throw std::length_error("ft::concurrentCapacity: Capacity too big!");
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    /**
+     * @brief A bounded lock-free stack, safe to be used by any number of threads.
+     *
+     * The elements are stored in a fixed array of nodes which are linked by their indices.
+     * The heads of the stack and of the list of free nodes carry a tag in their upper half,
+     * incremented by every change, so that a head popped and pushed again in between does
+     * not let a compare-and-swap succeed (ABA problem). The nodes are only released by the
+     * destructor, hence a thread may always read a node that another thread just popped.
+     *
+     * As the top element may be popped by another thread at any time, pop returns it.
+     *
+     * @tparam T The type of the elements, has to be copy constructible and assignable.
+     * @tparam Allocator The allocator used for the nodes.
+     */
+    template<class T, class Allocator = std::allocator<T> >
+    class treiber_stack {
+    public:
+        typedef T           value_type;
+        typedef std::size_t size_type;
+
+        /**
+         * Constructs an empty stack able to hold the given count of elements.
+         *
+         * @param capacity The maximum count of elements.
+         * @param alloc The allocator used for the nodes.
+         */
+        explicit treiber_stack(size_type capacity, const Allocator & alloc = Allocator())
+            : nodeAlloc(alloc), nodes(NULL), capacity(capacity) {
+            if (capacity >= indexMask) throw std::length_error("ft::treiber_stack: Capacity too big!");
+            nodes = nodeAlloc.allocate(capacity + 1);
+            for (size_type i = 1; i <= capacity; ++i) {
+                nodes[i].next = i < capacity ? i + 1 : 0;
+            }
+            freeList.position = capacity > 0 ? 1 : 0;
+        }
+
+       ~treiber_stack() {
+            for (size_type index = head.position & indexMask; index != 0; index = nodes[index].next) {
+                nodes[index].storage.value()->~T();
+            }
+            nodeAlloc.deallocate(nodes, capacity + 1);
+        }
+
+        /**
+         * Pushes a copy of the given value.
+         *
+         * @param value The value to be pushed.
+         * @return Whether the value has been pushed, false if the stack is full.
+         */
+        bool push(const T & value) {
+            const size_type index = popIndex(freeList.position);
+            if (index == 0) return false;
+            try {
+                new (nodes[index].storage.bytes) T(value);
+            } catch (...) {
+                pushIndex(freeList.position, index);
+                throw;
+            }
+            // Counted before being published, so that a pop never takes the count below zero.
+            __atomic_add_fetch(&count.position, 1, __ATOMIC_RELAXED);
+            pushIndex(head.position, index);
+            return true;
+        }
+
+        /**
+         * Pops the top element.
+         *
+         * @param value The object the popped element is assigned to.
+         * @return Whether an element has been popped, false if the stack is empty.
+         */
+        bool pop(T & value) {
+            const size_type index = popIndex(head.position);
+            if (index == 0) return false;
+            // Uncounted before the node can be reused, so that the count never exceeds the capacity.
+            __atomic_sub_fetch(&count.position, 1, __ATOMIC_RELAXED);
+            T * element = nodes[index].storage.value();
+            try {
+                value = *element;
+            } catch (...) {
+                __atomic_add_fetch(&count.position, 1, __ATOMIC_RELAXED);
+                pushIndex(head.position, index);
+                throw;
+            }
+            element->~T();
+            pushIndex(freeList.position, index);
+            return true;
+        }
+
+        bool empty() const {
+            return (__atomic_load_n(&head.position, __ATOMIC_ACQUIRE) & indexMask) == 0;
+        }
+
+        /**
+         * Returns the count of elements, which may already have changed once it is returned.
+         * Elements still being pushed may be counted already.
+         *
+         * @return The count of elements.
+         */
+        size_type size() const {
+            return __atomic_load_n(&count.position, __ATOMIC_RELAXED);
+        }
+
+    private:
+        /**
+         * A node of the stack. The next index is read by threads racing to pop the node,
+         * it is therefore only accessed atomically.
+         */
+        struct Node {
+            size_type            next;
+            ConcurrentStorage<T> storage;
+        };
+
+        typedef typename Allocator::template rebind<Node>::other nodeAllocatorType;
+
+        /**
+         * The count of bits used for the index in a head, the other ones hold the tag.
+         */
+        static const size_type indexBits = sizeof(size_type) * 4;
+        /**
+         * The mask extracting the index from a head.
+         */
+        static const size_type indexMask = (static_cast<size_type>(1) << indexBits) - 1;
+
+        nodeAllocatorType  nodeAlloc;
+        /**
+         * The nodes, indexed starting at one, as zero marks the end of a list.
+         */
+        Node *             nodes;
+        size_type          capacity;
+        char               padding[cache_line_size];
+        /**
+         * The tagged index of the top node.
+         */
+        ConcurrentPosition head;
+        /**
+         * The tagged index of the first free node.
+         */
+        ConcurrentPosition freeList;
+        ConcurrentPosition count;
+
+        /**
+         * Returns the given index combined with the incremented tag of the given head.
+         *
+         * @param old The previous head.
+         * @param index The new index.
+         * @return The new head.
+         */
+        static size_type retag(size_type old, size_type index) {
+            return (((old >> indexBits) + 1) << indexBits) | index;
+        }
+
+        /**
+         * Removes the first node of the given list.
+         *
+         * @param top The head of the list.
+         * @return The index of the removed node, zero if the list is empty.
+         */
+        size_type popIndex(size_type & top) {
+            size_type old = __atomic_load_n(&top, __ATOMIC_ACQUIRE);
+            for (;;) {
+                const size_type index = old & indexMask;
+                if (index == 0) return 0;
+                const size_type next = __atomic_load_n(&nodes[index].next, __ATOMIC_RELAXED);
+                if (__atomic_compare_exchange_n(&top, &old, retag(old, next), true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                    return index;
+                }
+            }
+        }
+
+        /**
+         * Prepends the given node to the given list.
+         *
+         * @param top The head of the list.
+         * @param index The index of the node.
+         */
+        void pushIndex(size_type & top, size_type index) {
+            size_type old = __atomic_load_n(&top, __ATOMIC_RELAXED);
+            do {
+                __atomic_store_n(&nodes[index].next, old & indexMask, __ATOMIC_RELAXED);
+            } while (!__atomic_compare_exchange_n(&top, &old, retag(old, index), true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+        }
+
+        treiber_stack(const treiber_stack &);
+        treiber_stack & operator=(const treiber_stack &);
+    };
+
+    /**
+     * @brief A bounded lock-free FIFO queue for exactly one producing and one consuming thread.
+     *
+     * The elements are stored in a ring buffer. Each side keeps its position on its own cache
+     * line together with the last seen position of the other side, which is only reloaded when
+     * the queue looks full or empty.
+     *
+     * @tparam T The type of the elements, has to be copy constructible and assignable.
+     * @tparam Allocator The allocator used for the ring buffer.
+     */
+    template<class T, class Allocator = std::allocator<T> >
+    class spsc_queue {
+    public:
+        typedef T           value_type;
+        typedef std::size_t size_type;
+
+        /**
+         * Constructs an empty queue able to hold at least the given count of elements.
+         *
+         * @param capacity The minimum capacity, rounded up to a power of two.
+         * @param alloc The allocator used for the ring buffer.
+         */
+        explicit spsc_queue(size_type capacity, const Allocator & alloc = Allocator())
+            : alloc(alloc), slots(NULL), mask(concurrentCapacity(capacity) - 1) {
+            slots = this->alloc.allocate(mask + 1);
+        }
+
+       ~spsc_queue() {
+            for (size_type i = consumer.position; i != producer.position; ++i) {
+                alloc.destroy(slots + (i & mask));
+            }
+            alloc.deallocate(slots, mask + 1);
+        }
+
+        /**
+         * Appends a copy of the given value. Must only be called by the producing thread.
+         *
+         * @param value The value to be appended.
+         * @return Whether the value has been appended, false if the queue is full.
+         */
+        bool push(const T & value) {
+            const size_type tail = producer.position;
+            if (tail - producer.cached > mask) {
+                producer.cached = __atomic_load_n(&consumer.position, __ATOMIC_ACQUIRE);
+                if (tail - producer.cached > mask) return false;
+            }
+            alloc.construct(slots + (tail & mask), value);
+            __atomic_store_n(&producer.position, tail + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        /**
+         * Removes the first element. Must only be called by the consuming thread.
+         *
+         * @param value The object the removed element is assigned to.
+         * @return Whether an element has been removed, false if the queue is empty.
+         */
+        bool pop(T & value) {
+            const size_type head = consumer.position;
+            if (head == consumer.cached) {
+                consumer.cached = __atomic_load_n(&producer.position, __ATOMIC_ACQUIRE);
+                if (head == consumer.cached) return false;
+            }
+            value = slots[head & mask];
+            alloc.destroy(slots + (head & mask));
+            __atomic_store_n(&consumer.position, head + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Returns the count of elements, which may already have changed once it is returned.
+         *
+         * @return The count of elements.
+         */
+        size_type size() const {
+            const size_type head = __atomic_load_n(&consumer.position, __ATOMIC_ACQUIRE);
+            return __atomic_load_n(&producer.position, __ATOMIC_ACQUIRE) - head;
+        }
+
+    private:
+        typedef typename Allocator::pointer pointer;
+
+        Allocator          alloc;
+        pointer            slots;
+        size_type          mask;
+        char               padding[cache_line_size];
+        ConcurrentPosition producer;
+        ConcurrentPosition consumer;
+
+        spsc_queue(const spsc_queue &);
+        spsc_queue & operator=(const spsc_queue &);
+    };
+
+    /**
+     * @brief A bounded lock-free FIFO queue, safe to be used by any number of threads.
+     *
+     * Every slot of the ring buffer carries a sequence number telling whether it is ready to be
+     * written or to be read in the current round, so that the threads only contend on the
+     * positions they claim slots with. (Dmitry Vyukov's bounded MPMC queue.)
+     *
+     * A claimed slot cannot be given back, the copy constructor of T must therefore not throw.
+     * If an assignment in pop throws, the removed element is lost.
+     *
+     * @tparam T The type of the elements, has to be copy constructible and assignable.
+     * @tparam Allocator The allocator used for the ring buffer.
+     */
+    template<class T, class Allocator = std::allocator<T> >
+    class mpmc_queue {
+    public:
+        typedef T           value_type;
+        typedef std::size_t size_type;
+
+        /**
+         * Constructs an empty queue able to hold at least the given count of elements.
+         *
+         * @param capacity The minimum capacity, rounded up to a power of two.
+         * @param alloc The allocator used for the ring buffer.
+         */
+        explicit mpmc_queue(size_type capacity, const Allocator & alloc = Allocator())
+            : cellAlloc(alloc), cells(NULL), mask(concurrentCapacity(capacity) - 1) {
+            cells = cellAlloc.allocate(mask + 1);
+            for (size_type i = 0; i <= mask; ++i) {
+                cells[i].sequence = i;
+            }
+        }
+
+       ~mpmc_queue() {
+            for (size_type i = dequeuePosition.position; i != enqueuePosition.position; ++i) {
+                cells[i & mask].storage.value()->~T();
+            }
+            cellAlloc.deallocate(cells, mask + 1);
+        }
+
+        /**
+         * Appends a copy of the given value.
+         *
+         * @param value The value to be appended.
+         * @return Whether the value has been appended, false if the queue is full.
+         */
+        bool push(const T & value) {
+            Cell *    cell;
+            size_type position = __atomic_load_n(&enqueuePosition.position, __ATOMIC_RELAXED);
+            for (;;) {
+                cell = cells + (position & mask);
+                const size_type sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                if (sequence == position) {
+                    if (__atomic_compare_exchange_n(&enqueuePosition.position, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                        break;
+                    }
+                } else if (static_cast<std::ptrdiff_t>(sequence - position) < 0) {
+                    return false;
+                } else {
+                    position = __atomic_load_n(&enqueuePosition.position, __ATOMIC_RELAXED);
+                }
+            }
+            new (cell->storage.bytes) T(value);
+            __atomic_store_n(&cell->sequence, position + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        /**
+         * Removes the first element.
+         *
+         * @param value The object the removed element is assigned to.
+         * @return Whether an element has been removed, false if the queue is empty.
+         */
+        bool pop(T & value) {
+            Cell *    cell;
+            size_type position = __atomic_load_n(&dequeuePosition.position, __ATOMIC_RELAXED);
+            for (;;) {
+                cell = cells + (position & mask);
+                const size_type sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                if (sequence == position + 1) {
+                    if (__atomic_compare_exchange_n(&dequeuePosition.position, &position, position + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                        break;
+                    }
+                } else if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0) {
+                    return false;
+                } else {
+                    position = __atomic_load_n(&dequeuePosition.position, __ATOMIC_RELAXED);
+                }
+            }
+            T * element = cell->storage.value();
+            try {
+                value = *element;
+            } catch (...) {
+                element->~T();
+                __atomic_store_n(&cell->sequence, position + mask + 1, __ATOMIC_RELEASE);
+                throw;
+            }
+            element->~T();
+            __atomic_store_n(&cell->sequence, position + mask + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /**
+         * Returns the count of elements, which may already have changed once it is returned.
+         *
+         * @return The count of elements.
+         */
+        size_type size() const {
+            const size_type head = __atomic_load_n(&dequeuePosition.position, __ATOMIC_ACQUIRE);
+            const size_type tail = __atomic_load_n(&enqueuePosition.position, __ATOMIC_ACQUIRE);
+            return tail > head ? tail - head : 0;
+        }
+
+    private:
+        /**
+         * A slot of the ring buffer.
+         */
+        struct Cell {
+            size_type            sequence;
+            ConcurrentStorage<T> storage;
+        };
+
+        typedef typename Allocator::template rebind<Cell>::other cellAllocatorType;
+
+        cellAllocatorType  cellAlloc;
+        Cell *             cells;
+        size_type          mask;
+        char               padding[cache_line_size];
+        ConcurrentPosition enqueuePosition;
+        ConcurrentPosition dequeuePosition;
+
+        mpmc_queue(const mpmc_queue &);
+        mpmc_queue & operator=(const mpmc_queue &);
+    };
+}
+
+#endif //FT_CONTAINERS_CONCURRENT_HPP
@@ -0,0 +1,176 @@
+#ifndef FT_CONTAINERS_COUNTING_ALLOCATOR_HPP
+#define FT_CONTAINERS_COUNTING_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include "memory.hpp"
+
+namespace ft {
+    /**
+     * @brief The statistics collected by counting allocators.
+     *
+     * Besides the counters, a histogram of the requested sizes is kept, bucket k counting the
+     * requests of 2^k up to 2^(k + 1) - 1 bytes. The statistics are not synchronized.
+     */
+    struct allocation_stats {
+        /**
+         * The count of buckets of the size histogram.
+         */
+        enum { buckets = sizeof(std::size_t) * 8 };
+
+        std::size_t allocations;
+        std::size_t deallocations;
+        std::size_t live_bytes;
+        std::size_t peak_bytes;
+        std::size_t histogram[buckets];
+
+        allocation_stats() { reset(); }
+
+        void reset() {
+            allocations = deallocations = live_bytes = peak_bytes = 0;
+            for (std::size_t i = 0; i < buckets; ++i) {
+                histogram[i] = 0;
+            }
+        }
+
+        void record_allocation(std::size_t bytes) {
+            ++allocations;
+            ++histogram[bucket(bytes)];
+            live_bytes += bytes;
+            if (live_bytes > peak_bytes) {
+                peak_bytes = live_bytes;
+            }
+        }
+
+        void record_deallocation(std::size_t bytes) {
+            ++deallocations;
+            live_bytes -= bytes;
+        }
+
+        /**
+         * Returns the bucket of the histogram counting requests of the given size.
+         *
+         * @param bytes The size of a request.
+         * @return The index of the bucket.
+         */
+        static std::size_t bucket(std::size_t bytes) {
+            return bytes == 0 ? 0 : buckets - 1 - __builtin_clzl(bytes);
+        }
+    };
+
+    /**
+     * Returns the statistics shared by all counting allocators of the given tag that have not
+     * been given statistics of their own.
+     *
+     * @tparam Tag Any type naming the statistics.
+     * @return The statistics of the tag.
+     */
+    template<class Tag>
+    allocation_stats & tag_allocation_stats() {
+        static allocation_stats stats;
+        return stats;
+    }
+
+    /**
+     * @brief An allocator recording the allocations done through it.
+     *
+     * The allocations are forwarded to the underlying allocator and recorded in either the
+     * statistics given on construction, which allows counting per container instance, or in
+     * the statistics of the tag. Rebound copies record into the same statistics.
+     *
+     * @tparam T The type of the allocated objects.
+     * @tparam Tag The tag whose statistics are used by default.
+     * @tparam Allocator The underlying allocator.
+     */
+    template<class T, class Tag = void, class Allocator = std::allocator<T> >
+    class counting_allocator: public Allocator {
+        template<class, class, class> friend class counting_allocator;
+
+    public:
+        typedef typename Allocator::pointer   pointer;
+        typedef typename Allocator::size_type size_type;
+
+        template<class U>
+        struct rebind {
+            typedef counting_allocator<U, Tag, typename Allocator::template rebind<U>::other> other;
+        };
+
+        counting_allocator(): Allocator(), stats(&tag_allocation_stats<Tag>()) {}
+
+        /**
+         * Constructs an allocator recording into the given statistics.
+         *
+         * @param stats The statistics, which have to outlive this allocator.
+         * @param alloc The underlying allocator.
+         */
+        explicit counting_allocator(allocation_stats & stats, const Allocator & alloc = Allocator())
+            : Allocator(alloc), stats(&stats) {}
+
+        counting_allocator(const counting_allocator & other): Allocator(other), stats(other.stats) {}
+
+        template<class U, class OtherAllocator>
+        counting_allocator(const counting_allocator<U, Tag, OtherAllocator> & other)
+            : Allocator(static_cast<const OtherAllocator &>(other)), stats(other.stats) {}
+
+        counting_allocator & operator=(const counting_allocator & other) {
+            Allocator::operator=(other);
+            stats = other.stats;
+            return *this;
+        }
+
+        pointer allocate(size_type n, const void * hint = 0) {
+            pointer p = Allocator::allocate(n, hint);
+            stats->record_allocation(n * sizeof(T));
+            return p;
+        }
+
+        void deallocate(pointer p, size_type n) {
+            stats->record_deallocation(n * sizeof(T));
+            Allocator::deallocate(p, n);
+        }
+
+        /**
+         * Forwards the resizing of a block to the underlying allocator, only usable if it
+         * supports it.
+         *
+         * @param p The block to be resized.
+         * @param oldCount The count of objects the block was allocated for.
+         * @param newCount The count of objects the block should hold.
+         * @return The address of the resized block.
+         */
+        pointer reallocate(pointer p, size_type oldCount, size_type newCount) {
+            pointer block = Allocator::reallocate(p, oldCount, newCount);
+            stats->record_deallocation(oldCount * sizeof(T));
+            stats->record_allocation(newCount * sizeof(T));
+            return block;
+        }
+
+        /**
+         * Returns the statistics this allocator records into.
+         *
+         * @return The statistics.
+         */
+        allocation_stats & get_stats() const { return *stats; }
+
+    private:
+        allocation_stats * stats;
+    };
+
+    template<class T, class Tag, class Allocator>
+    struct allocator_can_reallocate<counting_allocator<T, Tag, Allocator> >: public allocator_can_reallocate<Allocator> {};
+
+    template<class T, class Tag, class Allocator>
+    struct allocator_has_trivial_deallocate<counting_allocator<T, Tag, Allocator> >: public allocator_has_trivial_deallocate<Allocator> {};
+
+    template<class T, class U, class Tag, class Allocator1, class Allocator2>
+    bool operator==(const counting_allocator<T, Tag, Allocator1> & lhs, const counting_allocator<U, Tag, Allocator2> & rhs) {
+        return &lhs.get_stats() == &rhs.get_stats() && static_cast<const Allocator1 &>(lhs) == static_cast<const Allocator2 &>(rhs);
+    }
+
+    template<class T, class U, class Tag, class Allocator1, class Allocator2>
+    bool operator!=(const counting_allocator<T, Tag, Allocator1> & lhs, const counting_allocator<U, Tag, Allocator2> & rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_COUNTING_ALLOCATOR_HPP
@@ -0,0 +1,556 @@
+#ifndef FT_CONTAINERS_DEQUE_HPP
+#define FT_CONTAINERS_DEQUE_HPP
+
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include "DequeIterator.hpp"
+
+namespace ft {
+    /**
+     * @brief A double-ended queue storing its elements in chunks of fixed size.
+     *
+     * The chunks are referenced by a map of chunk pointers. Elements are never moved when
+     * pushing or popping at either end, only the map is reallocated from time to time,
+     * which copies one pointer per chunk. A push or a pop therefore never copies elements.
+     *
+     * @tparam T The type of the contained objects.
+     * @tparam Allocator The allocator to use, by default the std::allocator.
+     */
+    template <class T, class Allocator = std::allocator<T> >
+    class deque {
+    public:
+        /**
+         * The count of elements stored in one chunk, about four kilobytes worth of them.
+         */
+        enum { chunkSize = sizeof(T) < 256 ? 4096 / sizeof(T) : 16 };
+
+        typedef T                                                               value_type;
+        typedef Allocator                                                       allocator_type;
+        typedef std::size_t                                                     size_type;
+        typedef std::ptrdiff_t                                                  difference_type;
+        typedef value_type &                                                    reference;
+        typedef const value_type &                                              const_reference;
+        typedef typename Allocator::pointer                                     pointer;
+        typedef typename Allocator::const_pointer                               const_pointer;
+        typedef DequeIterator<T, pointer, reference, chunkSize>                 iterator;
+        typedef DequeIterator<T, const_pointer, const_reference, chunkSize>     const_iterator;
+        typedef ft::reverse_iterator<iterator>                                  reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator>                            const_reverse_iterator;
+
+        /**
+         * Constructs an empty deque.
+         *
+         * @param alloc The allocator to be used.
+         */
+        explicit deque(const Allocator & alloc = Allocator())
+            : alloc(alloc), mapAlloc(alloc), map(NULL), mapSize(0), head(0), count(0), spare(NULL) {}
+
+        /**
+         * Constructs a deque holding count copies of the given value.
+         *
+         * @param count The number of objects.
+         * @param value The value for all of the objects.
+         * @param alloc The allocator to be used.
+         */
+        explicit deque(size_type count, const T & value = T(), const Allocator & alloc = Allocator())
+            : alloc(alloc), mapAlloc(alloc), map(NULL), mapSize(0), head(0), count(0), spare(NULL) {
+            try {
+                insert(end(), count, value);
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        /**
+         * Constructs a deque holding a copy of the given range.
+         *
+         * @tparam InputIt The type of the input iterators.
+         * @param first The beginning of the range.
+         * @param last The end of the range to copy.
+         * @param alloc The allocator to be used.
+         */
+        template<class InputIt>
+        deque(InputIt first, typename ft::enable_if<!is_integral<InputIt>::value, InputIt>::type last, const Allocator & alloc = Allocator())
+            : alloc(alloc), mapAlloc(alloc), map(NULL), mapSize(0), head(0), count(0), spare(NULL) {
+            try {
+                insert(end(), first, last);
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+        deque(const deque & other)
+            : alloc(other.alloc), mapAlloc(other.mapAlloc), map(NULL), mapSize(0), head(0), count(0), spare(NULL) {
+            try {
+                insert(end(), other.begin(), other.end());
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+
+       ~deque() {
+            release();
+        }
+
+        deque & operator=(const deque & other) {
+            if (&other != this) {
+                deque tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        void assign(size_type count, const T & value) {
+            clear();
+            insert(end(), count, value);
+        }
+
+        template<class InputIt>
+        void assign(InputIt first, typename ft::enable_if<!is_integral<InputIt>::value, InputIt>::type last) {
+            clear();
+            insert(end(), first, last);
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        reference at(size_type pos) {
+            if (pos >= size()) throw std::out_of_range("ft::deque<T, Allocator>::at: Out of range!");
+            return (*this)[pos];
+        }
+
+        const_reference at(size_type pos) const {
+            if (pos >= size()) throw std::out_of_range("ft::deque<T, Allocator>::at: Out of range!");
+            return (*this)[pos];
+        }
+
+        reference       operator[](size_type pos)       { return *slot(head + pos); }
+        const_reference operator[](size_type pos) const { return *slot(head + pos); }
+
+        reference       front()       { return *slot(head); }
+        const_reference front() const { return *slot(head); }
+
+        reference       back()       { return *slot(head + count - 1); }
+        const_reference back() const { return *slot(head + count - 1); }
+
+        iterator                begin()       { return iteratorAt(head);                  }
+        const_iterator          begin() const { return iteratorAt(head);                  }
+        iterator                  end()       { return iteratorAt(head + count);          }
+        const_iterator            end() const { return iteratorAt(head + count);          }
+        reverse_iterator       rbegin()       { return reverse_iterator(end());           }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end());     }
+        reverse_iterator         rend()       { return reverse_iterator(begin());         }
+        const_reverse_iterator   rend() const { return const_reverse_iterator(begin());   }
+
+        bool empty() const { return count == 0; }
+
+        size_type size() const { return count; }
+
+        size_type max_size() const {
+            size_type am = alloc.max_size();
+            size_type om = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+            return am < om ? am : om;
+        }
+
+        /**
+         * Removes all elements, keeping the chunk map and one chunk for later use.
+         */
+        void clear() {
+            while (count > 0) {
+                pop_back();
+            }
+        }
+
+        iterator insert(iterator pos, const T & value) {
+            return insert(pos, 1, value);
+        }
+
+        /**
+         * Inserts count copies of the given value before the given position. The elements
+         * on the shorter side of the position are rotated into place.
+         *
+         * @param pos The position where to insert the elements.
+         * @param count The amount of objects that should be inserted.
+         * @param value The value that should be copied.
+         * @return An iterator to the first inserted element.
+         */
+        iterator insert(iterator pos, size_type count, const T & value) {
+            const size_type index   = static_cast<size_type>(pos - begin());
+            const size_type oldSize = size();
+            if (index < oldSize / 2) {
+                try {
+                    for (size_type i = 0; i < count; ++i) {
+                        push_front(value);
+                    }
+                } catch (...) {
+                    while (size() > oldSize) pop_front();
+                    throw;
+                }
+                ft::rotate(begin(), begin() + count, begin() + count + index);
+            } else {
+                try {
+                    for (size_type i = 0; i < count; ++i) {
+                        push_back(value);
+                    }
+                } catch (...) {
+                    while (size() > oldSize) pop_back();
+                    throw;
+                }
+                ft::rotate(begin() + index, begin() + oldSize, end());
+            }
+            return begin() + index;
+        }
+
+        template<class InputIt>
+        iterator insert(iterator pos, InputIt first, typename ft::enable_if<!is_integral<InputIt>::value, InputIt>::type last) {
+            const size_type index = static_cast<size_type>(pos - begin());
+            insertRange(index, first, last, typename ft::iterator_traits<InputIt>::iterator_category());
+            return begin() + index;
+        }
+
+        iterator erase(iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        /**
+         * Removes the given range. The elements on the shorter side of the range are moved
+         * over the removed ones.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range to be removed.
+         * @return An iterator to the element following the removed ones.
+         */
+        iterator erase(iterator first, iterator last) {
+            const size_type index = static_cast<size_type>(first - begin());
+            const size_type n     = static_cast<size_type>(last - first);
+            if (index < (size() - n) / 2) {
+                std::copy_backward(begin(), first, last);
+                for (size_type i = 0; i < n; ++i) {
+                    pop_front();
+                }
+            } else {
+                std::copy(last, end(), first);
+                for (size_type i = 0; i < n; ++i) {
+                    pop_back();
+                }
+            }
+            return begin() + index;
+        }
+
+        void push_back(const T & value) {
+            if ((head + count) / chunkSize >= mapSize) {
+                growMap();
+            }
+            const size_type index = head + count;
+            const bool      fresh = acquireChunk(index / chunkSize);
+            try {
+                alloc.construct(slot(index), value);
+            } catch (...) {
+                if (fresh) releaseChunk(index / chunkSize);
+                throw;
+            }
+            ++count;
+        }
+
+        void push_front(const T & value) {
+            if (head == 0) {
+                growMap();
+            }
+            const size_type index = head - 1;
+            const bool      fresh = acquireChunk(index / chunkSize);
+            try {
+                alloc.construct(slot(index), value);
+            } catch (...) {
+                if (fresh) releaseChunk(index / chunkSize);
+                throw;
+            }
+            head = index;
+            ++count;
+        }
+
+        void pop_back() {
+            const size_type index = head + count - 1;
+            alloc.destroy(slot(index));
+            --count;
+            if (count == 0 || index % chunkSize == 0) {
+                releaseChunk(index / chunkSize);
+            }
+            if (count == 0) {
+                resetHead();
+            }
+        }
+
+        void pop_front() {
+            const size_type index = head;
+            alloc.destroy(slot(index));
+            ++head;
+            --count;
+            if (count == 0 || head % chunkSize == 0) {
+                releaseChunk(index / chunkSize);
+            }
+            if (count == 0) {
+                resetHead();
+            }
+        }
+
+        void resize(size_type count, T value = T()) {
+            while (size() > count) {
+                pop_back();
+            }
+            if (size() < count) {
+                insert(end(), count - size(), value);
+            }
+        }
+
+        void swap(deque & other) {
+            std::swap(alloc,    other.alloc);
+            std::swap(mapAlloc, other.mapAlloc);
+            std::swap(map,      other.map);
+            std::swap(mapSize,  other.mapSize);
+            std::swap(head,     other.head);
+            std::swap(count,    other.count);
+            std::swap(spare,    other.spare);
+        }
+
+    private:
+        /**
+         * The allocator used for the cells of the chunk map.
+         */
+        typedef typename Allocator::template rebind<pointer>::other mapAllocatorType;
+
+        /**
+         * The allocator used for the chunks.
+         */
+        allocator_type   alloc;
+        /**
+         * The allocator used for the chunk map.
+         */
+        mapAllocatorType mapAlloc;
+        /**
+         * The chunk map, one cell longer than mapSize. The cells not covering any element are NULL.
+         */
+        pointer *        map;
+        /**
+         * The count of usable cells in the chunk map.
+         */
+        size_type        mapSize;
+        /**
+         * The index of the first element, counted from the first slot of the first cell.
+         */
+        size_type        head;
+        /**
+         * The count of elements.
+         */
+        size_type        count;
+        /**
+         * A chunk kept after it has been emptied, so that pushing and popping at a chunk
+         * boundary does not allocate and release a chunk each time.
+         */
+        pointer          spare;
+
+        pointer slot(size_type index) const {
+            return map[index / chunkSize] + index % chunkSize;
+        }
+
+        iterator iteratorAt(size_type index) {
+            return map == NULL ? iterator() : iterator(slot(index), map + index / chunkSize);
+        }
+
+        const_iterator iteratorAt(size_type index) const {
+            return map == NULL ? const_iterator() : const_iterator(slot(index), map + index / chunkSize);
+        }
+
+        /**
+         * Makes sure the given cell holds a chunk.
+         *
+         * @param cell The index of the cell.
+         * @return Whether a chunk has been put into the cell.
+         */
+        bool acquireChunk(size_type cell) {
+            if (map[cell] != NULL) {
+                return false;
+            }
+            if (spare != NULL) {
+                map[cell] = spare;
+                spare     = NULL;
+            } else {
+                map[cell] = alloc.allocate(chunkSize);
+            }
+            return true;
+        }
+
+        /**
+         * Removes the chunk of the given cell, keeping it as spare chunk if there is none yet.
+         *
+         * @param cell The index of the cell.
+         */
+        void releaseChunk(size_type cell) {
+            if (spare == NULL) {
+                spare = map[cell];
+            } else {
+                alloc.deallocate(map[cell], chunkSize);
+            }
+            map[cell] = NULL;
+        }
+
+        /**
+         * Moves the head of an empty deque to the middle of the chunk map.
+         */
+        void resetHead() {
+            head = mapSize / 2 * chunkSize;
+        }
+
+        /**
+         * Makes room for a chunk at both ends of the chunk map. The used cells are centered in
+         * the map, which is doubled beforehand if they take more than about half of it.
+         */
+        void growMap() {
+            const size_type firstCell = head / chunkSize;
+            const size_type usedCells = count == 0 ? 0 : (head + count - 1) / chunkSize - firstCell + 1;
+            const size_type newSize   = mapSize == 0 ? 8 : (usedCells + 2) * 2 > mapSize ? mapSize * 2 : mapSize;
+            const size_type newFirst  = (newSize - usedCells) / 2;
+
+            if (newSize != mapSize) {
+                pointer * newMap = mapAlloc.allocate(newSize + 1);
+                std::fill(newMap, newMap + newSize + 1, pointer());
+                if (map != NULL) {
+                    std::copy(map + firstCell, map + firstCell + usedCells, newMap + newFirst);
+                    mapAlloc.deallocate(map, mapSize + 1);
+                }
+                map     = newMap;
+                mapSize = newSize;
+            } else {
+                if (newFirst < firstCell) {
+                    std::copy(map + firstCell, map + firstCell + usedCells, map + newFirst);
+                } else {
+                    std::copy_backward(map + firstCell, map + firstCell + usedCells, map + newFirst + usedCells);
+                }
+                std::fill(map, map + newFirst, pointer());
+                std::fill(map + newFirst + usedCells, map + mapSize, pointer());
+            }
+            head = newFirst * chunkSize + head % chunkSize;
+        }
+
+        /**
+         * Destroys all elements and releases all of the memory.
+         */
+        void release() {
+            clear();
+            if (spare != NULL) {
+                alloc.deallocate(spare, chunkSize);
+                spare = NULL;
+            }
+            if (map != NULL) {
+                mapAlloc.deallocate(map, mapSize + 1);
+                map     = NULL;
+                mapSize = 0;
+            }
+        }
+
+        template<class InputIt>
+        void insertInput(size_type index, InputIt first, InputIt last) {
+            const size_type oldSize = size();
+            try {
+                for (; first != last; ++first) {
+                    push_back(*first);
+                }
+            } catch (...) {
+                while (size() > oldSize) pop_back();
+                throw;
+            }
+            ft::rotate(begin() + index, begin() + oldSize, end());
+        }
+
+        /**
+         * Inserts the given range at the given index. If the index is in the front half, the
+         * range is pushed to the front in reverse and brought into order before rotating it
+         * into place.
+         *
+         * @param index The index where to insert the range.
+         * @param first The beginning of the range.
+         * @param last The end of the range to be inserted.
+         */
+        template<class ForwardIt>
+        void insertForward(size_type index, ForwardIt first, ForwardIt last) {
+            if (index >= size() / 2) {
+                insertInput(index, first, last);
+                return;
+            }
+            const size_type oldSize = size();
+            try {
+                for (; first != last; ++first) {
+                    push_front(*first);
+                }
+            } catch (...) {
+                while (size() > oldSize) pop_front();
+                throw;
+            }
+            const size_type n = size() - oldSize;
+            std::reverse(begin(), begin() + n);
+            ft::rotate(begin(), begin() + n, begin() + n + index);
+        }
+
+        template<class InputIt>
+        void insertRange(size_type index, InputIt first, InputIt last, std::forward_iterator_tag) {
+            insertForward(index, first, last);
+        }
+
+        template<class InputIt>
+        void insertRange(size_type index, InputIt first, InputIt last, ft::forward_iterator_tag) {
+            insertForward(index, first, last);
+        }
+
+        template<class InputIt>
+        void insertRange(size_type index, InputIt first, InputIt last, std::input_iterator_tag) {
+            insertInput(index, first, last);
+        }
+
+        template<class InputIt>
+        void insertRange(size_type index, InputIt first, InputIt last, ft::input_iterator_tag) {
+            insertInput(index, first, last);
+        }
+    };
+
+    template <class T, class Alloc>
+    bool operator==(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class Alloc>
+    bool operator!=(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <class T, class Alloc>
+    bool operator<(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) < 0;
+    }
+
+    template <class T, class Alloc>
+    bool operator<=(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) <= 0;
+    }
+
+    template <class T, class Alloc>
+    bool operator>(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) > 0;
+    }
+
+    template <class T, class Alloc>
+    bool operator>=(const deque<T, Alloc> & lhs, const deque<T, Alloc> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) >= 0;
+    }
+
+    template <class T, class Alloc>
+    void swap(deque<T, Alloc> & lhs, deque<T, Alloc> & rhs) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_DEQUE_HPP
@@ -0,0 +1,158 @@
+#ifndef FT_CONTAINERS_FROZEN_MAP_HPP
+#define FT_CONTAINERS_FROZEN_MAP_HPP
+
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "utility.hpp"
+#include "functional.hpp"
+#include "frozen_tree.hpp"
+
+namespace ft {
+    /**
+     * @brief A read-only map built once from a sorted range.
+     *
+     * The elements are stored contiguously in Eytzinger order, which makes lookups
+     * considerably faster than the ones of the map, at the cost of not being able to
+     * insert or erase any elements after the construction.
+     *
+     * @tparam Key The type of the keys.
+     * @tparam T The type of the mapped values.
+     * @tparam Compare The compare object used to sort the keys.
+     * @tparam Allocator The allocator used for the storage.
+     */
+    template<
+        class Key,
+        class T,
+        class Compare = ft::less<Key>,
+        class Allocator = std::allocator<ft::pair<const Key, T> >
+    > class frozen_map {
+    public:
+        class value_compare;
+
+        typedef Key                                              key_type;
+        typedef T                                                mapped_type;
+        typedef ft::pair<const Key, T>                           value_type;
+        typedef Compare                                          key_compare;
+        typedef Allocator                                        allocator_type;
+        typedef const value_type &                               reference;
+        typedef const value_type &                               const_reference;
+        typedef typename Allocator::const_pointer                pointer;
+        typedef typename Allocator::const_pointer                const_pointer;
+        /**
+         * The type of the used tree.
+         */
+        typedef FrozenTree<value_type, value_compare, Allocator> treeType;
+        typedef typename treeType::sizeType                      size_type;
+        typedef typename treeType::differenceType                difference_type;
+        typedef typename treeType::constIteratorType             iterator;
+        typedef typename treeType::constIteratorType             const_iterator;
+        typedef ft::reverse_iterator<iterator>                   reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator>             const_reverse_iterator;
+
+        class value_compare: public ft::binary_function<value_type, value_type, bool> {
+            friend class frozen_map;
+
+        public:
+            typedef bool       result_type;
+            typedef value_type first_argument_type;
+            typedef value_type second_argument_type;
+
+            bool operator()(const value_type & lhs, const value_type & rhs) const {
+                return comp(lhs.first, rhs.first);
+            }
+
+        protected:
+            Compare comp;
+
+            explicit value_compare(Compare c): comp(c) {}
+        };
+
+        /**
+         * Builds the map from the given range, which has to be sorted by the keys and must not
+         * contain duplicate keys, as the ranges of a map are. Runs in linear time.
+         *
+         * @param first The beginning of the sorted range.
+         * @param last The end of the sorted range.
+         * @param comp The compare object the range is sorted with.
+         * @param alloc The allocator to be used.
+         */
+        template<class InputIt>
+        frozen_map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(first, last, value_compare(comp), alloc) {}
+
+        frozen_map(const frozen_map & other)
+            : alloc(other.alloc), keyCompare(other.keyCompare), valueCompare(other.valueCompare), tree(other.tree) {}
+
+       ~frozen_map() {}
+
+        frozen_map & operator=(const frozen_map & other) {
+            if (&other != this) {
+                alloc        = other.alloc;
+                keyCompare   = other.keyCompare;
+                valueCompare = other.valueCompare;
+                tree         = other.tree;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        const T & at(const Key & key) const { return tree.findOrThrow(ft::make_pair(key, mapped_type())).second; }
+
+        const_iterator          begin() const { return tree.begin();                    }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end());   }
+        const_iterator            end() const { return tree.end();                      }
+        const_reverse_iterator   rend() const { return const_reverse_iterator(begin()); }
+
+        bool empty() const { return tree.isEmpty(); }
+
+        size_type     size() const { return tree.size();    }
+        size_type max_size() const { return tree.maxSize(); }
+
+        void swap(frozen_map & other) {
+            std::swap(alloc, other.alloc);
+            std::swap(keyCompare, other.keyCompare);
+            std::swap(valueCompare, other.valueCompare);
+            tree.swap(other.tree);
+        }
+
+        size_type count(const Key & key) const { return find(key) == end() ? 0 : 1; }
+
+        const_iterator find(const Key & key) const { return tree.find(ft::make_pair(key, mapped_type())); }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const Key & key) const {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        const_iterator lower_bound(const Key & key) const { return tree.lowerBound(ft::make_pair(key, mapped_type())); }
+        const_iterator upper_bound(const Key & key) const { return tree.upperBound(ft::make_pair(key, mapped_type())); }
+
+        key_compare key_comp() const { return keyCompare; }
+
+        value_compare value_comp() const { return valueCompare; }
+
+    private:
+        allocator_type alloc;
+        key_compare    keyCompare;
+        value_compare  valueCompare;
+        treeType       tree;
+    };
+
+    template<class Key, class T, class Compare, class Alloc>
+    bool operator==(const ft::frozen_map<Key, T, Compare, Alloc> & lhs, const ft::frozen_map<Key, T, Compare, Alloc> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    bool operator!=(const ft::frozen_map<Key, T, Compare, Alloc> & lhs, const ft::frozen_map<Key, T, Compare, Alloc> & rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    void swap(ft::frozen_map<Key, T, Compare, Alloc> & lhs, ft::frozen_map<Key, T, Compare, Alloc> & rhs) { lhs.swap(rhs); }
+}
+
+#endif //FT_CONTAINERS_FROZEN_MAP_HPP
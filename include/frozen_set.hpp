@@ -0,0 +1,129 @@
+#ifndef FT_CONTAINERS_FROZEN_SET_HPP
+#define FT_CONTAINERS_FROZEN_SET_HPP
+
+#include <algorithm>
+#include <memory>
+#include <cstddef>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "utility.hpp"
+#include "functional.hpp"
+#include "frozen_tree.hpp"
+
+namespace ft {
+    /**
+     * @brief A read-only set built once from a sorted range.
+     *
+     * The keys are stored contiguously in Eytzinger order, see frozen_map.
+     *
+     * @tparam Key The type of the keys.
+     * @tparam Compare The compare object used to sort the keys.
+     * @tparam Allocator The allocator used for the storage.
+     */
+    template<
+        class Key,
+        class Compare = ft::less<Key>,
+        class Allocator = std::allocator<Key>
+    > class frozen_set {
+    public:
+        typedef Key                                       key_type;
+        typedef Key                                       value_type;
+        typedef Compare                                   key_compare;
+        typedef Compare                                   value_compare;
+        typedef Allocator                                 allocator_type;
+        typedef const value_type &                        reference;
+        typedef const value_type &                        const_reference;
+        typedef typename Allocator::const_pointer         pointer;
+        typedef typename Allocator::const_pointer         const_pointer;
+        /**
+         * The type of the used tree.
+         */
+        typedef FrozenTree<value_type, Compare, Allocator> treeType;
+        typedef typename treeType::sizeType               size_type;
+        typedef typename treeType::differenceType         difference_type;
+        typedef typename treeType::constIteratorType      iterator;
+        typedef typename treeType::constIteratorType      const_iterator;
+        typedef ft::reverse_iterator<iterator>            reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator>      const_reverse_iterator;
+
+        /**
+         * Builds the set from the given range, which has to be sorted and must not contain
+         * equivalent keys, as the ranges of a set are. Runs in linear time.
+         *
+         * @param first The beginning of the sorted range.
+         * @param last The end of the sorted range.
+         * @param comp The compare object the range is sorted with.
+         * @param alloc The allocator to be used.
+         */
+        template<class InputIt>
+        frozen_set(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
+            : alloc(alloc), keyCompare(comp), tree(first, last, Compare(comp), alloc) {}
+
+        frozen_set(const frozen_set & other)
+            : alloc(other.alloc), keyCompare(other.keyCompare), tree(other.tree) {}
+
+       ~frozen_set() {}
+
+        frozen_set & operator=(const frozen_set & other) {
+            if (&other != this) {
+                alloc      = other.alloc;
+                keyCompare = other.keyCompare;
+                tree       = other.tree;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        const_iterator          begin() const { return tree.begin();                    }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end());   }
+        const_iterator            end() const { return tree.end();                      }
+        const_reverse_iterator   rend() const { return const_reverse_iterator(begin()); }
+
+        bool empty() const { return tree.isEmpty(); }
+
+        size_type     size() const { return tree.size();    }
+        size_type max_size() const { return tree.maxSize(); }
+
+        void swap(frozen_set & other) {
+            std::swap(alloc, other.alloc);
+            std::swap(keyCompare, other.keyCompare);
+            tree.swap(other.tree);
+        }
+
+        size_type count(const Key & key) const { return find(key) == end() ? 0 : 1; }
+
+        const_iterator find(const Key & key) const { return tree.find(key); }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const Key & key) const {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        const_iterator lower_bound(const Key & key) const { return tree.lowerBound(key); }
+        const_iterator upper_bound(const Key & key) const { return tree.upperBound(key); }
+
+        key_compare key_comp() const { return keyCompare; }
+
+        value_compare value_comp() const { return keyCompare; }
+
+    private:
+        allocator_type alloc;
+        key_compare    keyCompare;
+        treeType       tree;
+    };
+
+    template<class Key, class Compare, class Alloc>
+    bool operator==(const ft::frozen_set<Key, Compare, Alloc> & lhs, const ft::frozen_set<Key, Compare, Alloc> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template<class Key, class Compare, class Alloc>
+    bool operator!=(const ft::frozen_set<Key, Compare, Alloc> & lhs, const ft::frozen_set<Key, Compare, Alloc> & rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<class Key, class Compare, class Alloc>
+    void swap(ft::frozen_set<Key, Compare, Alloc> & lhs, ft::frozen_set<Key, Compare, Alloc> & rhs) { lhs.swap(rhs); }
+}
+
+#endif //FT_CONTAINERS_FROZEN_SET_HPP
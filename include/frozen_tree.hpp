@@ -0,0 +1,496 @@
+#ifndef FT_CONTAINERS_FROZEN_TREE_HPP
+#define FT_CONTAINERS_FROZEN_TREE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include "iterator.hpp"
+
+namespace ft {
+    /**
+     * @brief The greatest power of two not greater than N, one for zero.
+     */
+    template<std::size_t N>
+    struct FloorPowerOfTwo {
+        enum { value = 2 * FloorPowerOfTwo<N / 2>::value };
+    };
+
+    template<>
+    struct FloorPowerOfTwo<1> {
+        enum { value = 1 };
+    };
+
+    template<>
+    struct FloorPowerOfTwo<0> {
+        enum { value = 1 };
+    };
+
+    /**
+     * @brief An iterator walking the elements of a FrozenTree in ascending order.
+     *
+     * The elements are stored in Eytzinger order, the in-order successor and predecessor
+     * are therefore computed using index arithmetic.
+     *
+     * @tparam Content The content type this iterator points to.
+     */
+    template<class Content>
+    class FrozenTreeIterator: public  ft::iterator <ft::bidirectional_iterator_tag, const Content>,
+                              public std::iterator<std::bidirectional_iterator_tag, const Content> {
+    public:
+        /**
+         * The type of this iterator.
+         */
+        typedef  ft::iterator <ft::bidirectional_iterator_tag, const Content>       iterator_type;
+        /**
+         * The standard compliant type of this iterator.
+         */
+        typedef std::iterator<std::bidirectional_iterator_tag, const Content>       std_iterator_type;
+        /**
+         * The category of this iterator. (Standard compliant.)
+         */
+        typedef typename std::iterator_traits<std_iterator_type>::iterator_category iterator_category;
+        /**
+         * The type of the value this iterator points to.
+         */
+        typedef typename ft::iterator_traits<iterator_type>::value_type             value_type;
+        /**
+         * The difference type used for calculations with this iterator.
+         */
+        typedef typename ft::iterator_traits<iterator_type>::difference_type        difference_type;
+        /**
+         * The pointer type of this iterator.
+         */
+        typedef typename ft::iterator_traits<iterator_type>::pointer                pointer;
+        /**
+         * The reference type of this iterator.
+         */
+        typedef typename ft::iterator_traits<iterator_type>::reference              reference;
+
+        /**
+         * Default constructor.
+         */
+        FrozenTreeIterator()
+            : data(NULL), count(0), index(0) {}
+
+        /**
+         * Constructs an iterator pointing to the given Eytzinger index.
+         *
+         * @param data  The storage of the tree, index 0 being unused.
+         * @param count The number of elements in the tree.
+         * @param index The index this iterator points to, 0 being the end.
+         */
+        FrozenTreeIterator(const Content * data, std::size_t count, std::size_t index)
+            : data(data), count(count), index(index) {}
+
+        /**
+         * Returns the Eytzinger index this iterator points to.
+         *
+         * @return The index of the element, 0 for the past the end iterator.
+         */
+        std::size_t base() const { return index; }
+
+        reference operator*()  const { return data[index];  }
+        pointer   operator->() const { return &operator*(); }
+
+        /**
+         * Moves this iterator to the in-order successor.
+         *
+         * @return A reference to this instance.
+         */
+        FrozenTreeIterator & operator++() {
+            if (2 * index + 1 <= count) {
+                index = 2 * index + 1;
+                while (2 * index <= count) {
+                    index *= 2;
+                }
+            } else {
+                while (index & 1) {
+                    index >>= 1;
+                }
+                index >>= 1;
+            }
+            return *this;
+        }
+
+        /**
+         * Moves this iterator to the in-order predecessor. Decrementing the past the
+         * end iterator yields the last element.
+         *
+         * @return A reference to this instance.
+         */
+        FrozenTreeIterator & operator--() {
+            if (index == 0) {
+                for (index = count > 0 ? 1 : 0; index != 0 && 2 * index + 1 <= count; index = 2 * index + 1);
+            } else if (2 * index <= count) {
+                index *= 2;
+                while (2 * index + 1 <= count) {
+                    index = 2 * index + 1;
+                }
+            } else {
+                while (index != 0 && !(index & 1)) {
+                    index >>= 1;
+                }
+                index >>= 1;
+            }
+            return *this;
+        }
+
+        FrozenTreeIterator operator++(int) {
+            FrozenTreeIterator tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        FrozenTreeIterator operator--(int) {
+            FrozenTreeIterator tmp = *this;
+            operator--();
+            return tmp;
+        }
+
+        friend bool operator==(const FrozenTreeIterator & lhs, const FrozenTreeIterator & rhs) {
+            return lhs.index == rhs.index;
+        }
+
+        friend bool operator!=(const FrozenTreeIterator & lhs, const FrozenTreeIterator & rhs) {
+            return !(lhs.index == rhs.index);
+        }
+
+    private:
+        /**
+         * The storage of the iterated tree.
+         */
+        const Content * data;
+        /**
+         * The number of elements in the iterated tree.
+         */
+        std::size_t     count;
+        /**
+         * The Eytzinger index of the current element.
+         */
+        std::size_t     index;
+    };
+
+    /**
+     * @brief An immutable search tree stored in a single contiguous array.
+     *
+     * The elements are laid out in Eytzinger (breadth first) order: the children of the
+     * element at index k are found at 2k and 2k + 1, index 0 is unused. The top levels of
+     * the tree therefore share a few cache lines and the search does not need to chase
+     * any pointers. The search itself does not branch on the comparison result.
+     *
+     * @tparam T the type of the contents to be held by this tree
+     * @tparam Compare the comparator function that is used to sort the contents
+     * @tparam Allocator the allocator used for the storage
+     */
+    template<class T,
+             class Compare,
+             class Allocator>
+    class FrozenTree {
+    public:
+        /**
+         * The type of the content held by this tree.
+         */
+        typedef T                             contentType;
+        /**
+         * The type of the used allocator.
+         */
+        typedef Allocator                     allocatorType;
+        /**
+         * The type used for sizes.
+         */
+        typedef std::size_t                   sizeType;
+        /**
+         * The type used for differences.
+         */
+        typedef std::ptrdiff_t                differenceType;
+        /**
+         * The type of the compare object.
+         */
+        typedef Compare                       compareType;
+        /**
+         * The type of an iterator for this tree, the contents are always immutable.
+         */
+        typedef FrozenTreeIterator<T>         constIteratorType;
+
+        /**
+         * @brief Builds the tree from the given range in linear time.
+         *
+         * The range has to be sorted according to the given compare object and must
+         * not contain equivalent elements, which is the case for the ranges of a map or
+         * a set.
+         *
+         * @param first The beginning of the sorted range.
+         * @param last The end of the sorted range.
+         * @param comp The compare object the range is sorted with.
+         * @param alloc The allocator to be used.
+         */
+        template<class InputIt>
+        FrozenTree(InputIt first, InputIt last, const Compare & comp, const Allocator & alloc)
+            : data(NULL), count(0), alloc(alloc), compare(comp) {
+            const sizeType n = static_cast<sizeType>(ft::distance(first, last));
+            if (n == 0) return;
+            if (n >= maxSize()) throw std::length_error("ft::FrozenTree: Too much elements to be created!");
+            data = FrozenTree::alloc.allocate(n + 1);
+            count = n;
+            constIteratorType it = begin();
+            sizeType built = 0;
+            try {
+                for (; first != last; ++first, ++it, ++built) {
+                    FrozenTree::alloc.construct(data + it.base(), *first);
+                }
+            } catch (...) {
+                destroy(built);
+                throw;
+            }
+        }
+
+        /**
+         * Copy constructor. Copies the storage of the other tree, the layout is kept.
+         *
+         * @param other The other tree to copy.
+         */
+        FrozenTree(const FrozenTree & other)
+            : data(NULL), count(0), alloc(other.alloc), compare(other.compare) {
+            if (other.count == 0) return;
+            data = alloc.allocate(other.count + 1);
+            sizeType i = 1;
+            try {
+                for (; i <= other.count; ++i) {
+                    alloc.construct(data + i, other.data[i]);
+                }
+            } catch (...) {
+                while (--i > 0) {
+                    alloc.destroy(data + i);
+                }
+                alloc.deallocate(data, other.count + 1);
+                data = NULL;
+                throw;
+            }
+            count = other.count;
+        }
+
+        /**
+         * Destroys all elements and releases the storage.
+         */
+       ~FrozenTree() { destroy(count); }
+
+        /**
+         * Copy assignment operator. Replaces the contents by a copy of the other tree.
+         *
+         * @param other The other tree to copy.
+         * @return A reference to this tree.
+         */
+        FrozenTree & operator=(const FrozenTree & other) {
+            if (&other != this) {
+                FrozenTree tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        /**
+         * Swaps this tree with the other one.
+         *
+         * @param other The other tree to exchange the values with.
+         */
+        void swap(FrozenTree & other) {
+            T *           tmpData    = data;
+            sizeType      tmpCount   = count;
+            allocatorType tmpAlloc   = alloc;
+            compareType   tmpCompare = compare;
+
+            data    = other.data;
+            count   = other.count;
+            alloc   = other.alloc;
+            compare = other.compare;
+
+            other.data    = tmpData;
+            other.count   = tmpCount;
+            other.alloc   = tmpAlloc;
+            other.compare = tmpCompare;
+        }
+
+        bool     isEmpty() const { return count == 0; }
+        sizeType size()    const { return count;      }
+
+        /**
+         * Returns the maximal count of elements this tree can hold.
+         *
+         * @return The maximum count of elements.
+         */
+        sizeType maxSize() const {
+            sizeType allocatorSize = alloc.max_size(),
+                     diffSize      = static_cast<sizeType>(std::numeric_limits<differenceType>::max());
+            return allocatorSize > diffSize ? diffSize : allocatorSize;
+        }
+
+        /**
+         * Returns an iterator pointing to the smallest element of this tree.
+         *
+         * @return An iterator to the beginning of this tree.
+         */
+        constIteratorType begin() const {
+            sizeType k = count > 0 ? 1 : 0;
+            for (; k != 0 && 2 * k <= count; k *= 2);
+            return constIteratorType(data, count, k);
+        }
+
+        /**
+         * Returns an iterator pointing past the last element of this tree.
+         *
+         * @return A past the last iterator for this tree.
+         */
+        constIteratorType end() const { return constIteratorType(data, count, 0); }
+
+        /**
+         * @brief Searches for the element equivalent to the given value.
+         *
+         * If no such element is found, an iterator pointing to the end of the tree
+         * is returned.
+         *
+         * @param value The value to search for.
+         * @return An iterator pointing to the found element or to the end of the tree.
+         */
+        constIteratorType find(const contentType & value) const {
+            const sizeType k = lowerBoundIndex(value);
+            return constIteratorType(data, count, k != 0 && !compare(value, data[k]) ? k : 0);
+        }
+
+        /**
+         * Searches for an element equivalent to the given value. If no such element is found
+         * an out of range exception is thrown.
+         *
+         * @param value The value to search for.
+         * @return A reference to the found element.
+         */
+        const contentType & findOrThrow(const contentType & value) const {
+            const sizeType k = find(value).base();
+            if (k == 0) throw std::out_of_range("Value not found!");
+            return data[k];
+        }
+
+        /**
+         * @brief Searches for the first element whose value is not less than the given one.
+         *
+         * Returns the past the end iterator if no such element exists.
+         *
+         * @param value The value whose lower bound to be found.
+         * @return The first element not lower than the given one.
+         */
+        constIteratorType lowerBound(const contentType & value) const {
+            return constIteratorType(data, count, lowerBoundIndex(value));
+        }
+
+        /**
+         * @brief Searches for the first element whose value is greater than the given one.
+         *
+         * Returns the past the end iterator if no such element exists.
+         *
+         * @param value The value whose upper bound to be found.
+         * @return The first element greater than the given value.
+         */
+        constIteratorType upperBound(const contentType & value) const {
+            sizeType k = 1;
+            while (k <= count) {
+                prefetch(k);
+                k = 2 * k + !compare(value, data[k]);
+            }
+            return constIteratorType(data, count, leaveRightTurns(k));
+        }
+
+    private:
+        /**
+         * The number of elements fitting into one cache line, rounded down to a power of
+         * two, so that the descendants of the element at index k lying log2 of it levels
+         * below k are found at k times this number.
+         */
+        enum { prefetchStride = FloorPowerOfTwo<sizeof(T) >= 64 ? 1 : 64 / sizeof(T)>::value };
+
+        /**
+         * The storage of the elements, index 0 is unused.
+         */
+        T *           data;
+        /**
+         * The count of stored elements.
+         */
+        sizeType      count;
+        /**
+         * The allocator used for the storage.
+         */
+        allocatorType alloc;
+        /**
+         * The compare object used to sort the contents of this tree.
+         */
+        compareType   compare;
+
+        /**
+         * @brief Searches the index of the first element not less than the given value.
+         *
+         * The loop always runs for the height of the tree: the comparison result is
+         * added to the index instead of being branched on.
+         *
+         * @param value The value whose lower bound to be found.
+         * @return The index of the lower bound, 0 if there is none.
+         */
+        sizeType lowerBoundIndex(const contentType & value) const {
+            sizeType k = 1;
+            while (k <= count) {
+                prefetch(k);
+                k = 2 * k + compare(data[k], value);
+            }
+            return leaveRightTurns(k);
+        }
+
+        /**
+         * Removes the trailing right turns from the path encoded in the given index, which
+         * yields the last element where the search went to the left.
+         *
+         * @param k The index the search ended at.
+         * @return The index of the found element, 0 if there is none.
+         */
+        static inline sizeType leaveRightTurns(sizeType k) {
+#if defined(__GNUC__)
+            return k >> __builtin_ffsl(static_cast<long>(~k));
+#else
+            while (k & 1) {
+                k >>= 1;
+            }
+            return k >> 1;
+#endif
+        }
+
+        /**
+         * Prefetches the cache line holding the descendants of the given index.
+         *
+         * @param k The index currently visited by a search.
+         */
+        inline void prefetch(sizeType k) const {
+#if defined(__GNUC__)
+            if (k * prefetchStride <= count) {
+                __builtin_prefetch(data + k * prefetchStride);
+            }
+#else
+            (void) k;
+#endif
+        }
+
+        /**
+         * Destroys the given count of elements in in-order sequence and releases the storage.
+         *
+         * @param built The count of elements that have been constructed.
+         */
+        void destroy(sizeType built) {
+            if (data == NULL) return;
+            for (constIteratorType it = begin(); built > 0; ++it, --built) {
+                alloc.destroy(data + it.base());
+            }
+            alloc.deallocate(data, count + 1);
+            data  = NULL;
+            count = 0;
+        }
+    };
+}
+
+#endif //FT_CONTAINERS_FROZEN_TREE_HPP
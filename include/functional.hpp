@@ -19,6 +19,17 @@ namespace ft {
             return lhs < rhs;
         }
     };
+
+    template<class T>
+    struct plus: public binary_function<T, T, T> {
+        typedef T result_type;
+        typedef T first_argument_type;
+        typedef T second_argument_type;
+
+        T operator()(const T & lhs, const T & rhs) const {
+            return lhs + rhs;
+        }
+    };
 }
 
 #endif //FT_CONTAINERS_FUNCTIONAL_HPP
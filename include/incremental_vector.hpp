@@ -0,0 +1,324 @@
+#ifndef FT_CONTAINERS_INCREMENTAL_VECTOR_HPP
+#define FT_CONTAINERS_INCREMENTAL_VECTOR_HPP
+
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "IndexIterator.hpp"
+
+namespace ft {
+    /**
+     * @brief A vector moving its elements to newly allocated memory a few at a time.
+     *
+     * When the capacity is exceeded, new memory is allocated, but the elements stay in
+     * the old memory. Every following push_back moves Step of them over, until the old
+     * memory is empty and released. An element is looked up in the old or the new memory
+     * depending on the migration cursor. As the capacity is doubled, a migration is always
+     * finished before the new memory is full, so no push_back copies more than Step + 2
+     * elements, unless reserve has been called with a capacity too small for that.
+     *
+     * Elements are only moved by modifying operations, references and iterators are therefore
+     * valid until the next push_back, pop_back, reserve or clear.
+     *
+     * @tparam T The type of the contained objects.
+     * @tparam Allocator The allocator to use, by default the std::allocator.
+     * @tparam Step The count of elements moved per push_back, has to be at least one.
+     */
+    template <class T, class Allocator = std::allocator<T>, std::size_t Step = 4>
+    class incremental_vector {
+    public:
+        typedef T                                                                                   value_type;
+        typedef Allocator                                                                           allocator_type;
+        typedef std::size_t                                                                         size_type;
+        typedef std::ptrdiff_t                                                                      difference_type;
+        typedef value_type &                                                                        reference;
+        typedef const value_type &                                                                  const_reference;
+        typedef typename Allocator::pointer                                                         pointer;
+        typedef typename Allocator::const_pointer                                                   const_pointer;
+        typedef IndexIterator<incremental_vector, T, pointer, reference>                            iterator;
+        typedef IndexIterator<const incremental_vector, T, const_pointer, const_reference>          const_iterator;
+        typedef ft::reverse_iterator<iterator>                                                      reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator>                                                const_reverse_iterator;
+
+        explicit incremental_vector(const Allocator & alloc = Allocator())
+            : alloc(alloc), start(NULL), memory_capacity(0), object_count(0),
+              old(NULL), oldCapacity(0), oldCount(0), migrated(0) {}
+
+        incremental_vector(const incremental_vector & other)
+            : alloc(other.alloc), start(NULL), memory_capacity(0), object_count(0),
+              old(NULL), oldCapacity(0), oldCount(0), migrated(0) {
+            try {
+                reserve(other.size());
+                for (size_type i = 0; i < other.size(); ++i) {
+                    push_back(other[i]);
+                }
+            } catch (...) {
+                clear();
+                alloc.deallocate(start, memory_capacity);
+                throw;
+            }
+        }
+
+       ~incremental_vector() {
+            clear();
+            if (start != NULL) {
+                alloc.deallocate(start, memory_capacity);
+            }
+        }
+
+        incremental_vector & operator=(const incremental_vector & other) {
+            if (&other != this) {
+                incremental_vector tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return alloc; }
+
+        reference at(size_type pos) {
+            if (pos >= size()) throw std::out_of_range("ft::incremental_vector<T, Allocator>::at: Out of range!");
+            return *slot(pos);
+        }
+
+        const_reference at(size_type pos) const {
+            if (pos >= size()) throw std::out_of_range("ft::incremental_vector<T, Allocator>::at: Out of range!");
+            return *slot(pos);
+        }
+
+        reference       operator[](size_type pos)       { return *slot(pos); }
+        const_reference operator[](size_type pos) const { return *slot(pos); }
+
+        reference       front()       { return *slot(0); }
+        const_reference front() const { return *slot(0); }
+
+        reference       back()       { return *slot(object_count - 1); }
+        const_reference back() const { return *slot(object_count - 1); }
+
+        iterator                begin()       { return iterator(this, 0);                     }
+        const_iterator          begin() const { return const_iterator(this, 0);               }
+        iterator                  end()       { return iterator(this, object_count);          }
+        const_iterator            end() const { return const_iterator(this, object_count);    }
+        reverse_iterator       rbegin()       { return reverse_iterator(end());               }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end());         }
+        reverse_iterator         rend()       { return reverse_iterator(begin());             }
+        const_reverse_iterator   rend() const { return const_reverse_iterator(begin());       }
+
+        bool empty() const { return object_count == 0; }
+
+        size_type     size() const { return object_count;    }
+        size_type capacity() const { return memory_capacity; }
+
+        size_type max_size() const {
+            size_type am = alloc.max_size();
+            size_type om = static_cast<size_type>(std::numeric_limits<difference_type>::max());
+            return am < om ? am : om;
+        }
+
+        /**
+         * Returns whether some elements are still stored in the old memory.
+         *
+         * @return Whether a migration is in progress.
+         */
+        bool is_migrating() const { return old != NULL; }
+
+        /**
+         * Moves all remaining elements out of the old memory and releases it.
+         */
+        void finish_migration() {
+            migrate(oldCount - migrated);
+        }
+
+        /**
+         * Allocates memory for at least the given count of elements. The elements are moved
+         * to the new memory by the following calls of push_back. A migration still in progress
+         * is finished beforehand.
+         *
+         * @param new_cap The new capacity.
+         */
+        void reserve(size_type new_cap) {
+            if (new_cap > max_size()) throw std::length_error("ft::incremental_vector<T>::reserve: Too much elements to be reserved!");
+            if (new_cap > capacity()) {
+                finish_migration();
+                startMigration(new_cap);
+            }
+        }
+
+        void clear() {
+            for (size_type i = 0; i < object_count; ++i) {
+                alloc.destroy(slot(i));
+            }
+            object_count = 0;
+            endMigration();
+        }
+
+        /**
+         * Appends a copy of the given value, then moves up to Step elements out of the old memory.
+         *
+         * @param value The value to be appended.
+         */
+        void push_back(const T & value) {
+            if (object_count == memory_capacity) {
+                if (memory_capacity > max_size() / 2) throw std::length_error("ft::incremental_vector<T>::push_back: Too much elements!");
+                const T copy(value);
+                reserve(memory_capacity == 0 ? 1 : memory_capacity * 2);
+                alloc.construct(start + object_count, copy);
+            } else {
+                alloc.construct(start + object_count, value);
+            }
+            ++object_count;
+            migrate(Step);
+        }
+
+        void pop_back() {
+            alloc.destroy(slot(--object_count));
+            if (object_count < oldCount) {
+                oldCount = object_count;
+                if (migrated >= oldCount) {
+                    endMigration();
+                }
+            }
+        }
+
+        void swap(incremental_vector & other) {
+            std::swap(alloc,           other.alloc);
+            std::swap(start,           other.start);
+            std::swap(memory_capacity, other.memory_capacity);
+            std::swap(object_count,    other.object_count);
+            std::swap(old,             other.old);
+            std::swap(oldCapacity,     other.oldCapacity);
+            std::swap(oldCount,        other.oldCount);
+            std::swap(migrated,        other.migrated);
+        }
+
+    private:
+        /**
+         * The allocator used by this instance.
+         */
+        allocator_type alloc;
+        /**
+         * The current memory.
+         */
+        pointer        start;
+        /**
+         * The capacity of the current memory.
+         */
+        size_type      memory_capacity;
+        /**
+         * The count of elements.
+         */
+        size_type      object_count;
+        /**
+         * The memory the elements are moved out of, NULL if no migration is in progress.
+         */
+        pointer        old;
+        /**
+         * The capacity of the old memory.
+         */
+        size_type      oldCapacity;
+        /**
+         * The count of elements that were stored in the old memory.
+         */
+        size_type      oldCount;
+        /**
+         * The migration cursor, the count of elements already moved to the current memory.
+         */
+        size_type      migrated;
+
+        /**
+         * Returns the address of the element at the given index, in the old memory if it has
+         * not been moved yet, in the current memory otherwise.
+         *
+         * @param pos The index of the element.
+         * @return The address of the element.
+         */
+        pointer slot(size_type pos) const {
+            return pos >= migrated && pos < oldCount ? old + pos : start + pos;
+        }
+
+        /**
+         * Allocates the new memory, keeping the current one as the old memory to be emptied.
+         *
+         * @param new_cap The capacity of the new memory.
+         */
+        void startMigration(size_type new_cap) {
+            pointer fresh = alloc.allocate(new_cap);
+            old             = start;
+            oldCapacity     = memory_capacity;
+            oldCount        = object_count;
+            migrated        = 0;
+            start           = fresh;
+            memory_capacity = new_cap;
+            if (oldCount == 0) {
+                endMigration();
+            }
+        }
+
+        /**
+         * Moves up to the given count of elements from the old memory into the current one.
+         *
+         * @param count The count of elements to be moved.
+         */
+        void migrate(size_type count) {
+            for (; old != NULL && count > 0; --count) {
+                alloc.construct(start + migrated, old[migrated]);
+                alloc.destroy(old + migrated);
+                if (++migrated == oldCount) {
+                    endMigration();
+                }
+            }
+        }
+
+        /**
+         * Releases the old memory, which must not contain any elements anymore.
+         */
+        void endMigration() {
+            if (old != NULL) {
+                alloc.deallocate(old, oldCapacity);
+                old = NULL;
+            }
+            oldCapacity = 0;
+            oldCount    = 0;
+            migrated    = 0;
+        }
+    };
+
+    template <class T, class Alloc, std::size_t Step>
+    bool operator==(const incremental_vector<T, Alloc, Step> & lhs, const incremental_vector<T, Alloc, Step> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class Alloc, std::size_t Step>
+    bool operator!=(const incremental_vector<T, Alloc, Step> & lhs, const incremental_vector<T, Alloc, Step> & rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <class T, class Alloc, std::size_t Step>
+    bool operator<(const incremental_vector<T, Alloc, Step> & lhs, const incremental_vector<T, Alloc, Step> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) < 0;
+    }
+
+    template <class T, class Alloc, std::size_t Step>
+    bool operator<=(const incremental_vector<T, Alloc, Step> & lhs, const incremental_vector<T, Alloc, Step> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) <= 0;
+    }
+
+    template <class T, class Alloc, std::size_t Step>
+    bool operator>(const incremental_vector<T, Alloc, Step> & lhs, const incremental_vector<T, Alloc, Step> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) > 0;
+    }
+
+    template <class T, class Alloc, std::size_t Step>
+    bool operator>=(const incremental_vector<T, Alloc, Step> & lhs, const incremental_vector<T, Alloc, Step> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) >= 0;
+    }
+
+    template <class T, class Alloc, std::size_t Step>
+    void swap(incremental_vector<T, Alloc, Step> & lhs, incremental_vector<T, Alloc, Step> & rhs) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_INCREMENTAL_VECTOR_HPP
@@ -349,6 +349,38 @@ namespace ft {
     inline typename ft::iterator_traits<InputIt>::difference_type distance(InputIt first, InputIt last) {
         return do_distance(first, last, typename ft::iterator_traits<InputIt>::iterator_category());
     }
+
+    template<class InputIt, class Distance>
+    void do_advance(InputIt & it, Distance n, ft::random_access_iterator_tag) {
+        it += n;
+    }
+
+    template<class InputIt, class Distance>
+    void do_advance(InputIt & it, Distance n, std::random_access_iterator_tag) {
+        it += n;
+    }
+
+    template<class InputIt, class Distance>
+    void do_advance(InputIt & it, Distance n, ft::input_iterator_tag) {
+        for (; n > 0; --n, ++it);
+    }
+
+    template<class InputIt, class Distance>
+    void do_advance(InputIt & it, Distance n, std::input_iterator_tag) {
+        for (; n > 0; --n, ++it);
+    }
+
+    /**
+     * Advances the given iterator by the given count of elements, in constant time for random
+     * access iterators.
+     *
+     * @param it The iterator to be advanced.
+     * @param n The count of elements, not negative unless the iterator is a random access iterator.
+     */
+    template<class InputIt, class Distance>
+    inline void advance(InputIt & it, Distance n) {
+        do_advance(it, n, typename ft::iterator_traits<InputIt>::iterator_category());
+    }
 }
 
 #endif //FT_CONTAINERS_ITERATOR_HPP
@@ -12,13 +12,15 @@
 #include "utility.hpp"
 #include "functional.hpp"
 #include "tree.hpp"
+#include "frozen_map.hpp"
 
 namespace ft {
     template<
         class Key,
         class T,
         class Compare = ft::less<Key>,
-        class Allocator = std::allocator<ft::pair<const Key, T> >
+        class Allocator = std::allocator<ft::pair<const Key, T> >,
+        class Options = ft::tree_options<>
     > class map {
     public:
         class value_compare;
@@ -35,13 +37,15 @@ namespace ft {
         /**
          * The type of the used tree.
          */
-        typedef Tree<value_type, value_compare, Allocator> treeType;
+        typedef Tree<value_type, value_compare, Allocator, Options> treeType;
         typedef typename treeType::sizeType                size_type;
         typedef typename treeType::differenceType          difference_type;
         typedef typename treeType::iteratorType            iterator;
         typedef typename treeType::constIteratorType       const_iterator;
         typedef ft::reverse_iterator<iterator>             reverse_iterator;
         typedef ft::reverse_iterator<const_iterator>       const_reverse_iterator;
+        typedef tree_range<reference, typename treeType::nodeType>       range_type;
+        typedef tree_range<const_reference, typename treeType::nodeType> const_range_type;
 
         class value_compare: public ft::binary_function<value_type, value_type, bool> {
             friend class map;
@@ -61,14 +65,14 @@ namespace ft {
             explicit value_compare(Compare c): comp(c) {}
         };
 
-        map(): alloc(Allocator()), keyCompare(key_compare()), valueCompare(keyCompare), tree(valueCompare) {}
+        map(): alloc(Allocator()), keyCompare(key_compare()), valueCompare(keyCompare), tree(valueCompare, alloc) {}
 
         explicit map(const Compare & comp, const Allocator & alloc = Allocator())
-            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare) {}
+            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare, alloc) {}
 
         template<class InputIt>
         map(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
-            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare) {
+            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare, alloc) {
             insert(first, last);
         }
 
@@ -111,12 +115,64 @@ namespace ft {
         size_type     size() const { return tree.size();    }
         size_type max_size() const { return tree.maxSize(); }
 
+        memory_report memory_usage() const { return tree.memoryUsage(); }
+
+        /**
+         * Returns the height, the black height and the count of the nodes of the underlying
+         * tree, together with the counters collected if Options uses tree_stats.
+         *
+         * @return The statistics of the underlying tree.
+         */
+        tree_statistics stats() const { return tree.statistics(); }
+
+        void reset_stats() { tree.resetStatistics(); }
+
+        /**
+         * Cuts this map into disjoint ranges of elements which can be visited concurrently,
+         * see Tree::split.
+         *
+         * @param depth The depth of the subtrees.
+         * @param out The output of the ranges.
+         * @return The end of the output.
+         */
+        template<class OutputIt>
+        OutputIt split(size_type depth, OutputIt out) { return tree.template split<range_type>(depth, out); }
+
+        template<class OutputIt>
+        OutputIt split(size_type depth, OutputIt out) const { return tree.template split<const_range_type>(depth, out); }
+
         void clear() { tree.clear(); }
 
         ft::pair<iterator, bool> insert(const value_type & value) { return tree.insert(value); }
 
         iterator insert(iterator hint, const value_type & value) { return tree.insert(hint, value); }
 
+        /**
+         * Replaces the contents of this map by the given range, building the tree bottom up,
+         * which is much faster than inserting the elements one by one.
+         *
+         * @param first The beginning of the range, sorted and free of equivalent keys.
+         * @param last The end of the range.
+         */
+        template<class RandomIt>
+        void assign_sorted(RandomIt first, RandomIt last) {
+            serial_executor executor;
+            tree.assignSorted(first, last, executor);
+        }
+
+        /**
+         * Replaces the contents of this map by the given range, the subtrees being built by the
+         * given executor, see ft::parallel::bulk_load.
+         *
+         * @param first The beginning of the range, sorted and free of equivalent keys.
+         * @param last The end of the range.
+         * @param executor Runs the builds of the subtrees.
+         */
+        template<class RandomIt, class Executor>
+        void assign_sorted(RandomIt first, RandomIt last, Executor & executor) {
+            tree.assignSorted(first, last, executor);
+        }
+
         template<class InputIt>
         void insert(InputIt first, InputIt last) {
             for (; first != last; ++first) {
@@ -144,7 +200,17 @@ namespace ft {
             return 0;
         }
 
-        void swap(map & other) { tree.swap(other.tree); }
+        /**
+         * Exchanges the contents of this map with the other one. With inline nodes, see
+         * tree_options, this may allocate and throw, and the iterators to the elements stored
+         * inline are invalidated; otherwise no iterator is invalidated.
+         *
+         * @param other The other map.
+         */
+        void swap(map & other) {
+            std::swap(alloc, other.alloc);
+            tree.swap(other.tree);
+        }
 
         size_type count(const Key & key) const { return find(key) == end() ? 0 : 1; }
 
@@ -167,7 +233,16 @@ namespace ft {
 
         key_compare key_comp() const { return keyCompare; }
 
-        ft::map<Key, T, Compare, Allocator>::value_compare value_comp() const { return valueCompare; }
+        ft::map<Key, T, Compare, Allocator, Options>::value_compare value_comp() const { return valueCompare; }
+
+        /**
+         * Creates a read-only copy of this map whose lookups do not need to chase any pointers.
+         *
+         * @return A frozen map holding the same elements as this map.
+         */
+        ft::frozen_map<Key, T, Compare, Allocator> freeze() const {
+            return ft::frozen_map<Key, T, Compare, Allocator>(begin(), end(), keyCompare, alloc);
+        }
 
     private:
         allocator_type alloc;
@@ -176,45 +251,38 @@ namespace ft {
         treeType       tree;
     };
 
-    template<class Key, class T, class Compare, class Alloc>
-    bool operator==(const ft::map<Key, T, Compare, Alloc> & lhs, const ft::map<Key, T, Compare, Alloc> & rhs) {
-        typename ft::map<Key, T, Compare, Alloc>::const_iterator it,
-                                                                 it2;
-        for (it = lhs.begin(), it2 = rhs.begin(); it != lhs.end() && it2 != rhs.end(); ++it, ++it2) {
-            if (!(*it == *it2)) {
-                return false;
-            }
-        }
-        return it == lhs.end() && it2 == rhs.end();
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    bool operator==(const ft::map<Key, T, Compare, Alloc, Options> & lhs, const ft::map<Key, T, Compare, Alloc, Options> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template<class Key, class T, class Compare, class Alloc>
-    bool operator!=(const ft::map<Key, T, Compare, Alloc> & lhs, const ft::map<Key, T, Compare, Alloc> & rhs) {
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    bool operator!=(const ft::map<Key, T, Compare, Alloc, Options> & lhs, const ft::map<Key, T, Compare, Alloc, Options> & rhs) {
         return !(lhs == rhs);
     }
 
-    template<class Key, class T, class Compare, class Alloc>
-    bool operator<(const ft::map<Key, T, Compare, Alloc> & lhs, const ft::map<Key, T, Compare, Alloc> & rhs) {
-        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    bool operator<(const ft::map<Key, T, Compare, Alloc, Options> & lhs, const ft::map<Key, T, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) < 0;
     }
 
-    template<class Key, class T, class Compare, class Alloc>
-    bool operator<=(const ft::map<Key, T, Compare, Alloc> & lhs, const ft::map<Key, T, Compare, Alloc> & rhs) {
-        return lhs < rhs || lhs == rhs;
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    bool operator<=(const ft::map<Key, T, Compare, Alloc, Options> & lhs, const ft::map<Key, T, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) <= 0;
     }
 
-    template<class Key, class T, class Compare, class Alloc>
-    bool operator>(const ft::map<Key, T, Compare, Alloc> & lhs, const ft::map<Key, T, Compare, Alloc> & rhs) {
-        return rhs < lhs;
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    bool operator>(const ft::map<Key, T, Compare, Alloc, Options> & lhs, const ft::map<Key, T, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) > 0;
     }
 
-    template<class Key, class T, class Compare, class Alloc>
-    bool operator>=(const ft::map<Key, T, Compare, Alloc> & lhs, const ft::map<Key, T, Compare, Alloc> & rhs) {
-        return rhs < lhs || lhs == rhs;
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    bool operator>=(const ft::map<Key, T, Compare, Alloc, Options> & lhs, const ft::map<Key, T, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) >= 0;
     }
 
-    template<class Key, class T, class Compare, class Alloc>
-    void swap(ft::map<Key, T, Compare, Alloc> & lhs, ft::map<Key, T, Compare, Alloc> & rhs) { lhs.swap(rhs); }
+    template<class Key, class T, class Compare, class Alloc, class Options>
+    void swap(ft::map<Key, T, Compare, Alloc, Options> & lhs, ft::map<Key, T, Compare, Alloc, Options> & rhs) { lhs.swap(rhs); }
 }
 
 #endif //FT_CONTAINERS_MAP_HPP
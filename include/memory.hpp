@@ -0,0 +1,54 @@
+#ifndef FT_CONTAINERS_MEMORY_HPP
+#define FT_CONTAINERS_MEMORY_HPP
+
+#include <cstddef>
+#include "type_traits.hpp"
+
+namespace ft {
+    /**
+     * The memory taken by the elements of a container, split into the bytes of the elements
+     * themselves and the bytes the container needs on top of them, such as the links and the
+     * colours of the nodes, the sentinels or unused capacity. Memory the elements allocate
+     * on their own is not included.
+     */
+    struct memory_report {
+        std::size_t payload_bytes;
+        std::size_t overhead_bytes;
+
+        explicit memory_report(std::size_t payload = 0, std::size_t overhead = 0)
+            : payload_bytes(payload), overhead_bytes(overhead) {}
+
+        std::size_t total_bytes() const { return payload_bytes + overhead_bytes; }
+    };
+
+    /**
+     * Whether the allocator provides reallocate(p, oldCount, newCount), which resizes a block
+     * by moving its bytes, possibly without copying them at all.
+     *
+     * @tparam Allocator The allocator to be checked.
+     */
+    template<class Allocator>
+    struct allocator_can_reallocate: public false_type {};
+
+    /**
+     * Whether deallocating through the allocator does not need to be done, as its memory is
+     * released in bulk. Containers may then skip visiting their elements when clearing, if
+     * the elements are trivially destructible.
+     *
+     * @tparam Allocator The allocator to be checked.
+     */
+    template<class Allocator>
+    struct allocator_has_trivial_deallocate: public false_type {};
+
+    /**
+     * Whether an object of type T may be moved to another address by copying its bytes, instead
+     * of copy constructing it and destroying the original. Can be specialized for own types that
+     * do not keep pointers to themselves.
+     *
+     * @tparam T The type to be checked.
+     */
+    template<class T>
+    struct is_trivially_relocatable: public integral_constant<bool, __has_trivial_copy(T) && __has_trivial_destructor(T)> {};
+}
+
+#endif //FT_CONTAINERS_MEMORY_HPP
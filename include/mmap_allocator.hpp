@@ -0,0 +1,164 @@
+#ifndef FT_CONTAINERS_MMAP_ALLOCATOR_HPP
+#define FT_CONTAINERS_MMAP_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "memory.hpp"
+
+namespace ft {
+    /**
+     * @brief An allocator serving big blocks directly from anonymous memory mappings.
+     *
+     * Blocks of at least ThresholdBytes are mapped using mmap, smaller ones are taken from the
+     * free store. A mapped block can be resized by reallocate, which remaps the pages where
+     * mremap is available instead of copying them.
+     *
+     * @tparam T The type of the allocated objects.
+     * @tparam ThresholdBytes The size in bytes from which on blocks are mapped.
+     * @tparam HugePages Whether the mapped blocks should be backed by transparent huge pages.
+     */
+    template<class T, std::size_t ThresholdBytes = (1 << 21), bool HugePages = false>
+    class mmap_allocator {
+    public:
+        typedef T                  value_type;
+        typedef T *                pointer;
+        typedef const T *          const_pointer;
+        typedef T &                reference;
+        typedef const T &          const_reference;
+        typedef std::size_t        size_type;
+        typedef std::ptrdiff_t     difference_type;
+
+        template<class U>
+        struct rebind {
+            typedef mmap_allocator<U, ThresholdBytes, HugePages> other;
+        };
+
+        mmap_allocator() {}
+        mmap_allocator(const mmap_allocator &) {}
+        template<class U>
+        mmap_allocator(const mmap_allocator<U, ThresholdBytes, HugePages> &) {}
+       ~mmap_allocator() {}
+
+        pointer       address(reference x)       const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, const T & value) { new (static_cast<void *>(p)) T(value); }
+        void destroy(pointer p)                    { p->~T();                               }
+
+        /**
+         * Allocates uninitialized memory for n objects.
+         *
+         * @param n The count of objects.
+         * @return The allocated memory.
+         */
+        pointer allocate(size_type n, const void * = 0) {
+            if (n > max_size()) throw std::bad_alloc();
+            if (!isMapped(n)) {
+                return static_cast<pointer>(::operator new(n * sizeof(T)));
+            }
+            void * block = mmap(NULL, mappedSize(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (block == MAP_FAILED) throw std::bad_alloc();
+            adviseHugePages(block, mappedSize(n));
+            return static_cast<pointer>(block);
+        }
+
+        /**
+         * Releases the memory of n objects previously allocated by this allocator.
+         *
+         * @param p The memory to be released.
+         * @param n The count of objects the memory was allocated for.
+         */
+        void deallocate(pointer p, size_type n) {
+            if (isMapped(n)) {
+                munmap(p, mappedSize(n));
+            } else {
+                ::operator delete(p);
+            }
+        }
+
+        /**
+         * @brief Resizes the given block to hold newCount objects.
+         *
+         * The bytes of the first objects are kept, the objects are therefore moved without
+         * calling any of their constructors. Mapped blocks are remapped if possible, the
+         * pages are then not copied at all.
+         *
+         * @param p The block to be resized.
+         * @param oldCount The count of objects the block was allocated for.
+         * @param newCount The count of objects the block should hold.
+         * @return The address of the resized block.
+         */
+        pointer reallocate(pointer p, size_type oldCount, size_type newCount) {
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+            if (isMapped(oldCount) && isMapped(newCount)) {
+                void * block = mremap(p, mappedSize(oldCount), mappedSize(newCount), MREMAP_MAYMOVE);
+                if (block == MAP_FAILED) throw std::bad_alloc();
+                adviseHugePages(block, mappedSize(newCount));
+                return static_cast<pointer>(block);
+            }
+#endif
+            pointer block = allocate(newCount);
+            std::memcpy(static_cast<void *>(block), static_cast<const void *>(p), (oldCount < newCount ? oldCount : newCount) * sizeof(T));
+            deallocate(p, oldCount);
+            return block;
+        }
+
+    private:
+        /**
+         * Returns whether a block of the given count of objects is mapped.
+         *
+         * @param n The count of objects.
+         * @return Whether the block is served by mmap.
+         */
+        static bool isMapped(size_type n) { return n * sizeof(T) >= ThresholdBytes; }
+
+        /**
+         * Returns the size of the mapping holding the given count of objects, rounded to whole pages.
+         *
+         * @param n The count of objects.
+         * @return The size of the mapping in bytes.
+         */
+        static std::size_t mappedSize(size_type n) {
+            static const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+            return (n * sizeof(T) + page - 1) / page * page;
+        }
+
+        /**
+         * Asks the kernel to back the given mapping with huge pages, if enabled.
+         *
+         * @param block The mapping.
+         * @param size The size of the mapping in bytes.
+         */
+        static void adviseHugePages(void * block, std::size_t size) {
+#ifdef MADV_HUGEPAGE
+            if (HugePages) {
+                madvise(block, size, MADV_HUGEPAGE);
+            }
+#else
+            (void) block;
+            (void) size;
+#endif
+        }
+    };
+
+    template<class T, std::size_t ThresholdBytes, bool HugePages>
+    struct allocator_can_reallocate<mmap_allocator<T, ThresholdBytes, HugePages> >: public true_type {};
+
+    template<class T, class U, std::size_t ThresholdBytes, bool HugePages>
+    bool operator==(const mmap_allocator<T, ThresholdBytes, HugePages> &, const mmap_allocator<U, ThresholdBytes, HugePages> &) {
+        return true;
+    }
+
+    template<class T, class U, std::size_t ThresholdBytes, bool HugePages>
+    bool operator!=(const mmap_allocator<T, ThresholdBytes, HugePages> &, const mmap_allocator<U, ThresholdBytes, HugePages> &) {
+        return false;
+    }
+}
+
+#endif //FT_CONTAINERS_MMAP_ALLOCATOR_HPP
@@ -0,0 +1,67 @@
+#ifndef FT_CONTAINERS_OFFSET_PTR_HPP
+#define FT_CONTAINERS_OFFSET_PTR_HPP
+
+#include <cstddef>
+
+namespace ft {
+    /**
+     * @brief A pointer storing the distance from its own address to the pointed to object.
+     *
+     * As long as the pointer and the object are moved together, for example by mapping the
+     * memory holding both at another address, the pointer stays valid. Copying the pointer
+     * to another place recomputes the distance, so that copies point to the same object.
+     * The pointer converts implicitly from and to a plain pointer, it can therefore replace
+     * one in most expressions.
+     *
+     * @tparam T The type of the pointed to object.
+     */
+    template<class T>
+    class offset_ptr {
+    public:
+        typedef T element_type;
+
+        offset_ptr(): offset(nullOffset) {}
+        offset_ptr(T * pointer) { set(pointer); }
+        offset_ptr(const offset_ptr & other) { set(other.get()); }
+
+        offset_ptr & operator=(const offset_ptr & other) {
+            set(other.get());
+            return *this;
+        }
+
+        offset_ptr & operator=(T * pointer) {
+            set(pointer);
+            return *this;
+        }
+
+        /**
+         * Returns the address of the pointed to object in the current mapping.
+         *
+         * @return The plain pointer.
+         */
+        T * get() const {
+            return offset == nullOffset ? NULL : reinterpret_cast<T *>(reinterpret_cast<std::size_t>(this) + offset);
+        }
+
+        operator T *()     const { return get();  }
+        T * operator->()   const { return get();  }
+        T & operator*()    const { return *get(); }
+
+    private:
+        /**
+         * The offset standing for NULL, never the one of an aligned object.
+         */
+        static const std::size_t nullOffset = 1;
+
+        /**
+         * The distance to the object, wrapping around if it is located below this pointer.
+         */
+        std::size_t offset;
+
+        void set(T * pointer) {
+            offset = pointer == NULL ? nullOffset : reinterpret_cast<std::size_t>(pointer) - reinterpret_cast<std::size_t>(this);
+        }
+    };
+}
+
+#endif //FT_CONTAINERS_OFFSET_PTR_HPP
@@ -0,0 +1,1473 @@
+#ifndef FT_CONTAINERS_PARALLEL_HPP
+#define FT_CONTAINERS_PARALLEL_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "algorithm.hpp"
+#include "deque.hpp"
+#include "functional.hpp"
+#include "iterator.hpp"
+#include "map.hpp"
+#include "set.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+namespace ft {
+    class thread_pool;
+    class PoolGroup;
+
+    /**
+     * @brief Locks a mutex for the lifetime of the guard.
+     */
+    class MutexGuard {
+    public:
+        explicit MutexGuard(pthread_mutex_t & mutex): mutex(mutex) { pthread_mutex_lock(&mutex); }
+       ~MutexGuard()                                                { pthread_mutex_unlock(&mutex); }
+
+    private:
+        pthread_mutex_t & mutex;
+
+        MutexGuard(const MutexGuard &);
+        MutexGuard & operator=(const MutexGuard &);
+    };
+
+    /**
+     * @brief A piece of work run by a thread of a thread pool.
+     *
+     * Every task belongs to a group, which is told once the task has been run.
+     */
+    class PoolTask {
+    public:
+        PoolTask(): group(NULL) {}
+        virtual ~PoolTask() {}
+
+        /**
+         * Runs this task.
+         *
+         * @param pool The pool running the task.
+         * @param worker The index of the thread running the task.
+         */
+        virtual void run(thread_pool & pool, std::size_t worker) = 0;
+
+        /**
+         * The group this task belongs to.
+         */
+        PoolGroup * group;
+    };
+
+    /**
+     * @brief A count of spawned tasks not run yet, waited for by the thread spawning them,
+     * together with the first exception thrown by one of the tasks.
+     */
+    class PoolGroup {
+    public:
+        PoolGroup(): pending(0), failed(false), badAlloc(false) {
+            message[0] = message[sizeof(message) - 1] = '\0';
+        }
+
+        /**
+         * Pushes the given task onto the deque of the given thread. The task is deleted once
+         * it has been run.
+         *
+         * @param pool The pool to run the task.
+         * @param worker The index of the spawning thread.
+         * @param task The task to be run.
+         */
+        inline void spawn(thread_pool & pool, std::size_t worker, PoolTask * task);
+
+        /**
+         * Runs the tasks of the pool until all tasks of this group have been run, then throws
+         * the first exception thrown by one of them again.
+         *
+         * @param pool The pool running the tasks.
+         * @param worker The index of the waiting thread.
+         * @throws std::bad_alloc If a task has thrown a std::bad_alloc first.
+         * @throws std::runtime_error With the message of the first exception of a task otherwise.
+         */
+        inline void wait(thread_pool & pool, std::size_t worker);
+
+        /**
+         * Records the given exception thrown by a task of this group, unless another task
+         * has failed before.
+         *
+         * @param exception The exception, NULL if it is not a std::exception.
+         */
+        void fail(const std::exception * exception) {
+            bool expected = false;
+            if (!__atomic_compare_exchange_n(&failed, &expected, true, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return;
+            badAlloc = dynamic_cast<const std::bad_alloc *>(exception) != NULL;
+            std::strncpy(message, exception != NULL ? exception->what() : "ft::thread_pool: A task threw an unknown exception!",
+                         sizeof(message) - 1);
+        }
+
+        /**
+         * Marks one task of this group as done.
+         */
+        void done() {
+            __atomic_sub_fetch(&pending, 1, __ATOMIC_RELEASE);
+        }
+
+    private:
+        /**
+         * The count of spawned tasks not run yet.
+         */
+        std::size_t pending;
+        /**
+         * Whether a task has thrown an exception.
+         */
+        bool        failed;
+        /**
+         * Whether the first exception was a std::bad_alloc.
+         */
+        bool        badAlloc;
+        /**
+         * The message of the first exception.
+         */
+        char        message[256];
+    };
+
+    /**
+     * @brief A fixed set of threads running tasks, each thread having a deque of its own.
+     *
+     * A thread pushes the tasks it spawns to the back of its deque and takes them from there
+     * again, newest first, so that it works on data still in its caches. Once its deque is
+     * empty, it steals the oldest task of another thread, which is usually the biggest one
+     * left. Idle threads sleep until a task is pushed.
+     *
+     * The thread calling run takes part as thread zero, the pool therefore starts one thread
+     * less than the count it is constructed with. Calls of run from several outside threads
+     * are serialized; a task must not call run itself but spawn into its group instead.
+     * An exception thrown by a task is caught by the thread running it, the first one is
+     * thrown again by run once all tasks are done. As C++98 cannot copy an exception of an
+     * unknown type, only a std::bad_alloc keeps its type, any other exception is turned into
+     * a std::runtime_error carrying its message.
+     */
+    class thread_pool {
+    public:
+        /**
+         * Constructs a pool of the given count of threads, including the calling one.
+         *
+         * @param threads The count of threads, at least one.
+         */
+        explicit thread_pool(std::size_t threads = hardware_threads())
+            : threadCount(threads == 0 ? 1 : threads), queues(NULL), starts(NULL), workers(NULL),
+              started(0), queued(0), sleeping(0), stopping(false) {
+            pthread_mutex_init(&entry, NULL);
+            pthread_mutex_init(&sleepMutex, NULL);
+            pthread_cond_init(&wakeUp, NULL);
+            try {
+                queues  = new Queue[threadCount];
+                starts  = new WorkerStart[threadCount];
+                workers = new pthread_t[threadCount];
+                for (started = 1; started < threadCount; ++started) {
+                    starts[started].pool  = this;
+                    starts[started].index = started;
+                    if (pthread_create(&workers[started], NULL, &thread_pool::workerMain, &starts[started]) != 0) {
+                        throw std::runtime_error("ft::thread_pool: Could not start a thread!");
+                    }
+                }
+            } catch (...) {
+                shutdown();
+                throw;
+            }
+        }
+
+       ~thread_pool() {
+            shutdown();
+        }
+
+        /**
+         * Returns the count of threads, including the one calling run.
+         *
+         * @return The count of threads.
+         */
+        std::size_t size() const { return threadCount; }
+
+        /**
+         * Returns the count of processors online, at least one.
+         *
+         * @return The count of hardware threads.
+         */
+        static std::size_t hardware_threads() {
+            const long count = sysconf(_SC_NPROCESSORS_ONLN);
+            return count < 1 ? 1 : static_cast<std::size_t>(count);
+        }
+
+        /**
+         * Runs the given task and everything it spawns, returning once all of it is done.
+         *
+         * @param task The task to be run, deleted afterwards.
+         * @throws std::bad_alloc If a task has thrown a std::bad_alloc first.
+         * @throws std::runtime_error With the message of the first exception of a task otherwise.
+         */
+        void run(PoolTask * task) {
+            MutexGuard lock(entry);
+            PoolGroup  group;
+            group.spawn(*this, 0, task);
+            group.wait(*this, 0);
+        }
+
+        /**
+         * Pushes the given task onto the deque of the given thread and wakes up a sleeping thread.
+         *
+         * @param worker The index of the pushing thread.
+         * @param task The task to be pushed.
+         */
+        void push(std::size_t worker, PoolTask * task) {
+            Queue & queue = queues[worker];
+            {
+                MutexGuard lock(queue.mutex);
+                queue.tasks.push_back(task);
+            }
+            __atomic_add_fetch(&queued, 1, __ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&sleeping, __ATOMIC_SEQ_CST) > 0) {
+                pthread_mutex_lock(&sleepMutex);
+                pthread_cond_signal(&wakeUp);
+                pthread_mutex_unlock(&sleepMutex);
+            }
+        }
+
+        /**
+         * Takes the newest task of the deque of the given thread, or steals the oldest task of
+         * another thread if that deque is empty.
+         *
+         * @param worker The index of the taking thread.
+         * @return The task or NULL if all deques are empty.
+         */
+        PoolTask * take(std::size_t worker) {
+            if (__atomic_load_n(&queued, __ATOMIC_SEQ_CST) == 0) return NULL;
+
+            PoolTask * task = NULL;
+            for (std::size_t i = 0; i < threadCount && task == NULL; ++i) {
+                Queue & queue = queues[(worker + i) % threadCount];
+                pthread_mutex_lock(&queue.mutex);
+                if (!queue.tasks.empty()) {
+                    if (i == 0) {
+                        task = queue.tasks.back();
+                        queue.tasks.pop_back();
+                    } else {
+                        task = queue.tasks.front();
+                        queue.tasks.pop_front();
+                    }
+                }
+                pthread_mutex_unlock(&queue.mutex);
+            }
+            if (task != NULL) {
+                __atomic_sub_fetch(&queued, 1, __ATOMIC_SEQ_CST);
+            }
+            return task;
+        }
+
+        /**
+         * Runs and deletes the given task, then tells its group, recording the exception the
+         * task has thrown in the group.
+         *
+         * @param worker The index of the running thread.
+         * @param task The task to be run.
+         */
+        void execute(std::size_t worker, PoolTask * task) {
+            PoolGroup * group = task->group;
+            try {
+                task->run(*this, worker);
+            } catch (const std::exception & exception) {
+                group->fail(&exception);
+            } catch (...) {
+                group->fail(NULL);
+            }
+            delete task;
+            group->done();
+        }
+
+    private:
+        /**
+         * @brief The deque of tasks of one thread.
+         */
+        struct Queue {
+            pthread_mutex_t       mutex;
+            ft::deque<PoolTask *> tasks;
+
+            Queue()  { pthread_mutex_init(&mutex, NULL); }
+           ~Queue()  { pthread_mutex_destroy(&mutex);    }
+        };
+
+        /**
+         * @brief The argument of a started thread.
+         */
+        struct WorkerStart {
+            thread_pool * pool;
+            std::size_t   index;
+        };
+
+        /**
+         * The count of threads, including the one calling run.
+         */
+        std::size_t     threadCount;
+        /**
+         * The deques of the threads.
+         */
+        Queue *         queues;
+        /**
+         * The arguments of the started threads.
+         */
+        WorkerStart *   starts;
+        /**
+         * The started threads, the first entry is unused.
+         */
+        pthread_t *     workers;
+        /**
+         * The count of threads started, including the one calling run.
+         */
+        std::size_t     started;
+        /**
+         * The count of tasks in all deques.
+         */
+        std::size_t     queued;
+        /**
+         * The count of sleeping threads.
+         */
+        std::size_t     sleeping;
+        /**
+         * Whether the threads should stop.
+         */
+        bool            stopping;
+        /**
+         * Serializes the calls of run.
+         */
+        pthread_mutex_t entry;
+        /**
+         * Protects the sleeping threads from missing a wake up.
+         */
+        pthread_mutex_t sleepMutex;
+        /**
+         * Signaled when a task is pushed or the pool is destroyed.
+         */
+        pthread_cond_t  wakeUp;
+
+        thread_pool(const thread_pool &);
+        thread_pool & operator=(const thread_pool &);
+
+        static void * workerMain(void * argument) {
+            WorkerStart * start = static_cast<WorkerStart *>(argument);
+            start->pool->work(start->index);
+            return NULL;
+        }
+
+        /**
+         * Runs tasks until the pool is destroyed. A thread finding no task yields a few times
+         * before it goes to sleep.
+         *
+         * @param worker The index of the thread.
+         */
+        void work(std::size_t worker) {
+            for (unsigned int idle = 0;;) {
+                PoolTask * task = take(worker);
+                if (task != NULL) {
+                    execute(worker, task);
+                    idle = 0;
+                } else if (++idle < 64) {
+                    sched_yield();
+                } else {
+                    pthread_mutex_lock(&sleepMutex);
+                    __atomic_add_fetch(&sleeping, 1, __ATOMIC_SEQ_CST);
+                    while (__atomic_load_n(&queued, __ATOMIC_SEQ_CST) == 0 && !__atomic_load_n(&stopping, __ATOMIC_SEQ_CST)) {
+                        pthread_cond_wait(&wakeUp, &sleepMutex);
+                    }
+                    __atomic_sub_fetch(&sleeping, 1, __ATOMIC_SEQ_CST);
+                    pthread_mutex_unlock(&sleepMutex);
+                    if (__atomic_load_n(&stopping, __ATOMIC_SEQ_CST)) return;
+                    idle = 0;
+                }
+            }
+        }
+
+        /**
+         * Stops and joins the started threads and releases the memory.
+         */
+        void shutdown() {
+            pthread_mutex_lock(&sleepMutex);
+            __atomic_store_n(&stopping, true, __ATOMIC_SEQ_CST);
+            pthread_cond_broadcast(&wakeUp);
+            pthread_mutex_unlock(&sleepMutex);
+            for (std::size_t i = 1; i < started; ++i) {
+                pthread_join(workers[i], NULL);
+            }
+            delete[] workers;
+            delete[] starts;
+            delete[] queues;
+            pthread_cond_destroy(&wakeUp);
+            pthread_mutex_destroy(&sleepMutex);
+            pthread_mutex_destroy(&entry);
+        }
+    };
+
+    void PoolGroup::spawn(thread_pool & pool, std::size_t worker, PoolTask * task) {
+        task->group = this;
+        __atomic_add_fetch(&pending, 1, __ATOMIC_RELAXED);
+        try {
+            pool.push(worker, task);
+        } catch (...) {
+            delete task;
+            done();
+            throw;
+        }
+    }
+
+    void PoolGroup::wait(thread_pool & pool, std::size_t worker) {
+        while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) != 0) {
+            PoolTask * task = pool.take(worker);
+            if (task != NULL) {
+                pool.execute(worker, task);
+            } else {
+                sched_yield();
+            }
+        }
+        if (__atomic_load_n(&failed, __ATOMIC_RELAXED)) {
+            if (badAlloc) throw std::bad_alloc();
+            throw std::runtime_error(message);
+        }
+    }
+
+    /**
+     * The algorithms of this namespace split their range into chunks run by the threads of a
+     * thread pool, either the given one or a pool of one thread per processor shared by the
+     * whole program. Ranges shorter than the serial threshold, or pools of one thread, are
+     * processed by the calling thread alone.
+     *
+     * The iterators have to be random access iterators; for_each, reduce, transform_reduce and
+     * count_if also take a map or a set, whose tree is cut into subtrees. The functions passed
+     * in are called concurrently; the operations of the reductions and of inclusive_scan have
+     * to be associative. If a function or a copy of an element throws, the exception is thrown
+     * again once all chunks are done, as described for thread_pool::run, and the output of
+     * the algorithm is left partially written.
+     */
+    namespace parallel {
+        /**
+         * The least count of elements processed by one chunk.
+         */
+        const std::size_t minimum_grain = 4096;
+
+        /**
+         * The count of elements below which the algorithms run serially.
+         */
+        const std::size_t serial_threshold = 4 * minimum_grain;
+
+        /**
+         * Returns the pool used by the algorithms called without one, created on first use.
+         *
+         * @return The shared thread pool.
+         */
+        inline thread_pool & default_pool() {
+            static thread_pool pool;
+            return pool;
+        }
+
+        /**
+         * Returns the count of elements per chunk for the given count of elements: about eight
+         * chunks per thread, so that stealing can even out chunks of unequal cost.
+         *
+         * @param count The count of elements.
+         * @param pool The pool running the chunks.
+         * @return The grain size.
+         */
+        inline std::size_t grainFor(std::size_t count, const thread_pool & pool) {
+            const std::size_t grain = count / (pool.size() * 8);
+            return grain < minimum_grain ? minimum_grain : grain;
+        }
+
+        /**
+         * Returns whether a range of the given length is processed by the calling thread alone.
+         */
+        inline bool runsSerially(std::size_t count, const thread_pool & pool) {
+            return count < serial_threshold || pool.size() == 1;
+        }
+
+        /**
+         * @brief A task calling its body for a range of indices, halving the range and spawning
+         * the upper half as long as it is longer than the grain.
+         *
+         * @tparam Body The type of the body, called with the beginning and the end of a range.
+         */
+        template<class Body>
+        class RangeTask: public PoolTask {
+        public:
+            RangeTask(Body & body, std::size_t begin, std::size_t end, std::size_t grain)
+                : body(body), begin(begin), end(end), grain(grain) {}
+
+            void run(thread_pool & pool, std::size_t worker) {
+                while (end - begin > grain) {
+                    const std::size_t middle = begin + (end - begin) / 2;
+                    group->spawn(pool, worker, new RangeTask(body, middle, end, grain));
+                    end = middle;
+                }
+                body(begin, end);
+            }
+
+        private:
+            Body &      body;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t grain;
+        };
+
+        /**
+         * Calls the given body for chunks of at most the given grain covering the given count
+         * of indices, on the threads of the given pool.
+         *
+         * @param pool The pool.
+         * @param count The count of indices.
+         * @param grain The maximum length of a chunk.
+         * @param body The body, called with the beginning and the end of every chunk.
+         */
+        template<class Body>
+        void forRange(thread_pool & pool, std::size_t count, std::size_t grain, Body & body) {
+            if (count == 0) return;
+            pool.run(new RangeTask<Body>(body, 0, count, grain));
+        }
+
+        template<class RandomIt, class UnaryFunction>
+        struct ForEachBody {
+            RandomIt      first;
+            UnaryFunction f;
+
+            ForEachBody(RandomIt first, UnaryFunction f): first(first), f(f) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                UnaryFunction local(f);
+                for (RandomIt it = first + begin, last = first + end; it != last; ++it) {
+                    local(*it);
+                }
+            }
+        };
+
+        /**
+         * Calls the given function for every element of the given range. Every chunk uses
+         * a copy of the function.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param f The function to be called.
+         */
+        template<class RandomIt, class UnaryFunction>
+        void for_each(thread_pool & pool, RandomIt first, RandomIt last, UnaryFunction f) {
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            if (runsSerially(count, pool)) {
+                for (; first != last; ++first) f(*first);
+                return;
+            }
+            ForEachBody<RandomIt, UnaryFunction> body(first, f);
+            forRange(pool, count, grainFor(count, pool), body);
+        }
+
+        template<class RandomIt, class UnaryFunction>
+        void for_each(RandomIt first, RandomIt last, UnaryFunction f) {
+            parallel::for_each(default_pool(), first, last, f);
+        }
+
+        template<class RandomIt, class OutputIt, class UnaryOperation>
+        struct TransformBody {
+            RandomIt       first;
+            OutputIt       out;
+            UnaryOperation op;
+
+            TransformBody(RandomIt first, OutputIt out, UnaryOperation op): first(first), out(out), op(op) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                OutputIt target = out + begin;
+                for (RandomIt it = first + begin, last = first + end; it != last; ++it, ++target) {
+                    *target = op(*it);
+                }
+            }
+        };
+
+        /**
+         * Stores the result of the given operation for every element of the given range in
+         * the given output, which may be the range itself.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param out The beginning of the output, a random access iterator.
+         * @param op The operation.
+         * @return The end of the output.
+         */
+        template<class RandomIt, class OutputIt, class UnaryOperation>
+        OutputIt transform(thread_pool & pool, RandomIt first, RandomIt last, OutputIt out, UnaryOperation op) {
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            if (runsSerially(count, pool)) {
+                for (; first != last; ++first, ++out) *out = op(*first);
+                return out;
+            }
+            TransformBody<RandomIt, OutputIt, UnaryOperation> body(first, out, op);
+            forRange(pool, count, grainFor(count, pool), body);
+            return out + count;
+        }
+
+        template<class RandomIt, class OutputIt, class UnaryOperation>
+        OutputIt transform(RandomIt first, RandomIt last, OutputIt out, UnaryOperation op) {
+            return parallel::transform(default_pool(), first, last, out, op);
+        }
+
+        /**
+         * Combines the elements of the given chunk of the given range using the given operation.
+         */
+        template<class T, class RandomIt, class BinaryOperation>
+        T reduceChunk(RandomIt first, std::size_t begin, std::size_t end, BinaryOperation op) {
+            RandomIt it  = first + begin;
+            T        sum = *it;
+            for (RandomIt last = first + end; ++it != last;) {
+                sum = op(sum, *it);
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Reduces fixed chunks of a range, chunk i storing its result at index i.
+         */
+        template<class T, class RandomIt, class BinaryOperation>
+        struct ReduceBody {
+            RandomIt          first;
+            std::size_t       count;
+            std::size_t       chunk;
+            BinaryOperation   op;
+            ft::vector<T> &   sums;
+
+            ReduceBody(RandomIt first, std::size_t count, std::size_t chunk, BinaryOperation op, ft::vector<T> & sums)
+                : first(first), count(count), chunk(chunk), op(op), sums(sums) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    sums[i] = reduceChunk<T>(first, i * chunk, i * chunk + chunk < count ? i * chunk + chunk : count, op);
+                }
+            }
+        };
+
+        /**
+         * Combines the given value and all elements of the given range using the given
+         * operation. The chunks are reduced in parallel, their results are combined in order,
+         * so the operation has to be associative but not commutative.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param init The initial value.
+         * @param op The operation.
+         * @return The combined value.
+         */
+        template<class RandomIt, class T, class BinaryOperation>
+        T reduce(thread_pool & pool, RandomIt first, RandomIt last, T init, BinaryOperation op) {
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            if (count == 0) return init;
+            if (runsSerially(count, pool)) {
+                return op(init, reduceChunk<T>(first, 0, count, op));
+            }
+            const std::size_t chunk  = grainFor(count, pool);
+            const std::size_t chunks = (count + chunk - 1) / chunk;
+            ft::vector<T> sums(chunks, init);
+            ReduceBody<T, RandomIt, BinaryOperation> body(first, count, chunk, op, sums);
+            forRange(pool, chunks, 1, body);
+            for (std::size_t i = 0; i < chunks; ++i) {
+                init = op(init, sums[i]);
+            }
+            return init;
+        }
+
+        template<class RandomIt, class T, class BinaryOperation>
+        T reduce(RandomIt first, RandomIt last, T init, BinaryOperation op) {
+            return parallel::reduce(default_pool(), first, last, init, op);
+        }
+
+        template<class RandomIt, class T>
+        T reduce(RandomIt first, RandomIt last, T init) {
+            return parallel::reduce(default_pool(), first, last, init, ft::plus<T>());
+        }
+
+        /**
+         * Stores the inclusive prefix combination of the given chunk into the output, starting
+         * from the given value if there is one.
+         */
+        template<class T, class RandomIt, class OutputIt, class BinaryOperation>
+        void scanChunk(RandomIt first, OutputIt out, std::size_t begin, std::size_t end, const T * carry, BinaryOperation op) {
+            RandomIt it  = first + begin;
+            T        sum = carry == NULL ? T(*it) : op(*carry, *it);
+            OutputIt target = out + begin;
+            *target = sum;
+            for (RandomIt last = first + end; ++it != last;) {
+                sum       = op(sum, *it);
+                *++target = sum;
+            }
+        }
+
+        /**
+         * @brief Scans fixed chunks of a range, starting from the combination of all chunks
+         * before them.
+         */
+        template<class T, class RandomIt, class OutputIt, class BinaryOperation>
+        struct ScanBody {
+            RandomIt              first;
+            OutputIt              out;
+            std::size_t           count;
+            std::size_t           chunk;
+            BinaryOperation       op;
+            const ft::vector<T> & carries;
+
+            ScanBody(RandomIt first, OutputIt out, std::size_t count, std::size_t chunk, BinaryOperation op, const ft::vector<T> & carries)
+                : first(first), out(out), count(count), chunk(chunk), op(op), carries(carries) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    scanChunk(first, out, i * chunk, i * chunk + chunk < count ? i * chunk + chunk : count,
+                              i == 0 ? static_cast<const T *>(NULL) : &carries[i - 1], op);
+                }
+            }
+        };
+
+        /**
+         * Stores the combination of every element with all elements before it into the given
+         * output, which may be the range itself. The chunks are reduced in parallel first, the
+         * combinations of the chunks before every chunk are computed serially, then every chunk
+         * is scanned in parallel starting from its carry.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param out The beginning of the output, a random access iterator.
+         * @param op The operation.
+         * @return The end of the output.
+         */
+        template<class RandomIt, class OutputIt, class BinaryOperation>
+        OutputIt inclusive_scan(thread_pool & pool, RandomIt first, RandomIt last, OutputIt out, BinaryOperation op) {
+            typedef typename ft::iterator_traits<RandomIt>::value_type valueType;
+
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            if (count == 0) return out;
+            if (runsSerially(count, pool)) {
+                scanChunk<valueType>(first, out, 0, count, NULL, op);
+                return out + count;
+            }
+            const std::size_t chunk  = grainFor(count, pool);
+            const std::size_t chunks = (count + chunk - 1) / chunk;
+            ft::vector<valueType> sums(chunks, *first);
+            ReduceBody<valueType, RandomIt, BinaryOperation> reduceBody(first, count, chunk, op, sums);
+            forRange(pool, chunks, 1, reduceBody);
+            for (std::size_t i = 1; i < chunks; ++i) {
+                sums[i] = op(sums[i - 1], sums[i]);
+            }
+            ScanBody<valueType, RandomIt, OutputIt, BinaryOperation> scanBody(first, out, count, chunk, op, sums);
+            forRange(pool, chunks, 1, scanBody);
+            return out + count;
+        }
+
+        template<class RandomIt, class OutputIt, class BinaryOperation>
+        OutputIt inclusive_scan(RandomIt first, RandomIt last, OutputIt out, BinaryOperation op) {
+            return parallel::inclusive_scan(default_pool(), first, last, out, op);
+        }
+
+        template<class RandomIt, class OutputIt>
+        OutputIt inclusive_scan(RandomIt first, RandomIt last, OutputIt out) {
+            return parallel::inclusive_scan(default_pool(), first, last, out,
+                                            ft::plus<typename ft::iterator_traits<RandomIt>::value_type>());
+        }
+
+        /**
+         * The algorithms sorting the runs of a parallel sort: ft::sort without the compare
+         * object, so that integers are sorted by their radix, ft::sort with the compare
+         * object, or ft::stable_sort.
+         */
+        enum RunSort { sortAscending, sortCompared, sortStable };
+
+        /**
+         * Sorts one run using the given algorithm.
+         */
+        template<class RandomIt, class Compare>
+        void sortRun(RandomIt first, RandomIt last, Compare comp, RunSort algorithm) {
+            switch (algorithm) {
+                case sortAscending: ft::sort(first, last);              break;
+                case sortCompared:  ft::sort(first, last, comp);        break;
+                case sortStable:    ft::stable_sort(first, last, comp); break;
+            }
+        }
+
+        /**
+         * @brief Sorts fixed runs of a range.
+         */
+        template<class RandomIt, class Compare>
+        struct SortRunsBody {
+            RandomIt    first;
+            std::size_t count;
+            std::size_t runs;
+            Compare     comp;
+            RunSort     algorithm;
+
+            SortRunsBody(RandomIt first, std::size_t count, std::size_t runs, Compare comp, RunSort algorithm)
+                : first(first), count(count), runs(runs), comp(comp), algorithm(algorithm) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    sortRun(first + count * i / runs, first + count * (i + 1) / runs, comp, algorithm);
+                }
+            }
+        };
+
+        /**
+         * @brief A task merging two sorted ranges into an output. Long merges are split at the
+         * middle of the longer range and the matching bound of the shorter one, the upper half
+         * being spawned.
+         */
+        template<class InputIt, class OutputIt, class Compare>
+        class MergeTask: public PoolTask {
+        public:
+            MergeTask(InputIt first1, InputIt last1, InputIt first2, InputIt last2, OutputIt out, std::size_t grain, Compare comp)
+                : first1(first1), last1(last1), first2(first2), last2(last2), out(out), grain(grain), comp(comp) {}
+
+            void run(thread_pool & pool, std::size_t worker) {
+                while (static_cast<std::size_t>((last1 - first1) + (last2 - first2)) > grain) {
+                    InputIt middle1, middle2;
+                    if (last1 - first1 >= last2 - first2) {
+                        middle1 = first1 + (last1 - first1) / 2;
+                        middle2 = ft::lower_bound(first2, last2, *middle1, comp);
+                    } else {
+                        middle2 = first2 + (last2 - first2) / 2;
+                        middle1 = ft::upper_bound(first1, last1, *middle2, comp);
+                    }
+                    OutputIt middleOut = out + (middle1 - first1) + (middle2 - first2);
+                    group->spawn(pool, worker, new MergeTask(middle1, last1, middle2, last2, middleOut, grain, comp));
+                    last1 = middle1;
+                    last2 = middle2;
+                }
+                ft::mergeInto(first1, last1, first2, last2, out, comp);
+            }
+
+        private:
+            InputIt     first1, last1, first2, last2;
+            OutputIt    out;
+            std::size_t grain;
+            Compare     comp;
+        };
+
+        /**
+         * @brief A task spawning the merges of all pairs of neighbouring runs of one round.
+         */
+        template<class InputIt, class OutputIt, class Compare>
+        class MergeRoundTask: public PoolTask {
+        public:
+            MergeRoundTask(InputIt source, OutputIt target, std::size_t count, std::size_t runs, std::size_t width, std::size_t grain, Compare comp)
+                : source(source), target(target), count(count), runs(runs), width(width), grain(grain), comp(comp) {}
+
+            void run(thread_pool & pool, std::size_t worker) {
+                for (std::size_t i = 0; i < runs; i += 2 * width) {
+                    const std::size_t begin  = count * i / runs;
+                    const std::size_t middle = count * (i + width) / runs;
+                    const std::size_t end    = count * (i + 2 * width) / runs;
+                    group->spawn(pool, worker, new MergeTask<InputIt, OutputIt, Compare>(source + begin, source + middle,
+                                                                                         source + middle, source + end,
+                                                                                         target + begin, grain, comp));
+                }
+            }
+
+        private:
+            InputIt     source;
+            OutputIt    target;
+            std::size_t count, runs, width, grain;
+            Compare     comp;
+        };
+
+        /**
+         * @brief Constructs or copies back fixed chunks between a range and a buffer, marking
+         * the chunks constructed.
+         */
+        template<class RandomIt, class T>
+        struct BufferBody {
+            RandomIt           first;
+            T *                buffer;
+            std::size_t        count;
+            std::size_t        chunk;
+            ft::vector<char> * constructed;
+
+            BufferBody(RandomIt first, T * buffer, std::size_t count, std::size_t chunk, ft::vector<char> * constructed)
+                : first(first), buffer(buffer), count(count), chunk(chunk), constructed(constructed) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    const std::size_t from = i * chunk,
+                                      to   = from + chunk < count ? from + chunk : count;
+                    if (constructed != NULL) {
+                        std::uninitialized_copy(first + from, first + to, buffer + from);
+                        (*constructed)[i] = true;
+                    } else {
+                        std::copy(buffer + from, buffer + to, first + from);
+                    }
+                }
+            }
+        };
+
+        /**
+         * Destroys the constructed chunks of the given buffer and deallocates it.
+         */
+        template<class T>
+        void releaseBuffer(T * buffer, std::size_t count, std::size_t chunk, const ft::vector<char> & constructed) {
+            std::allocator<T> alloc;
+            for (std::size_t i = 0; i < constructed.size(); ++i) {
+                if (!constructed[i]) continue;
+                for (std::size_t j = i * chunk; j < count && j < i * chunk + chunk; ++j) {
+                    alloc.destroy(buffer + j);
+                }
+            }
+            alloc.deallocate(buffer, count);
+        }
+
+        /**
+         * Sorts the runs in parallel, then merges them pairwise, back and forth between the
+         * range and a buffer, every merge itself being split among the threads.
+         */
+        template<class RandomIt, class Compare>
+        void sortRuns(thread_pool & pool, RandomIt first, RandomIt last, Compare comp, RunSort algorithm) {
+            typedef typename ft::iterator_traits<RandomIt>::value_type valueType;
+
+            const std::size_t count = static_cast<std::size_t>(last - first);
+            if (runsSerially(count, pool)) {
+                sortRun(first, last, comp, algorithm);
+                return;
+            }
+            const std::size_t grain = grainFor(count, pool);
+            std::size_t       runs  = 1;
+            while (runs < pool.size() * 4 && count / (runs * 2) >= minimum_grain) runs *= 2;
+
+            SortRunsBody<RandomIt, Compare> sortBody(first, count, runs, comp, algorithm);
+            forRange(pool, runs, 1, sortBody);
+            if (runs == 1) return;
+
+            const std::size_t chunks = (count + grain - 1) / grain;
+            ft::vector<char>  constructed(chunks, false);
+            valueType *       buffer = std::allocator<valueType>().allocate(count);
+            try {
+                BufferBody<RandomIt, valueType> construct(first, buffer, count, grain, &constructed);
+                forRange(pool, chunks, 1, construct);
+                bool inBuffer = false;
+                for (std::size_t width = 1; width < runs; width *= 2, inBuffer = !inBuffer) {
+                    if (inBuffer) {
+                        pool.run(new MergeRoundTask<valueType *, RandomIt, Compare>(buffer, first, count, runs, width, grain, comp));
+                    } else {
+                        pool.run(new MergeRoundTask<RandomIt, valueType *, Compare>(first, buffer, count, runs, width, grain, comp));
+                    }
+                }
+                if (inBuffer) {
+                    BufferBody<RandomIt, valueType> copyBack(first, buffer, count, grain, NULL);
+                    forRange(pool, chunks, 1, copyBack);
+                }
+            } catch (...) {
+                releaseBuffer(buffer, count, grain, constructed);
+                throw;
+            }
+            releaseBuffer(buffer, count, grain, constructed);
+        }
+
+        /**
+         * Sorts the given range using the given compare object. The range is cut into a few
+         * runs per thread, which are sorted by ft::sort concurrently and then merged.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param comp The compare object.
+         */
+        template<class RandomIt, class Compare>
+        void sort(thread_pool & pool, RandomIt first, RandomIt last, Compare comp) {
+            sortRuns(pool, first, last, comp, sortCompared);
+        }
+
+        /**
+         * Sorts the given range using ft::less, the elements of the same type being sorted in
+         * ascending order without the compare object, so that integers are sorted by their radix.
+         */
+        template<class RandomIt, class T>
+        void sort(thread_pool & pool, RandomIt first, RandomIt last, ft::less<T> comp) {
+            sortRuns(pool, first, last, comp, is_same<T, typename ft::iterator_traits<RandomIt>::value_type>::value ? sortAscending : sortCompared);
+        }
+
+        /**
+         * Sorts the given range in ascending order, see the overload taking ft::less.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        template<class RandomIt>
+        void sort(thread_pool & pool, RandomIt first, RandomIt last) {
+            sortRuns(pool, first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>(), sortAscending);
+        }
+
+        template<class RandomIt, class Compare>
+        void sort(RandomIt first, RandomIt last, Compare comp) {
+            parallel::sort(default_pool(), first, last, comp);
+        }
+
+        template<class RandomIt>
+        void sort(RandomIt first, RandomIt last) {
+            parallel::sort(default_pool(), first, last);
+        }
+
+        /**
+         * Sorts the given range using the given compare object, keeping equivalent elements in
+         * their order. The runs are sorted by ft::stable_sort, the merges take the element of
+         * the earlier run of two equivalent ones.
+         *
+         * @param pool The pool to run on.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param comp The compare object.
+         */
+        template<class RandomIt, class Compare>
+        void stable_sort(thread_pool & pool, RandomIt first, RandomIt last, Compare comp) {
+            sortRuns(pool, first, last, comp, sortStable);
+        }
+
+        template<class RandomIt>
+        void stable_sort(thread_pool & pool, RandomIt first, RandomIt last) {
+            sortRuns(pool, first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>(), sortStable);
+        }
+
+        template<class RandomIt, class Compare>
+        void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+            parallel::stable_sort(default_pool(), first, last, comp);
+        }
+
+        template<class RandomIt>
+        void stable_sort(RandomIt first, RandomIt last) {
+            parallel::stable_sort(default_pool(), first, last);
+        }
+
+        /**
+         * The range type of the given container, the const one for const containers.
+         */
+        template<class Container>
+        struct RangeOf {
+            typedef typename Container::range_type type;
+        };
+
+        template<class Container>
+        struct RangeOf<const Container> {
+            typedef typename Container::const_range_type type;
+        };
+
+        /**
+         * Returns the depth the tree of a map or a set is split at for the given pool, so that
+         * every thread gets about eight subtrees.
+         */
+        inline std::size_t splitDepth(const thread_pool & pool) {
+            std::size_t depth = 0;
+            while ((std::size_t(1) << depth) < pool.size() * 8) ++depth;
+            return depth;
+        }
+
+        /**
+         * Cuts the given map or set into the ranges handed to the threads, a single range
+         * covering the whole tree if it is processed serially.
+         */
+        template<class Container>
+        void splitRanges(thread_pool & pool, Container & c, ft::vector<typename RangeOf<Container>::type> & ranges) {
+            const std::size_t depth = runsSerially(c.size(), pool) ? 0 : splitDepth(pool);
+            ranges.resize((std::size_t(2) << depth) - 1);
+            ranges.erase(c.split(depth, ranges.begin()), ranges.end());
+        }
+
+        template<class Range, class UnaryFunction>
+        struct VisitBody {
+            const ft::vector<Range> & ranges;
+            UnaryFunction             f;
+
+            VisitBody(const ft::vector<Range> & ranges, UnaryFunction f): ranges(ranges), f(f) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                UnaryFunction local(f);
+                for (std::size_t i = begin; i < end; ++i) {
+                    ranges[i].visit(local);
+                }
+            }
+        };
+
+        /**
+         * Calls the given function for every element of the given map or set. The tree is cut
+         * into subtrees, which are visited concurrently, each thread recursing down its own
+         * subtrees instead of chasing parent pointers.
+         *
+         * @param pool The pool to run on.
+         * @param c The map or the set, the elements can be modified through a non-const map.
+         * @param f The function to be called, every subtree uses a copy of it.
+         */
+        template<class Container, class UnaryFunction>
+        void for_each(thread_pool & pool, Container & c, UnaryFunction f) {
+            typedef typename RangeOf<Container>::type range;
+
+            ft::vector<range> ranges;
+            splitRanges(pool, c, ranges);
+            VisitBody<range, UnaryFunction> body(ranges, f);
+            if (ranges.size() < 2) {
+                body(0, ranges.size());
+            } else {
+                forRange(pool, ranges.size(), 1, body);
+            }
+        }
+
+        template<class Container, class UnaryFunction>
+        void for_each(Container & c, UnaryFunction f) {
+            parallel::for_each(default_pool(), c, f);
+        }
+
+        /**
+         * @brief Combines the transformed elements it is called with.
+         */
+        template<class T, class BinaryOperation, class UnaryOperation>
+        struct Accumulator {
+            T               value;
+            bool            empty;
+            BinaryOperation reduce;
+            UnaryOperation  transform;
+
+            Accumulator(const T & init, BinaryOperation reduce, UnaryOperation transform)
+                : value(init), empty(true), reduce(reduce), transform(transform) {}
+
+            template<class Value>
+            void operator()(const Value & element) {
+                if (empty) {
+                    value = transform(element);
+                    empty = false;
+                } else {
+                    value = reduce(value, transform(element));
+                }
+            }
+        };
+
+        template<class Range, class T, class BinaryOperation, class UnaryOperation>
+        struct TransformReduceBody {
+            const ft::vector<Range> & ranges;
+            ft::vector<T> &           sums;
+            BinaryOperation           reduce;
+            UnaryOperation            transform;
+
+            TransformReduceBody(const ft::vector<Range> & ranges, ft::vector<T> & sums, BinaryOperation reduce, UnaryOperation transform)
+                : ranges(ranges), sums(sums), reduce(reduce), transform(transform) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    Accumulator<T, BinaryOperation, UnaryOperation> sum(sums[i], reduce, transform);
+                    ranges[i].visit(sum);
+                    sums[i] = sum.value;
+                }
+            }
+        };
+
+        /**
+         * Combines the given value and the transformed elements of the given map or set. Every
+         * subtree is reduced by one thread, the results are combined in order, so the reduce
+         * operation has to be associative but not commutative.
+         *
+         * @param pool The pool to run on.
+         * @param c The map or the set.
+         * @param init The initial value.
+         * @param reduce The operation combining two values.
+         * @param transform The operation turning an element into a value.
+         * @return The combined value.
+         */
+        template<class Container, class T, class BinaryOperation, class UnaryOperation>
+        T transform_reduce(thread_pool & pool, Container & c, T init, BinaryOperation reduce, UnaryOperation transform) {
+            typedef typename RangeOf<Container>::type range;
+
+            ft::vector<range> ranges;
+            splitRanges(pool, c, ranges);
+            ft::vector<T> sums(ranges.size(), init);
+            TransformReduceBody<range, T, BinaryOperation, UnaryOperation> body(ranges, sums, reduce, transform);
+            if (ranges.size() < 2) {
+                body(0, ranges.size());
+            } else {
+                forRange(pool, ranges.size(), 1, body);
+            }
+            for (std::size_t i = 0; i < sums.size(); ++i) {
+                init = reduce(init, sums[i]);
+            }
+            return init;
+        }
+
+        template<class Container, class T, class BinaryOperation, class UnaryOperation>
+        T transform_reduce(Container & c, T init, BinaryOperation reduce, UnaryOperation transform) {
+            return parallel::transform_reduce(default_pool(), c, init, reduce, transform);
+        }
+
+        /**
+         * @brief Returns the element it is called with.
+         */
+        struct Identity {
+            template<class Value>
+            const Value & operator()(const Value & value) const { return value; }
+        };
+
+        /**
+         * Combines the given value and the elements of the given map or set, see transform_reduce.
+         *
+         * @param pool The pool to run on.
+         * @param c The map or the set.
+         * @param init The initial value, of a type the elements convert to.
+         * @param op The associative operation.
+         * @return The combined value.
+         */
+        template<class Container, class T, class BinaryOperation>
+        T reduce(thread_pool & pool, Container & c, T init, BinaryOperation op) {
+            return parallel::transform_reduce(pool, c, init, op, Identity());
+        }
+
+        template<class Container, class T, class BinaryOperation>
+        T reduce(Container & c, T init, BinaryOperation op) {
+            return parallel::transform_reduce(default_pool(), c, init, op, Identity());
+        }
+
+        /**
+         * @brief Turns an element into one if the predicate holds for it, into zero otherwise.
+         */
+        template<class UnaryPredicate>
+        struct CountOne {
+            UnaryPredicate p;
+
+            explicit CountOne(UnaryPredicate p): p(p) {}
+
+            template<class Value>
+            std::size_t operator()(const Value & value) { return p(value) ? 1 : 0; }
+        };
+
+        /**
+         * Counts the elements of the given map or set for which the given predicate holds.
+         *
+         * @param pool The pool to run on.
+         * @param c The map or the set.
+         * @param p The predicate.
+         * @return The count of matching elements.
+         */
+        template<class Container, class UnaryPredicate>
+        std::size_t count_if(thread_pool & pool, Container & c, UnaryPredicate p) {
+            return parallel::transform_reduce(pool, c, std::size_t(0), ft::plus<std::size_t>(), CountOne<UnaryPredicate>(p));
+        }
+
+        template<class Container, class UnaryPredicate>
+        std::size_t count_if(Container & c, UnaryPredicate p) {
+            return parallel::count_if(default_pool(), c, p);
+        }
+
+        /**
+         * @brief Runs the subtree builds of a bulk load on the threads of a pool.
+         */
+        class PoolExecutor {
+        public:
+            PoolExecutor(thread_pool & pool, std::size_t splitDepth): pool(pool), splitDepth(splitDepth) {}
+
+            std::size_t depth() const { return splitDepth; }
+
+            template<class Body>
+            void operator()(std::size_t count, Body & body) {
+                if (count < 2) {
+                    body(0, count);
+                } else {
+                    forRange(pool, count, 1, body);
+                }
+            }
+
+        private:
+            thread_pool & pool;
+            std::size_t   splitDepth;
+        };
+
+        /**
+         * @brief The type the elements of a set are sorted as before a bulk load, and the
+         * compare object ordering them by their keys.
+         */
+        template<class Container>
+        struct BulkTraits {
+            typedef typename Container::value_type  storageType;
+            typedef typename Container::key_compare compareType;
+
+            static compareType compare(const Container & c) { return c.key_comp(); }
+        };
+
+        /**
+         * The elements of a map are sorted as pairs with a key that is not const, so that
+         * they can be assigned.
+         */
+        template<class Key, class T, class Compare, class Allocator, class Options>
+        struct BulkTraits<ft::map<Key, T, Compare, Allocator, Options> > {
+            typedef ft::pair<Key, T> storageType;
+
+            struct compareType {
+                Compare comp;
+
+                explicit compareType(Compare comp): comp(comp) {}
+
+                bool operator()(const storageType & lhs, const storageType & rhs) const { return comp(lhs.first, rhs.first); }
+            };
+
+            static compareType compare(const ft::map<Key, T, Compare, Allocator, Options> & m) { return compareType(m.key_comp()); }
+        };
+
+        /**
+         * Returns whether the element at the given index of a sorted range is the first of its
+         * equivalent elements.
+         */
+        template<class RandomIt, class Compare>
+        bool isFirstOfKey(RandomIt first, std::size_t index, Compare & comp) {
+            return index == 0 || comp(first[index - 1], first[index]);
+        }
+
+        /**
+         * @brief Counts the first elements of their keys in fixed chunks of a sorted range.
+         */
+        template<class RandomIt, class Compare>
+        struct CountKeysBody {
+            RandomIt                   first;
+            std::size_t                count;
+            std::size_t                chunk;
+            Compare                    comp;
+            ft::vector<std::size_t> &  keys;
+
+            CountKeysBody(RandomIt first, std::size_t count, std::size_t chunk, Compare comp, ft::vector<std::size_t> & keys)
+                : first(first), count(count), chunk(chunk), comp(comp), keys(keys) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t found = 0;
+                    for (std::size_t j = i * chunk; j < count && j < i * chunk + chunk; ++j) {
+                        found += isFirstOfKey(first, j, comp);
+                    }
+                    keys[i] = found;
+                }
+            }
+        };
+
+        /**
+         * @brief Copies the first elements of their keys of fixed chunks of a sorted range into
+         * uninitialized memory, every chunk starting at the count of keys before it. The count
+         * of copies made by every chunk is kept, for them to be destroyed even if a copy throws.
+         */
+        template<class RandomIt, class T, class Compare>
+        struct CopyKeysBody {
+            RandomIt                        first;
+            std::size_t                     count;
+            std::size_t                     chunk;
+            Compare                         comp;
+            const ft::vector<std::size_t> & offsets;
+            ft::vector<std::size_t> &       copied;
+            T *                             out;
+
+            CopyKeysBody(RandomIt first, std::size_t count, std::size_t chunk, Compare comp,
+                         const ft::vector<std::size_t> & offsets, ft::vector<std::size_t> & copied, T * out)
+                : first(first), count(count), chunk(chunk), comp(comp), offsets(offsets), copied(copied), out(out) {}
+
+            void operator()(std::size_t begin, std::size_t end) {
+                std::allocator<T> alloc;
+                for (std::size_t i = begin; i < end; ++i) {
+                    T * target = out + offsets[i];
+                    for (std::size_t j = i * chunk; j < count && j < i * chunk + chunk; ++j) {
+                        if (isFirstOfKey(first, j, comp)) {
+                            alloc.construct(target++, first[j]);
+                            ++copied[i];
+                        }
+                    }
+                }
+            }
+        };
+
+        /**
+         * Destroys the copies made by the chunks of a CopyKeysBody and deallocates their memory.
+         */
+        template<class T>
+        void releaseKeys(T * keys, std::size_t count, const ft::vector<std::size_t> & offsets, const ft::vector<std::size_t> & copied) {
+            std::allocator<T> alloc;
+            for (std::size_t i = 0; i < offsets.size(); ++i) {
+                for (std::size_t j = 0; j < copied[i]; ++j) {
+                    alloc.destroy(keys + offsets[i] + j);
+                }
+            }
+            alloc.deallocate(keys, count);
+        }
+
+        /**
+         * @brief Tells whether two elements of a sorted range are equivalent.
+         */
+        template<class Compare>
+        struct Equivalent {
+            Compare comp;
+
+            explicit Equivalent(Compare comp): comp(comp) {}
+
+            template<class T>
+            bool operator()(const T & lhs, const T & rhs) const { return !comp(lhs, rhs); }
+        };
+
+        /**
+         * Replaces the contents of the given map or set by the elements of the given unsorted
+         * range, keeping the first of equivalent elements like insert. The elements are copied
+         * and sorted in parallel, the first elements of their keys are gathered in parallel,
+         * then the tree is built bottom up, its subtrees concurrently. If a copy of an element
+         * throws, the container is left empty or unchanged.
+         *
+         * @param pool The pool to run on.
+         * @param c The map or the set to be loaded.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        template<class Container, class InputIt>
+        void bulk_load(thread_pool & pool, Container & c, InputIt first, InputIt last) {
+            typedef BulkTraits<Container>             traits;
+            typedef typename traits::storageType      valueType;
+            typedef typename traits::compareType      compareType;
+            typedef typename ft::vector<valueType>::iterator iterator;
+
+            ft::vector<valueType> values(first, last);
+            const compareType     comp  = traits::compare(c);
+            const std::size_t     count = values.size();
+            parallel::stable_sort(pool, values.begin(), values.end(), comp);
+            if (runsSerially(count, pool)) {
+                c.assign_sorted(values.begin(), ft::unique(values.begin(), values.end(), Equivalent<compareType>(comp)));
+                return;
+            }
+
+            const std::size_t chunk  = grainFor(count, pool);
+            const std::size_t chunks = (count + chunk - 1) / chunk;
+            ft::vector<std::size_t> offsets(chunks, 0);
+            CountKeysBody<iterator, compareType> countKeys(values.begin(), count, chunk, comp, offsets);
+            forRange(pool, chunks, 1, countKeys);
+            std::size_t keys = 0;
+            for (std::size_t i = 0; i < chunks; ++i) {
+                const std::size_t found = offsets[i];
+                offsets[i] = keys;
+                keys += found;
+            }
+
+            PoolExecutor executor(pool, splitDepth(pool));
+            if (keys == count) {
+                c.assign_sorted(values.begin(), values.end(), executor);
+                return;
+            }
+            ft::vector<std::size_t> copied(chunks, 0);
+            valueType *             unique = std::allocator<valueType>().allocate(keys);
+            try {
+                CopyKeysBody<iterator, valueType, compareType> copyKeys(values.begin(), count, chunk, comp, offsets, copied, unique);
+                forRange(pool, chunks, 1, copyKeys);
+                c.assign_sorted(unique, unique + keys, executor);
+            } catch (...) {
+                releaseKeys(unique, keys, offsets, copied);
+                throw;
+            }
+            releaseKeys(unique, keys, offsets, copied);
+        }
+
+        template<class Container, class InputIt>
+        void bulk_load(Container & c, InputIt first, InputIt last) {
+            parallel::bulk_load(default_pool(), c, first, last);
+        }
+    }
+}
+
+#endif //FT_CONTAINERS_PARALLEL_HPP
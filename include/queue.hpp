@@ -0,0 +1,223 @@
+#ifndef FT_CONTAINERS_QUEUE_HPP
+#define FT_CONTAINERS_QUEUE_HPP
+
+#include <cstddef>
+#include "functional.hpp"
+#include "vector.hpp"
+
+namespace ft {
+    /**
+     * @brief A container adapter giving constant time access to its greatest element.
+     *
+     * The elements are kept in a heap in which every node has Arity children. A higher
+     * arity makes the heap flatter, so that a sift-down touches fewer cache lines while
+     * comparing more children per level.
+     *
+     * @tparam T The type of the elements.
+     * @tparam Container The underlying container, has to provide random access iterators.
+     * @tparam Compare The compare object, the greatest element according to it is on top.
+     * @tparam Arity The count of children of every node in the heap, at least two.
+     */
+    template <class T, class Container = ft::vector<T>, class Compare = ft::less<typename Container::value_type>, std::size_t Arity = 2>
+    class priority_queue {
+    public:
+        typedef Container                           container_type;
+        typedef Compare                             value_compare;
+        typedef typename Container::value_type      value_type;
+        typedef typename Container::size_type       size_type;
+        typedef typename Container::reference       reference;
+        typedef typename Container::const_reference const_reference;
+
+        /**
+         * Constructs the queue from the elements of the given container in linear time.
+         *
+         * @param compare The compare object.
+         * @param cont The initial elements.
+         */
+        explicit priority_queue(const Compare & compare = Compare(), const Container & cont = Container())
+            : c(cont), comp(compare) {
+            makeHeap();
+        }
+
+        /**
+         * Constructs the queue from the elements of the given container and the given range in
+         * linear time.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         * @param compare The compare object.
+         * @param cont The initial elements.
+         */
+        template<class InputIt>
+        priority_queue(InputIt first, InputIt last, const Compare & compare = Compare(), const Container & cont = Container())
+            : c(cont), comp(compare) {
+            c.insert(c.end(), first, last);
+            makeHeap();
+        }
+
+        priority_queue(const priority_queue & other): c(other.c), comp(other.comp) {}
+       ~priority_queue() {}
+
+        priority_queue & operator=(const priority_queue & other) {
+            c    = other.c;
+            comp = other.comp;
+            return *this;
+        }
+
+        const_reference top() const {
+            return c.front();
+        }
+
+        bool empty() const {
+            return c.empty();
+        }
+
+        size_type size() const {
+            return c.size();
+        }
+
+        void push(const value_type & value) {
+            c.push_back(value);
+            siftUp(c.size() - 1);
+        }
+
+        /**
+         * Pushes all elements of the given range. If the range is at least as long as the
+         * queue, the whole heap is rebuilt in linear time instead of sifting up every element.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        template<class InputIt>
+        void push_range(InputIt first, InputIt last) {
+            const size_type oldSize = c.size();
+            c.insert(c.end(), first, last);
+            if (c.size() - oldSize >= oldSize) {
+                makeHeap();
+            } else {
+                for (size_type i = oldSize; i < c.size(); ++i) {
+                    siftUp(i);
+                }
+            }
+        }
+
+        void pop() {
+            value_type value = c.back();
+            c.pop_back();
+            if (!c.empty()) {
+                replaceRoot(value);
+            }
+        }
+
+        /**
+         * Replaces the top element by the given value, which is the same as pop followed by
+         * push, but sifts down only once.
+         *
+         * @param value The value replacing the top element.
+         */
+        void replace_top(const value_type & value) {
+            replaceRoot(value);
+        }
+
+        void swap(priority_queue & other) {
+            using std::swap;
+            swap(c,    other.c);
+            swap(comp, other.comp);
+        }
+
+    protected:
+        Container c;
+        Compare   comp;
+
+    private:
+        /**
+         * Fails to compile if the nodes of the heap would not have at least two children.
+         */
+        typedef char arityCheck[Arity >= 2 ? 1 : -1];
+
+        /**
+         * Moves the element at the given index up until its parent is not less than it.
+         *
+         * @param index The index of the element.
+         */
+        void siftUp(size_type index) {
+            if (index == 0) return;
+            value_type value = c[index];
+            while (index > 0) {
+                const size_type parent = (index - 1) / Arity;
+                if (!comp(c[parent], value)) break;
+                c[index] = c[parent];
+                index    = parent;
+            }
+            c[index] = value;
+        }
+
+        /**
+         * Moves the element at the given index down until none of its children is greater.
+         *
+         * @param index The index of the element.
+         */
+        void siftDown(size_type index) {
+            const size_type size = c.size();
+            if (index * Arity + 1 >= size) return;
+            value_type value = c[index];
+            for (size_type child = index * Arity + 1; child < size; child = index * Arity + 1) {
+                const size_type last     = child + Arity < size ? child + Arity : size;
+                size_type       greatest = child;
+                for (++child; child < last; ++child) {
+                    if (comp(c[greatest], c[child])) greatest = child;
+                }
+                if (!comp(value, c[greatest])) break;
+                c[index] = c[greatest];
+                index    = greatest;
+            }
+            c[index] = value;
+        }
+
+        /**
+         * Replaces the root by the given value. The hole left by the root is moved down to a
+         * leaf along the greatest children, then the value is sifted up from there. As values
+         * taken from the bottom mostly belong to the bottom, this needs fewer comparisons than
+         * sifting the value down.
+         *
+         * @param value The new value, copied as it may refer to an element of the heap.
+         */
+        void replaceRoot(value_type value) {
+            const size_type size  = c.size();
+            size_type       index = 0;
+            for (size_type child = 1; child < size; child = index * Arity + 1) {
+                const size_type last     = child + Arity < size ? child + Arity : size;
+                size_type       greatest = child;
+                for (++child; child < last; ++child) {
+                    if (comp(c[greatest], c[child])) greatest = child;
+                }
+                c[index] = c[greatest];
+                index    = greatest;
+            }
+            while (index > 0) {
+                const size_type parent = (index - 1) / Arity;
+                if (!comp(c[parent], value)) break;
+                c[index] = c[parent];
+                index    = parent;
+            }
+            c[index] = value;
+        }
+
+        /**
+         * Turns the container into a heap by sifting down every inner node, bottom up.
+         */
+        void makeHeap() {
+            if (c.size() < 2) return;
+            for (size_type i = (c.size() - 2) / Arity + 1; i > 0; --i) {
+                siftDown(i - 1);
+            }
+        }
+    };
+
+    template <class T, class Container, class Compare, std::size_t Arity>
+    void swap(priority_queue<T, Container, Compare, Arity> & lhs, priority_queue<T, Container, Compare, Arity> & rhs) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_QUEUE_HPP
@@ -0,0 +1,274 @@
+#ifndef FT_CONTAINERS_REGION_ALLOCATOR_HPP
+#define FT_CONTAINERS_REGION_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include "offset_ptr.hpp"
+
+namespace ft {
+    /**
+     * @brief An allocator managing a memory region provided by the caller.
+     *
+     * The bookkeeping is stored at the beginning of the region, as offsets from it, so that
+     * the region can be mapped at different addresses, by several processes for example.
+     * Blocks are bumped off the free space; released blocks of up to maxSmallBlock bytes are
+     * kept in lists per size, bigger ones in a single list searched for the first block big
+     * enough, the rest of which is released again. An object can be registered as the root
+     * of the region, for other processes to find it once they have attached the region.
+     *
+     * The region is not synchronized: while it is being modified, it must not be used by any
+     * other thread or process.
+     */
+    class memory_region {
+    public:
+        /**
+         * The alignment of the region and of every block handed out.
+         */
+        static const std::size_t alignment = 16;
+
+        /**
+         * Creates an empty region in the given memory.
+         *
+         * @param memory The memory, aligned to alignment bytes.
+         * @param size The size of the memory in bytes.
+         * @return The region, located at the beginning of the memory.
+         * @throws std::bad_alloc If the memory is too small or not aligned.
+         */
+        static memory_region * create(void * memory, std::size_t size) {
+            if (size < blockSize(sizeof(memory_region)) || reinterpret_cast<std::size_t>(memory) % alignment != 0) throw std::bad_alloc();
+            return new (memory) memory_region(size);
+        }
+
+        /**
+         * Returns the region created earlier in the given memory.
+         *
+         * @param memory The memory holding the region.
+         * @return The region, or NULL if the memory does not hold a region.
+         */
+        static memory_region * attach(void * memory) {
+            memory_region * region = static_cast<memory_region *>(memory);
+            return region != NULL && std::memcmp(region->magic, "ftregion", sizeof(region->magic)) == 0 ? region : NULL;
+        }
+
+        static const memory_region * attach(const void * memory) {
+            return attach(const_cast<void *>(memory));
+        }
+
+        /**
+         * Returns a block of the given size.
+         *
+         * @param bytes The size of the block.
+         * @return The block.
+         * @throws std::bad_alloc If the region is exhausted.
+         */
+        void * allocate(std::size_t bytes) {
+            const std::size_t size = blockSize(bytes);
+            if (size <= maxSmallBlock && freeLists[size / alignment - 1] != 0) {
+                std::size_t & list = freeLists[size / alignment - 1];
+                const std::size_t block = list;
+                list = *static_cast<std::size_t *>(at(block));
+                return at(block);
+            } else if (size > maxSmallBlock) {
+                for (std::size_t * link = &largeFreeList; *link != 0; link = &static_cast<FreeBlock *>(at(*link))->next) {
+                    FreeBlock * block = static_cast<FreeBlock *>(at(*link));
+                    if (block->size >= size) {
+                        const std::size_t offset = *link;
+                        *link = block->next;
+                        if (block->size > size) deallocate(at(offset + size), block->size - size);
+                        return block;
+                    }
+                }
+            }
+            if (size > capacity - top) throw std::bad_alloc();
+            void * block = at(top);
+            top += size;
+            return block;
+        }
+
+        /**
+         * Gives the given block back, for it to be reused by an allocation of the same size.
+         *
+         * @param memory The block.
+         * @param bytes The size the block has been allocated with.
+         */
+        void deallocate(void * memory, std::size_t bytes) {
+            if (memory == NULL) return;
+            const std::size_t size   = blockSize(bytes);
+            const std::size_t offset = static_cast<char *>(memory) - reinterpret_cast<char *>(this);
+            if (offset + size == top) {
+                top = offset;
+            } else if (size <= maxSmallBlock) {
+                *static_cast<std::size_t *>(memory) = freeLists[size / alignment - 1];
+                freeLists[size / alignment - 1] = offset;
+            } else {
+                FreeBlock * block = static_cast<FreeBlock *>(memory);
+                block->next   = largeFreeList;
+                block->size   = size;
+                largeFreeList = offset;
+            }
+        }
+
+        /**
+         * Registers the given object as the root of this region.
+         *
+         * @param object The object, located in this region, or NULL.
+         */
+        void set_root(void * object) { root = object == NULL ? 0 : static_cast<char *>(object) - reinterpret_cast<char *>(this); }
+
+        /**
+         * Returns the root object of this region.
+         *
+         * @return The object registered by set_root, or NULL.
+         */
+        template<class T>
+        T * get_root() { return root == 0 ? NULL : static_cast<T *>(at(root)); }
+
+        template<class T>
+        const T * get_root() const { return const_cast<memory_region *>(this)->get_root<const T>(); }
+
+        /**
+         * Returns the size of this region in bytes, including its bookkeeping.
+         *
+         * @return The size of the region.
+         */
+        std::size_t size() const { return capacity; }
+
+        /**
+         * Returns the count of bytes never handed out, not counting released blocks.
+         *
+         * @return The untouched bytes.
+         */
+        std::size_t bytes_free() const { return capacity - top; }
+
+    private:
+        /**
+         * The biggest block kept in a list of its size.
+         */
+        static const std::size_t maxSmallBlock = 256;
+
+        /**
+         * @brief A released big block.
+         */
+        struct FreeBlock {
+            std::size_t next;
+            std::size_t size;
+        };
+
+        char        magic[8];
+        std::size_t capacity;
+        /**
+         * The offset of the free space.
+         */
+        std::size_t top;
+        /**
+         * The offset of the root object, zero if there is none.
+         */
+        std::size_t root;
+        /**
+         * The offsets of the first released blocks of every small size, zero if there is none.
+         */
+        std::size_t freeLists[maxSmallBlock / alignment];
+        std::size_t largeFreeList;
+
+        explicit memory_region(std::size_t size): capacity(size), top(blockSize(sizeof(memory_region))), root(0), largeFreeList(0) {
+            std::memcpy(magic, "ftregion", sizeof(magic));
+            std::memset(freeLists, 0, sizeof(freeLists));
+        }
+
+        memory_region(const memory_region &);
+        memory_region & operator=(const memory_region &);
+
+        void * at(std::size_t offset) { return reinterpret_cast<char *>(this) + offset; }
+
+        static std::size_t blockSize(std::size_t bytes) {
+            return bytes == 0 ? alignment : (bytes + alignment - 1) / alignment * alignment;
+        }
+    };
+
+    /**
+     * @brief An allocator taking its memory from a memory_region.
+     *
+     * The allocator refers to its region by an offset_ptr, a container using it can therefore
+     * be placed in the region itself, together with the nodes using ft::offset_pointers, and
+     * be used wherever the region is mapped. Allocators compare equal if they use the same
+     * region.
+     *
+     * @tparam T The type of the allocated objects.
+     */
+    template<class T>
+    class region_allocator {
+        template<class> friend class region_allocator;
+
+    public:
+        typedef T              value_type;
+        typedef T *            pointer;
+        typedef const T *      const_pointer;
+        typedef T &            reference;
+        typedef const T &      const_reference;
+        typedef std::size_t    size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        template<class U>
+        struct rebind {
+            typedef region_allocator<U> other;
+        };
+
+        /**
+         * Constructs an allocator using the given region, which has to outlive all containers
+         * using this allocator.
+         *
+         * @param region The region.
+         */
+        region_allocator(memory_region & region): region(&region) {}
+        region_allocator(const region_allocator & other): region(other.region) {}
+        template<class U>
+        region_allocator(const region_allocator<U> & other): region(other.region) {}
+       ~region_allocator() {}
+
+        region_allocator & operator=(const region_allocator & other) {
+            region = other.region;
+            return *this;
+        }
+
+        pointer       address(reference x)       const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+        void construct(pointer p, const T & value) { new (static_cast<void *>(p)) T(value); }
+        void destroy(pointer p)                    { p->~T();                               }
+
+        pointer allocate(size_type n, const void * = 0) {
+            if (n > max_size()) throw std::bad_alloc();
+            return static_cast<pointer>(region->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type n) {
+            region->deallocate(p, n * sizeof(T));
+        }
+
+        /**
+         * Returns the region this allocator takes its memory from.
+         *
+         * @return The region.
+         */
+        memory_region & get_region() const { return *region; }
+
+    private:
+        offset_ptr<memory_region> region;
+    };
+
+    template<class T, class U>
+    bool operator==(const region_allocator<T> & lhs, const region_allocator<U> & rhs) {
+        return &lhs.get_region() == &rhs.get_region();
+    }
+
+    template<class T, class U>
+    bool operator!=(const region_allocator<T> & lhs, const region_allocator<U> & rhs) {
+        return !(lhs == rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_REGION_ALLOCATOR_HPP
@@ -0,0 +1,655 @@
+#ifndef FT_CONTAINERS_SERIALIZE_HPP
+#define FT_CONTAINERS_SERIALIZE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "map.hpp"
+#include "set.hpp"
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft {
+    /**
+     * @brief The error thrown if a snapshot cannot be written or read.
+     */
+    class snapshot_error: public std::runtime_error {
+    public:
+        explicit snapshot_error(const std::string & what): std::runtime_error(what) {}
+    };
+
+    /**
+     * @brief The header of a snapshot file.
+     *
+     * A snapshot consists of this header, padded to payload_offset bytes, followed by the
+     * elements in the order of the container. The elements are stored in the byte order and
+     * with the sizes of the machine that wrote them, the header records both, so that a
+     * snapshot of another machine is rejected instead of being misread.
+     */
+    struct snapshot_header {
+        enum {
+            /** The offset of the elements, keeping them aligned for any fundamental type. */
+            payload_offset = 64,
+            current_version = 1,
+            byte_order_mark = 0x01020304
+        };
+
+        /** The kinds of the saved containers, single bits so that several can be expected. */
+        enum kind_type { vector_kind = 1, set_kind = 2, map_kind = 4 };
+
+        char         magic[8];
+        unsigned int version;
+        unsigned int byte_order;
+        unsigned int kind;
+        /** The size of the keys, or of the elements of a vector. */
+        unsigned int key_size;
+        /** The size of the mapped values, zero for a vector or a set. */
+        unsigned int mapped_size;
+        /** The size of every stored element, zero if they are written by a serializer. */
+        unsigned int record_size;
+        std::size_t  count;
+        /** The size of the elements in bytes, padded to whole words. */
+        std::size_t  payload_size;
+        /** The checksum of the padded elements, see SnapshotChecksum. */
+        std::size_t  checksum[2];
+    };
+
+    /**
+     * @brief Computes the checksum of the payload of a snapshot.
+     *
+     * The 32 bit words are summed up, and so are the sums, as done by the Fletcher checksum,
+     * but wrapping around instead of reducing by a modulus, which makes it fast enough to be
+     * checked on every load. The data is expected in multiples of four bytes.
+     */
+    class SnapshotChecksum {
+    public:
+        SnapshotChecksum(): sum(0), weighted(0) {}
+
+        void update(const unsigned char * data, std::size_t size) {
+            std::size_t a = sum, b = weighted;
+            for (std::size_t i = 0; i + 4 <= size; i += 4) {
+                unsigned int word;
+                std::memcpy(&word, data + i, 4);
+                a += word;
+                b += a;
+            }
+            sum      = a;
+            weighted = b;
+        }
+
+        bool matches(const snapshot_header & header) const {
+            return header.checksum[0] == sum && header.checksum[1] == weighted;
+        }
+
+        void store(snapshot_header & header) const {
+            header.checksum[0] = sum;
+            header.checksum[1] = weighted;
+        }
+
+    private:
+        std::size_t sum;
+        std::size_t weighted;
+    };
+
+    /**
+     * @brief Writes a snapshot file.
+     *
+     * The elements are written into a temporary file next to the target, which replaces the
+     * target only once it is complete, so that a failed save leaves the previous snapshot.
+     */
+    class snapshot_writer {
+    public:
+        /**
+         * Creates the temporary file of the given snapshot.
+         *
+         * @param path The path of the snapshot.
+         * @param header The header, the count and the checksum are filled in by commit.
+         */
+        snapshot_writer(const char * path, const snapshot_header & header)
+            : fd(-1), path(path), temporary(std::string(path) + ".tmp"), header(header), buffer(NULL), used(0), written(0) {
+            buffer = new unsigned char[bufferSize];
+            fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                delete[] buffer;
+                throw snapshot_error("ft::snapshot_writer: Could not create " + temporary + "!");
+            }
+            std::memcpy(this->header.magic, "ftsnap\0", 8);
+            this->header.version    = snapshot_header::current_version;
+            this->header.byte_order = snapshot_header::byte_order_mark;
+            std::memset(buffer, 0, snapshot_header::payload_offset);
+            try {
+                writeAll(buffer, snapshot_header::payload_offset);
+            } catch (...) {
+                discard();
+                delete[] buffer;
+                throw;
+            }
+        }
+
+        /**
+         * Removes the temporary file if the snapshot has not been committed.
+         */
+       ~snapshot_writer() {
+            if (fd >= 0) discard();
+            delete[] buffer;
+        }
+
+        /**
+         * Appends the given bytes to the payload.
+         *
+         * @param data The bytes to be written.
+         * @param size The count of bytes.
+         */
+        void write(const void * data, std::size_t size) {
+            const unsigned char * bytes = static_cast<const unsigned char *>(data);
+            while (size > 0) {
+                const std::size_t chunk = size < bufferSize - used ? size : bufferSize - used;
+                std::memcpy(buffer + used, bytes, chunk);
+                used  += chunk;
+                bytes += chunk;
+                size  -= chunk;
+                if (used == bufferSize) flush();
+            }
+        }
+
+        /**
+         * Pads the payload, writes the header and moves the snapshot into place.
+         *
+         * @param count The count of the written elements.
+         */
+        void commit(std::size_t count) {
+            while (used % sizeof(std::size_t) != 0) buffer[used++] = 0;
+            flush();
+            header.count        = count;
+            header.payload_size = written;
+            checksum.store(header);
+            if (pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))) {
+                throw snapshot_error("ft::snapshot_writer: Could not write " + temporary + "!");
+            }
+            const int result = close(fd);
+            fd = -1;
+            if (result != 0 || std::rename(temporary.c_str(), path.c_str()) != 0) {
+                std::remove(temporary.c_str());
+                throw snapshot_error("ft::snapshot_writer: Could not write " + path + "!");
+            }
+        }
+
+    private:
+        /** The size of the write buffer, a multiple of the checksummed words. */
+        static const std::size_t bufferSize = 1 << 16;
+
+        int                 fd;
+        std::string         path;
+        std::string         temporary;
+        snapshot_header     header;
+        unsigned char *     buffer;
+        std::size_t         used;
+        /** The count of payload bytes written to the file. */
+        std::size_t         written;
+        SnapshotChecksum    checksum;
+
+        snapshot_writer(const snapshot_writer &);
+        snapshot_writer & operator=(const snapshot_writer &);
+
+        void flush() {
+            checksum.update(buffer, used);
+            writeAll(buffer, used);
+            written += used;
+            used     = 0;
+        }
+
+        void writeAll(const unsigned char * data, std::size_t size) {
+            while (size > 0) {
+                const ssize_t result = ::write(fd, data, size);
+                if (result <= 0) throw snapshot_error("ft::snapshot_writer: Could not write " + temporary + "!");
+                data += result;
+                size -= static_cast<std::size_t>(result);
+            }
+        }
+
+        void discard() {
+            close(fd);
+            fd = -1;
+            std::remove(temporary.c_str());
+        }
+    };
+
+    /**
+     * @brief Reads the payload of a snapshot.
+     */
+    class snapshot_reader {
+    public:
+        snapshot_reader(const unsigned char * first, const unsigned char * last): current(first), last(last) {}
+
+        /**
+         * Copies the next bytes of the payload.
+         *
+         * @param data The storage of the bytes.
+         * @param size The count of bytes to be read.
+         */
+        void read(void * data, std::size_t size) {
+            if (size > static_cast<std::size_t>(last - current)) throw snapshot_error("ft::snapshot_reader: Truncated snapshot!");
+            std::memcpy(data, current, size);
+            current += size;
+        }
+
+    private:
+        const unsigned char * current;
+        const unsigned char * last;
+    };
+
+    /**
+     * @brief Writes and reads objects of type T to and from snapshots.
+     *
+     * Trivially copyable types are stored by their bytes, these are fixed_size and can be
+     * loaded directly from the mapped file. Other types need a specialization writing them
+     * by snapshot_writer::write and reading them by snapshot_reader::read, with fixed_size
+     * being zero; the specialization for std::string is an example.
+     *
+     * @tparam T The type of the objects.
+     */
+    template<class T>
+    struct serializer {
+        enum { fixed_size = is_trivially_copyable<T>::value };
+
+        static void write(snapshot_writer & out, const T & value) {
+            typedef char requiresSerializer[fixed_size ? 1 : -1];
+            (void) sizeof(requiresSerializer);
+            out.write(&value, sizeof(T));
+        }
+
+        static void read(snapshot_reader & in, T & value) {
+            typedef char requiresSerializer[fixed_size ? 1 : -1];
+            (void) sizeof(requiresSerializer);
+            in.read(&value, sizeof(T));
+        }
+    };
+
+    /**
+     * Strings are stored by their length followed by their characters.
+     */
+    template<class CharT, class Traits, class Allocator>
+    struct serializer<std::basic_string<CharT, Traits, Allocator> > {
+        enum { fixed_size = 0 };
+
+        static void write(snapshot_writer & out, const std::basic_string<CharT, Traits, Allocator> & value) {
+            const std::size_t length = value.size();
+            out.write(&length, sizeof(length));
+            out.write(value.data(), length * sizeof(CharT));
+        }
+
+        static void read(snapshot_reader & in, std::basic_string<CharT, Traits, Allocator> & value) {
+            std::size_t length;
+            in.read(&length, sizeof(length));
+            value.resize(length);
+            if (length > 0) in.read(&value[0], length * sizeof(CharT));
+        }
+    };
+
+    /**
+     * The key and the mapped value of a map are written one after the other, unless both are
+     * fixed_size, the pair is then stored by its bytes.
+     */
+    template<class Key, class T>
+    struct serializer<ft::pair<Key, T> > {
+        enum { fixed_size = serializer<Key>::fixed_size && serializer<T>::fixed_size };
+
+        static void write(snapshot_writer & out, const ft::pair<Key, T> & value) {
+            if (fixed_size) {
+                out.write(&value, sizeof(value));
+            } else {
+                serializer<Key>::write(out, value.first);
+                serializer<T>::write(out, value.second);
+            }
+        }
+
+        static void read(snapshot_reader & in, ft::pair<Key, T> & value) {
+            if (fixed_size) {
+                in.read(&value, sizeof(value));
+            } else {
+                serializer<Key>::read(in, value.first);
+                serializer<T>::read(in, value.second);
+            }
+        }
+    };
+
+    /**
+     * @brief A snapshot file mapped into memory, its header and payload validated.
+     */
+    class MappedSnapshot {
+    public:
+        /**
+         * Maps the given snapshot, checking it holds the expected kind of elements.
+         *
+         * @param path The path of the snapshot.
+         * @param expected The header to match, all but the count and the checksum are compared,
+         *                 the kind of the snapshot has to be one of the expected kinds.
+         * @param verify Whether the checksum is verified, which reads the whole payload.
+         */
+        MappedSnapshot(const char * path, const snapshot_header & expected, bool verify): address(MAP_FAILED), size(0) {
+            const int fd = open(path, O_RDONLY);
+            if (fd < 0) throw snapshot_error(std::string("ft::load: Could not open ") + path + "!");
+            struct stat status;
+            if (fstat(fd, &status) == 0 && status.st_size >= static_cast<off_t>(snapshot_header::payload_offset)) {
+                size    = static_cast<std::size_t>(status.st_size);
+                address = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            close(fd);
+            if (address == MAP_FAILED) throw snapshot_error(std::string("ft::load: Could not map ") + path + "!");
+#ifdef MADV_SEQUENTIAL
+            madvise(address, size, MADV_SEQUENTIAL);
+#endif
+            try {
+                validate(expected, verify);
+            } catch (...) {
+                munmap(address, size);
+                throw;
+            }
+        }
+
+       ~MappedSnapshot() { munmap(address, size); }
+
+        const snapshot_header & header() const { return *static_cast<const snapshot_header *>(address); }
+
+        const unsigned char * payload() const { return static_cast<const unsigned char *>(address) + snapshot_header::payload_offset; }
+
+        snapshot_reader reader() const { return snapshot_reader(payload(), payload() + header().payload_size); }
+
+    private:
+        void *      address;
+        std::size_t size;
+
+        MappedSnapshot(const MappedSnapshot &);
+        MappedSnapshot & operator=(const MappedSnapshot &);
+
+        void validate(const snapshot_header & expected, bool verify) const {
+            const snapshot_header & actual = header();
+            if (std::memcmp(actual.magic, "ftsnap\0", 8) != 0 || actual.version != snapshot_header::current_version
+                || actual.byte_order != snapshot_header::byte_order_mark) {
+                throw snapshot_error("ft::load: Not a snapshot of this machine!");
+            }
+            if ((actual.kind & expected.kind) == 0 || (actual.kind & (actual.kind - 1)) != 0 || actual.key_size != expected.key_size
+                || actual.mapped_size != expected.mapped_size || actual.record_size != expected.record_size) {
+                throw snapshot_error("ft::load: The snapshot holds other elements!");
+            }
+            if (actual.payload_size != size - snapshot_header::payload_offset
+                || (actual.record_size != 0 && actual.count > actual.payload_size / actual.record_size)) {
+                throw snapshot_error("ft::load: Truncated snapshot!");
+            }
+            if (verify) {
+                SnapshotChecksum checksum;
+                checksum.update(payload(), actual.payload_size);
+                if (!checksum.matches(actual)) throw snapshot_error("ft::load: Corrupted snapshot!");
+            }
+        }
+    };
+
+    /**
+     * Returns the header describing a snapshot of the given kind of elements.
+     */
+    template<class T>
+    snapshot_header snapshotHeader(unsigned int kind, std::size_t keySize, std::size_t mappedSize) {
+        typedef char headerFits[sizeof(snapshot_header) <= snapshot_header::payload_offset ? 1 : -1];
+        (void) sizeof(headerFits);
+
+        snapshot_header header;
+        std::memset(&header, 0, sizeof(header));
+        header.kind        = kind;
+        header.key_size    = static_cast<unsigned int>(keySize);
+        header.mapped_size = static_cast<unsigned int>(mappedSize);
+        header.record_size = serializer<T>::fixed_size ? static_cast<unsigned int>(sizeof(T)) : 0;
+        return header;
+    }
+
+    /**
+     * Writes the elements of the given range to a snapshot.
+     */
+    template<class Storage, class InputIt>
+    void saveRange(const char * path, const snapshot_header & header, InputIt first, InputIt last, std::size_t count) {
+        snapshot_writer out(path, header);
+        for (; first != last; ++first) {
+            serializer<Storage>::write(out, *first);
+        }
+        out.commit(count);
+    }
+
+    /**
+     * Reads the elements of a snapshot not stored by their bytes into the given vector. As
+     * the count is not covered by the checksum, no more elements than payload bytes are
+     * reserved up front.
+     */
+    template<class Storage>
+    void readRecords(const MappedSnapshot & snapshot, ft::vector<Storage> & values) {
+        snapshot_reader in = snapshot.reader();
+        values.reserve(snapshot.header().count < snapshot.header().payload_size ? snapshot.header().count : snapshot.header().payload_size);
+        Storage value;
+        for (std::size_t i = 0; i < snapshot.header().count; ++i) {
+            serializer<Storage>::read(in, value);
+            values.push_back(value);
+        }
+    }
+
+    /**
+     * @brief Compares the elements of a map by their keys.
+     */
+    template<class Compare>
+    struct KeyOrder {
+        Compare comp;
+
+        explicit KeyOrder(Compare comp): comp(comp) {}
+
+        template<class Pair>
+        bool operator()(const Pair & lhs, const Pair & rhs) const { return comp(lhs.first, rhs.first); }
+    };
+
+    /**
+     * Checks that the given loaded elements are strictly ordered by the given compare object,
+     * as a tree built from them by assign_sorted would be broken otherwise.
+     *
+     * @throws snapshot_error If two neighbouring elements are not in order.
+     */
+    template<class InputIt, class Compare>
+    void checkOrder(InputIt first, InputIt last, Compare comp) {
+        if (first == last) return;
+        for (InputIt previous = first; ++first != last; previous = first) {
+            if (!comp(*previous, *first)) throw snapshot_error("ft::load: The snapshot is not ordered like the container!");
+        }
+    }
+
+    /**
+     * Saves the given vector to a snapshot at the given path, replacing any file there.
+     *
+     * @param path The path of the snapshot.
+     * @param v The vector to be saved.
+     */
+    template<class T, class Allocator>
+    void save(const char * path, const ft::vector<T, Allocator> & v) {
+        const snapshot_header header = snapshotHeader<T>(snapshot_header::vector_kind, sizeof(T), 0);
+        if (serializer<T>::fixed_size) {
+            snapshot_writer out(path, header);
+            out.write(v.data(), v.size() * sizeof(T));
+            out.commit(v.size());
+        } else {
+            saveRange<T>(path, header, v.begin(), v.end(), v.size());
+        }
+    }
+
+    /**
+     * Saves the given set to a snapshot at the given path, the elements in their order.
+     *
+     * @param path The path of the snapshot.
+     * @param s The set to be saved.
+     */
+    template<class Key, class Compare, class Allocator, class Options>
+    void save(const char * path, const ft::set<Key, Compare, Allocator, Options> & s) {
+        saveRange<Key>(path, snapshotHeader<Key>(snapshot_header::set_kind, sizeof(Key), 0), s.begin(), s.end(), s.size());
+    }
+
+    /**
+     * Saves the given map to a snapshot at the given path, the elements in their order.
+     *
+     * @param path The path of the snapshot.
+     * @param m The map to be saved.
+     */
+    template<class Key, class T, class Compare, class Allocator, class Options>
+    void save(const char * path, const ft::map<Key, T, Compare, Allocator, Options> & m) {
+        typedef ft::pair<Key, T> storageType;
+
+        typedef typename ft::map<Key, T, Compare, Allocator, Options>::const_iterator iterator;
+
+        const snapshot_header header = snapshotHeader<storageType>(snapshot_header::map_kind, sizeof(Key), sizeof(T));
+        snapshot_writer out(path, header);
+        if (serializer<storageType>::fixed_size) {
+            storageType record;
+            // Zeroes the padding of the pair, which is written as well.
+            std::memset(static_cast<void *>(&record), 0, sizeof(record));
+            for (iterator it = m.begin(); it != m.end(); ++it) {
+                record.first  = it->first;
+                record.second = it->second;
+                out.write(&record, sizeof(record));
+            }
+        } else {
+            for (iterator it = m.begin(); it != m.end(); ++it) {
+                serializer<Key>::write(out, it->first);
+                serializer<T>::write(out, it->second);
+            }
+        }
+        out.commit(m.size());
+    }
+
+    /**
+     * Replaces the contents of the given vector by the snapshot at the given path.
+     *
+     * @param path The path of the snapshot.
+     * @param v The vector to be loaded.
+     * @throws snapshot_error If the file is no valid snapshot of such a vector.
+     */
+    template<class T, class Allocator>
+    void load(const char * path, ft::vector<T, Allocator> & v) {
+        MappedSnapshot snapshot(path, snapshotHeader<T>(snapshot_header::vector_kind, sizeof(T), 0), true);
+        if (serializer<T>::fixed_size) {
+            const T * first = reinterpret_cast<const T *>(snapshot.payload());
+            v.assign(first, first + snapshot.header().count);
+        } else {
+            ft::vector<T, Allocator> values;
+            readRecords(snapshot, values);
+            v.swap(values);
+        }
+    }
+
+    /**
+     * Replaces the contents of the given set by the snapshot at the given path. The tree is
+     * built bottom up by set::assign_sorted, the snapshot has to be saved from a set of the
+     * same compare object, which is checked while loading.
+     *
+     * @param path The path of the snapshot.
+     * @param s The set to be loaded.
+     * @throws snapshot_error If the file is no valid snapshot of such a set, the set is then unchanged.
+     */
+    template<class Key, class Compare, class Allocator, class Options>
+    void load(const char * path, ft::set<Key, Compare, Allocator, Options> & s) {
+        MappedSnapshot snapshot(path, snapshotHeader<Key>(snapshot_header::set_kind, sizeof(Key), 0), true);
+        if (serializer<Key>::fixed_size) {
+            const Key * first = reinterpret_cast<const Key *>(snapshot.payload());
+            checkOrder(first, first + snapshot.header().count, s.key_comp());
+            s.assign_sorted(first, first + snapshot.header().count);
+        } else {
+            ft::vector<Key> values;
+            readRecords(snapshot, values);
+            checkOrder(values.begin(), values.end(), s.key_comp());
+            s.assign_sorted(values.begin(), values.end());
+        }
+    }
+
+    /**
+     * Replaces the contents of the given map by the snapshot at the given path. The tree is
+     * built bottom up by map::assign_sorted, the snapshot has to be saved from a map of the
+     * same compare object, which is checked while loading.
+     *
+     * @param path The path of the snapshot.
+     * @param m The map to be loaded.
+     * @throws snapshot_error If the file is no valid snapshot of such a map, the map is then unchanged.
+     */
+    template<class Key, class T, class Compare, class Allocator, class Options>
+    void load(const char * path, ft::map<Key, T, Compare, Allocator, Options> & m) {
+        typedef ft::pair<Key, T> storageType;
+
+        MappedSnapshot snapshot(path, snapshotHeader<storageType>(snapshot_header::map_kind, sizeof(Key), sizeof(T)), true);
+        if (serializer<storageType>::fixed_size) {
+            const storageType * first = reinterpret_cast<const storageType *>(snapshot.payload());
+            checkOrder(first, first + snapshot.header().count, KeyOrder<Compare>(m.key_comp()));
+            m.assign_sorted(first, first + snapshot.header().count);
+        } else {
+            ft::vector<storageType> values;
+            readRecords(snapshot, values);
+            checkOrder(values.begin(), values.end(), KeyOrder<Compare>(m.key_comp()));
+            m.assign_sorted(values.begin(), values.end());
+        }
+    }
+
+    /**
+     * @brief A read-only view of a saved vector, mapped from its snapshot without copying.
+     *
+     * The pages are read by the kernel once they are accessed, opening the view without
+     * verifying the checksum is therefore independent of the size of the snapshot. The
+     * snapshot of a set can be viewed as well, its elements are sorted.
+     *
+     * @tparam T The type of the elements, which has to be fixed_size.
+     */
+    template<class T>
+    class vector_view {
+    public:
+        typedef T                  value_type;
+        typedef std::size_t        size_type;
+        typedef std::ptrdiff_t     difference_type;
+        typedef const T &          reference;
+        typedef const T &          const_reference;
+        typedef const T *          pointer;
+        typedef const T *          const_pointer;
+        typedef const T *          iterator;
+        typedef const T *          const_iterator;
+
+        /**
+         * Maps the snapshot at the given path.
+         *
+         * @param path The path of the snapshot.
+         * @param verify Whether to verify the checksum, which reads the whole snapshot.
+         * @throws snapshot_error If the file is no valid snapshot of a vector or a set of T.
+         */
+        explicit vector_view(const char * path, bool verify = true)
+            : snapshot(path, snapshotHeader<T>(snapshot_header::vector_kind | snapshot_header::set_kind, sizeof(T), 0), verify) {
+            typedef char requiresFixedSize[serializer<T>::fixed_size ? 1 : -1];
+            (void) sizeof(requiresFixedSize);
+        }
+
+        const_pointer   data()  const { return reinterpret_cast<const T *>(snapshot.payload()); }
+        size_type       size()  const { return snapshot.header().count;                        }
+        bool            empty() const { return size() == 0;                                    }
+        const_iterator  begin() const { return data();                                         }
+        const_iterator  end()   const { return data() + size();                                }
+        const_reference front() const { return *begin();                                       }
+        const_reference back()  const { return *(end() - 1);                                   }
+
+        const_reference operator[](size_type pos) const { return data()[pos]; }
+
+        const_reference at(size_type pos) const {
+            if (pos >= size()) throw std::out_of_range("ft::vector_view<T>::at: Out of range!");
+            return data()[pos];
+        }
+
+    private:
+        MappedSnapshot snapshot;
+
+        vector_view(const vector_view &);
+        vector_view & operator=(const vector_view &);
+    };
+}
+
+#endif //FT_CONTAINERS_SERIALIZE_HPP
@@ -11,11 +11,13 @@
 #include "utility.hpp"
 #include "tree.hpp"
 #include "algorithm.hpp"
+#include "frozen_set.hpp"
 
 namespace ft {
     template<class Key,
             class Compare   = ft::less<Key>,
-            class Allocator = std::allocator<Key>
+            class Allocator = std::allocator<Key>,
+            class Options   = ft::tree_options<>
             >
     class set {
     public:
@@ -31,13 +33,15 @@ namespace ft {
         /**
          * The type of the used tree.
          */
-        typedef Tree<key_type, key_compare, allocator_type> treeType;
+        typedef Tree<key_type, key_compare, allocator_type, Options> treeType;
         typedef typename treeType::sizeType                 size_type;
         typedef typename treeType::differenceType           difference_type;
         typedef typename treeType::constIteratorType        iterator;
         typedef typename treeType::constIteratorType        const_iterator;
         typedef ft::reverse_iterator<iterator>              reverse_iterator;
         typedef ft::reverse_iterator<const_iterator>        const_reverse_iterator;
+        typedef tree_range<const_reference, typename treeType::nodeType> range_type;
+        typedef tree_range<const_reference, typename treeType::nodeType> const_range_type;
     private:
         /**
          * The type of the non-const iterator, needed to delegate iterators to the tree.
@@ -46,14 +50,14 @@ namespace ft {
 
     public:
 
-        set(): alloc(Allocator()), keyCompare(key_compare()), valueCompare(keyCompare), tree(valueCompare) {}
+        set(): alloc(Allocator()), keyCompare(key_compare()), valueCompare(keyCompare), tree(valueCompare, alloc) {}
 
         explicit set(const Compare & comp, const Allocator & alloc = Allocator())
-            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare) {}
+            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare, alloc) {}
 
         template<class InputIt>
         set(InputIt first, InputIt last, const Compare & comp = Compare(), const Allocator & alloc = Allocator())
-            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare) {
+            : alloc(alloc), keyCompare(comp), valueCompare(comp), tree(valueCompare, alloc) {
             insert(first, last);
         }
 
@@ -91,11 +95,60 @@ namespace ft {
         size_type     size() const { return tree.size();    }
         size_type max_size() const { return tree.maxSize(); }
 
+        memory_report memory_usage() const { return tree.memoryUsage(); }
+
+        /**
+         * Returns the height, the black height and the count of the nodes of the underlying
+         * tree, together with the counters collected if Options uses tree_stats.
+         *
+         * @return The statistics of the underlying tree.
+         */
+        tree_statistics stats() const { return tree.statistics(); }
+
+        void reset_stats() { tree.resetStatistics(); }
+
+        /**
+         * Cuts this set into disjoint ranges of elements which can be visited concurrently,
+         * see Tree::split.
+         *
+         * @param depth The depth of the subtrees.
+         * @param out The output of the ranges.
+         * @return The end of the output.
+         */
+        template<class OutputIt>
+        OutputIt split(size_type depth, OutputIt out) const { return tree.template split<const_range_type>(depth, out); }
+
         void clear() { tree.clear(); }
 
         ft::pair<iterator, bool> insert(const value_type & value) { return tree.insert(value);       }
         iterator insert(iterator hint, const value_type & value)  { return tree.insert(normal_iterator(hint), value); }
 
+        /**
+         * Replaces the contents of this set by the given range, building the tree bottom up,
+         * which is much faster than inserting the elements one by one.
+         *
+         * @param first The beginning of the range, sorted and free of equivalent keys.
+         * @param last The end of the range.
+         */
+        template<class RandomIt>
+        void assign_sorted(RandomIt first, RandomIt last) {
+            serial_executor executor;
+            tree.assignSorted(first, last, executor);
+        }
+
+        /**
+         * Replaces the contents of this set by the given range, the subtrees being built by the
+         * given executor, see ft::parallel::bulk_load.
+         *
+         * @param first The beginning of the range, sorted and free of equivalent keys.
+         * @param last The end of the range.
+         * @param executor Runs the builds of the subtrees.
+         */
+        template<class RandomIt, class Executor>
+        void assign_sorted(RandomIt first, RandomIt last, Executor & executor) {
+            tree.assignSorted(first, last, executor);
+        }
+
         template<class InputIt>
         void insert(InputIt first, InputIt last) {
             for (; first != last; ++first) {
@@ -123,7 +176,17 @@ namespace ft {
             return 0;
         }
 
-        void swap(set & other) { tree.swap(other.tree); }
+        /**
+         * Exchanges the contents of this set with the other one. With inline nodes, see
+         * tree_options, this may allocate and throw, and the iterators to the elements stored
+         * inline are invalidated; otherwise no iterator is invalidated.
+         *
+         * @param other The other set.
+         */
+        void swap(set & other) {
+            std::swap(alloc, other.alloc);
+            tree.swap(other.tree);
+        }
 
         size_type count(const Key & key) const { return find(key) == end() ? 0 : 1; }
 
@@ -146,7 +209,16 @@ namespace ft {
 
         key_compare key_comp() const { return keyCompare; }
 
-        ft::set<Key, Compare, Allocator>::value_compare value_comp() const { return valueCompare; }
+        ft::set<Key, Compare, Allocator, Options>::value_compare value_comp() const { return valueCompare; }
+
+        /**
+         * Creates a read-only copy of this set whose lookups do not need to chase any pointers.
+         *
+         * @return A frozen set holding the same keys as this set.
+         */
+        ft::frozen_set<Key, Compare, Allocator> freeze() const {
+            return ft::frozen_set<Key, Compare, Allocator>(begin(), end(), keyCompare, alloc);
+        }
 
     private:
         allocator_type alloc;
@@ -155,44 +227,38 @@ namespace ft {
         treeType       tree;
     };
 
-    template<class Key, class Compare, class Alloc>
-    bool operator==(const ft::set<Key, Compare, Alloc> & lhs, const ft::set<Key, Compare, Alloc> & rhs) {
-        typename ft::set<Key, Compare, Alloc>::const_iterator it, it2;
-        for (it = lhs.begin(), it2 = rhs.begin(); it != lhs.end() && it2 != rhs.end(); ++it, ++it2) {
-            if (!(*it == *it2)) {
-                return false;
-            }
-        }
-        return it == lhs.end() && it2 == rhs.end();
+    template<class Key, class Compare, class Alloc, class Options>
+    bool operator==(const ft::set<Key, Compare, Alloc, Options> & lhs, const ft::set<Key, Compare, Alloc, Options> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator!=(const ft::set<Key, Compare, Alloc> & lhs, const ft::set<Key, Compare, Alloc> & rhs) {
+    template<class Key, class Compare, class Alloc, class Options>
+    bool operator!=(const ft::set<Key, Compare, Alloc, Options> & lhs, const ft::set<Key, Compare, Alloc, Options> & rhs) {
         return !(lhs == rhs);
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator<(const ft::set<Key, Compare, Alloc> & lhs, const ft::set<Key, Compare, Alloc> & rhs) {
-        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    template<class Key, class Compare, class Alloc, class Options>
+    bool operator<(const ft::set<Key, Compare, Alloc, Options> & lhs, const ft::set<Key, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) < 0;
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator<=(const ft::set<Key, Compare, Alloc> & lhs, const ft::set<Key, Compare, Alloc> & rhs) {
-        return lhs < rhs || lhs == rhs;
+    template<class Key, class Compare, class Alloc, class Options>
+    bool operator<=(const ft::set<Key, Compare, Alloc, Options> & lhs, const ft::set<Key, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) <= 0;
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator>(const ft::set<Key, Compare, Alloc> & lhs, const ft::set<Key, Compare, Alloc> & rhs) {
-        return rhs < lhs;
+    template<class Key, class Compare, class Alloc, class Options>
+    bool operator>(const ft::set<Key, Compare, Alloc, Options> & lhs, const ft::set<Key, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) > 0;
     }
 
-    template<class Key, class Compare, class Alloc>
-    bool operator>=(const ft::set<Key, Compare, Alloc> & lhs, const ft::set<Key, Compare, Alloc> & rhs) {
-        return rhs < lhs || lhs == rhs;
+    template<class Key, class Compare, class Alloc, class Options>
+    bool operator>=(const ft::set<Key, Compare, Alloc, Options> & lhs, const ft::set<Key, Compare, Alloc, Options> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) >= 0;
     }
 
-    template<class Key, class Compare, class Alloc>
-    void swap(ft::set<Key, Compare, Alloc> & lhs, ft::set<Key, Compare, Alloc> & rhs) {
+    template<class Key, class Compare, class Alloc, class Options>
+    void swap(ft::set<Key, Compare, Alloc, Options> & lhs, ft::set<Key, Compare, Alloc, Options> & rhs) {
         lhs.swap(rhs);
     }
 }
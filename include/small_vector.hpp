@@ -0,0 +1,259 @@
+#ifndef FT_CONTAINERS_SMALL_VECTOR_HPP
+#define FT_CONTAINERS_SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include "vector.hpp"
+
+namespace ft {
+    /**
+     * @brief Uninitialized storage for N objects of type T, located inside of the owning object.
+     *
+     * @tparam T The type of the objects to be stored.
+     * @tparam N The count of objects that can be stored.
+     */
+    template<class T, std::size_t N>
+    struct small_vector_buffer {
+        /**
+         * The raw storage, aligned for any fundamental type.
+         */
+        union {
+            char        bytes[N * sizeof(T)];
+            void *      pointerAlign;
+            long        longAlign;
+            long double floatAlign;
+        } storage;
+        /**
+         * Whether the storage is currently handed out.
+         */
+        bool inUse;
+
+        small_vector_buffer(): inUse(false) {}
+
+        T * inlineData() { return reinterpret_cast<T *>(storage.bytes); }
+    };
+
+    /**
+     * @brief An allocator handing out an inline buffer for requests of up to N objects.
+     *
+     * Bigger requests, or requests while the buffer is in use, are forwarded to the
+     * underlying allocator.
+     *
+     * @tparam T The type of the allocated objects.
+     * @tparam N The capacity of the inline buffer.
+     * @tparam Allocator The allocator used once the buffer does not suffice.
+     */
+    template<class T, std::size_t N, class Allocator>
+    class small_vector_allocator: public Allocator {
+    public:
+        typedef typename Allocator::pointer   pointer;
+        typedef typename Allocator::size_type size_type;
+
+        /**
+         * Rebinding yields the underlying allocator, the buffer only fits objects of type T.
+         */
+        template<class U>
+        struct rebind {
+            typedef typename Allocator::template rebind<U>::other other;
+        };
+
+        /**
+         * Constructs an allocator handing out the given buffer.
+         *
+         * @param buffer The inline buffer, may be NULL.
+         * @param alloc The underlying allocator.
+         */
+        explicit small_vector_allocator(small_vector_buffer<T, N> * buffer, const Allocator & alloc = Allocator())
+            : Allocator(alloc), buffer(buffer) {}
+
+        /**
+         * Copies the underlying allocator only. The buffer belongs to a single small_vector,
+         * a copy therefore never hands it out.
+         *
+         * @param other The allocator to copy.
+         */
+        small_vector_allocator(const small_vector_allocator & other)
+            : Allocator(other), buffer(NULL) {}
+
+        /**
+         * Assigns the underlying allocator only, this allocator keeps its buffer.
+         *
+         * @param other The allocator to copy.
+         * @return A reference to this instance.
+         */
+        small_vector_allocator & operator=(const small_vector_allocator & other) {
+            Allocator::operator=(other);
+            return *this;
+        }
+
+        /**
+         * Lets this allocator hand out the given buffer.
+         *
+         * @param buffer The inline buffer of the owning small_vector.
+         */
+        void bind(small_vector_buffer<T, N> * buffer) { this->buffer = buffer; }
+
+        /**
+         * Allocates storage for n objects, using the inline buffer if possible.
+         *
+         * @param n The count of objects.
+         * @param hint Passed to the underlying allocator.
+         * @return The allocated storage.
+         */
+        pointer allocate(size_type n, const void * hint = 0) {
+            if (buffer != NULL && !buffer->inUse && n <= N) {
+                buffer->inUse = true;
+                return buffer->inlineData();
+            }
+            return Allocator::allocate(n, hint);
+        }
+
+        /**
+         * Releases the given storage.
+         *
+         * @param p The storage to be released.
+         * @param n The count of objects the storage was allocated for.
+         */
+        void deallocate(pointer p, size_type n) {
+            if (buffer != NULL && p == buffer->inlineData()) {
+                buffer->inUse = false;
+            } else {
+                Allocator::deallocate(p, n);
+            }
+        }
+
+    private:
+        /**
+         * The inline buffer of the owning small_vector.
+         */
+        small_vector_buffer<T, N> * buffer;
+    };
+
+    /**
+     * @brief A vector keeping up to N elements inside of the object itself.
+     *
+     * Once more than N elements are stored, the elements are moved to the heap using the
+     * growth logic of the vector. All operations are the ones of the vector.
+     *
+     * @tparam T The type of the contained objects.
+     * @tparam N The count of objects stored without allocation.
+     * @tparam Allocator The allocator used once the inline buffer does not suffice.
+     */
+    template<class T, std::size_t N, class Allocator = std::allocator<T> >
+    class small_vector: private small_vector_buffer<T, N>,
+                        public  vector<T, small_vector_allocator<T, N, Allocator> > {
+        /**
+         * The type of the vector this class is based on.
+         */
+        typedef vector<T, small_vector_allocator<T, N, Allocator> > base;
+
+    public:
+        typedef typename base::value_type     value_type;
+        typedef typename base::allocator_type allocator_type;
+        typedef typename base::size_type      size_type;
+        typedef typename base::iterator       iterator;
+        typedef typename base::const_iterator const_iterator;
+
+        /**
+         * Constructs an empty vector.
+         *
+         * @param alloc The allocator used once the inline buffer does not suffice.
+         */
+        explicit small_vector(const Allocator & alloc = Allocator())
+            : base(allocator_type(NULL, alloc)) {
+            useBuffer();
+        }
+
+        /**
+         * Constructs a vector holding count copies of the given value.
+         *
+         * @param count The number of objects.
+         * @param value The value for all of the objects.
+         * @param alloc The allocator used once the inline buffer does not suffice.
+         */
+        explicit small_vector(size_type count, const T & value = T(), const Allocator & alloc = Allocator())
+            : base(allocator_type(NULL, alloc)) {
+            useBuffer();
+            base::insert(base::end(), count, value);
+        }
+
+        /**
+         * Constructs a vector holding a copy of the given range.
+         *
+         * @tparam InputIt The type of the input iterators.
+         * @param first The beginning of the range.
+         * @param last The end of the range to copy.
+         * @param alloc The allocator used once the inline buffer does not suffice.
+         */
+        template<class InputIt>
+        small_vector(InputIt first, typename ft::enable_if<!is_integral<InputIt>::value, InputIt>::type last, const Allocator & alloc = Allocator())
+            : base(allocator_type(NULL, alloc)) {
+            useBuffer();
+            base::insert(base::end(), first, last);
+        }
+
+        /**
+         * Constructs a copy of the given vector, using the inline buffer of this instance.
+         *
+         * @param other The vector to copy.
+         */
+        small_vector(const small_vector & other)
+            : small_vector_buffer<T, N>(), base(other.get_allocator()) {
+            useBuffer();
+            base::insert(base::end(), other.begin(), other.end());
+        }
+
+        /**
+         * Replaces the contents of this vector by a copy of the other one's.
+         *
+         * @param other The vector to copy.
+         * @return A reference to this instance.
+         */
+        small_vector & operator=(const small_vector & other) {
+            base::operator=(other);
+            return *this;
+        }
+
+        /**
+         * Exchanges the contents of this vector with the other one's. The elements are copied
+         * if one of the two vectors keeps them inline.
+         *
+         * @param other The vector to exchange the contents with.
+         */
+        void swap(small_vector & other) {
+            if (is_inline() || other.is_inline()) {
+                small_vector tmp(other);
+                other = *this;
+                *this = tmp;
+            } else {
+                base::swap(other);
+            }
+        }
+
+        /**
+         * Returns whether the elements are currently stored inside of this object.
+         *
+         * @return Whether the inline buffer is used.
+         */
+        bool is_inline() const {
+            return base::data() == reinterpret_cast<const T *>(small_vector_buffer<T, N>::storage.bytes);
+        }
+
+    private:
+        /**
+         * Binds the allocator of the vector to the inline buffer of this instance, and starts
+         * using the buffer.
+         */
+        void useBuffer() {
+            base::allocatorReference().bind(this);
+            base::reserve(N);
+        }
+    };
+
+    template<class T, std::size_t N, class Alloc>
+    void swap(small_vector<T, N, Alloc> & lhs, small_vector<T, N, Alloc> & rhs) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //FT_CONTAINERS_SMALL_VECTOR_HPP
@@ -5,48 +5,499 @@
 #ifndef FT_CONTAINERS_TREE_HPP
 #define FT_CONTAINERS_TREE_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 #include <stdexcept>
+#include "memory.hpp"
+#include "offset_ptr.hpp"
 #include "TreeIterator.hpp"
 
 namespace ft {
+    /**
+     * @brief The counters collected by the tree_stats policy.
+     */
+    struct tree_counters {
+        std::size_t comparisons;
+        std::size_t rotations;
+        std::size_t recolours;
+        std::size_t fixups;
+        std::size_t searches;
+        std::size_t search_steps;
+
+        tree_counters(): comparisons(0), rotations(0), recolours(0), fixups(0), searches(0), search_steps(0) {}
+
+        /**
+         * Returns the average count of nodes visited by a search.
+         *
+         * @return The average search depth, zero if nothing has been searched.
+         */
+        double average_search_depth() const {
+            return searches == 0 ? 0 : static_cast<double>(search_steps) / static_cast<double>(searches);
+        }
+    };
+
+    /**
+     * @brief The shape of a tree together with its hot path counters.
+     *
+     * The black height is the greatest count of black nodes on a path from the root to a
+     * leaf; black_balanced tells whether all of these paths have the same count, as they
+     * should. The counters stay zero unless the tree uses the tree_stats policy.
+     */
+    struct tree_statistics {
+        std::size_t   height;
+        std::size_t   black_height;
+        bool          black_balanced;
+        std::size_t   node_count;
+        tree_counters counters;
+
+        tree_statistics(): height(0), black_height(0), black_balanced(true), node_count(0), counters() {}
+    };
+
+    /**
+     * @brief The statistics policy collecting nothing.
+     */
+    class no_tree_stats {
+    public:
+        void comparison() {}
+        void rotation()   {}
+        void recolour()   {}
+        void fixup()      {}
+        void search()     {}
+        void step()       {}
+        void reset()      {}
+
+        tree_counters counters() const { return tree_counters(); }
+    };
+
+    /**
+     * @brief The statistics policy counting the work done by the tree.
+     *
+     * A fixup is one step of the rebalancing after an insertion or a deletion, a search step
+     * is a node visited while looking for a value. The counters are updated atomically, as
+     * the lookups of a const tree may be done by several threads at once, for example by the
+     * parallel algorithms.
+     */
+    class tree_stats {
+    public:
+        void comparison() { add(values.comparisons);  }
+        void rotation()   { add(values.rotations);    }
+        void recolour()   { add(values.recolours);    }
+        void fixup()      { add(values.fixups);       }
+        void search()     { add(values.searches);     }
+        void step()       { add(values.search_steps); }
+        void reset()      { values = tree_counters(); }
+
+        tree_counters counters() const {
+            tree_counters result;
+            result.comparisons  = __atomic_load_n(&values.comparisons,  __ATOMIC_RELAXED);
+            result.rotations    = __atomic_load_n(&values.rotations,    __ATOMIC_RELAXED);
+            result.recolours    = __atomic_load_n(&values.recolours,    __ATOMIC_RELAXED);
+            result.fixups       = __atomic_load_n(&values.fixups,       __ATOMIC_RELAXED);
+            result.searches     = __atomic_load_n(&values.searches,     __ATOMIC_RELAXED);
+            result.search_steps = __atomic_load_n(&values.search_steps, __ATOMIC_RELAXED);
+            return result;
+        }
+
+    private:
+        /**
+         * The counted values.
+         */
+        tree_counters values;
+
+        static void add(std::size_t & counter) { __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED); }
+    };
+
+    /**
+     * @brief The types a node of the tree can have.
+     */
+    struct NodeTypes {
+        enum Type {
+            /**
+             * Indicating the node is red.
+             */
+            RED,
+            /**
+             * Indicating the node is black.
+             */
+            BLACK,
+            /**
+             * Indicating the node is a NIL node (which are considered to be black).
+             */
+            NIL,
+            /**
+             * Indicating the node is a sentinel (which are considered to be black).
+             */
+            SENTINEL
+        };
+    };
+
+    /**
+     * @brief The node pointer policy storing plain pointers.
+     */
+    struct raw_pointers {
+        template<class T>
+        struct pointer {
+            typedef T * type;
+        };
+
+        /**
+         * Returns the word standing for the given target, stored at the given address.
+         */
+        static std::size_t encode(const void *, const void * target) { return reinterpret_cast<std::size_t>(target); }
+
+        /**
+         * Returns the target of the given word, stored at the given address.
+         */
+        static void * decode(const void *, std::size_t word) { return reinterpret_cast<void *>(word); }
+    };
+
+    /**
+     * @brief The node pointer policy storing the distances of the nodes from the links.
+     *
+     * The nodes of a tree using it, and the tree itself, stay valid when the memory holding
+     * them is mapped at another address, see offset_ptr and region_allocator.
+     */
+    struct offset_pointers {
+        template<class T>
+        struct pointer {
+            typedef offset_ptr<T> type;
+        };
+
+        static std::size_t encode(const void * holder, const void * target) {
+            return target == NULL ? 0 : reinterpret_cast<std::size_t>(target) - reinterpret_cast<std::size_t>(holder);
+        }
+
+        static void * decode(const void * holder, std::size_t word) {
+            return word == 0 ? NULL : reinterpret_cast<void *>(reinterpret_cast<std::size_t>(holder) + word);
+        }
+    };
+
+    /**
+     * @brief The link of a tree node to its parent and the type of the node.
+     *
+     * Both are stored in fields of their own, the type taking a whole word with padding.
+     *
+     * @tparam Node the type of the node
+     * @tparam Compact whether to pack the type into the parent pointer, see the specialization
+     * @tparam Pointers the node pointer policy, see raw_pointers and offset_pointers
+     */
+    template<class Node, bool Compact, class Pointers>
+    class NodeLinks: public NodeTypes {
+    public:
+        explicit NodeLinks(Type type): parentNode(NULL), nodeType(type) {}
+
+        Node * parent()                  const { return parentNode;   }
+        void   setParent(Node * parent)        { parentNode = parent; }
+        Type   type()                    const { return nodeType;     }
+        void   setType(Type type)              { nodeType = type;     }
+
+    private:
+        /**
+         * A pointer to the parent of this node.
+         */
+        typename Pointers::template pointer<Node>::type parentNode;
+        /**
+         * The type of this node.
+         */
+        Type                                            nodeType;
+    };
+
+    /**
+     * @brief The link of a tree node to its parent with the type of the node in its low bits.
+     *
+     * As nodes are aligned to at least four bytes, the two lowest bits of the address of the
+     * parent are always zero and hold the type instead, saving the word of the type field.
+     * So are the two lowest bits of the distance between two nodes.
+     *
+     * @tparam Node the type of the node
+     * @tparam Pointers the node pointer policy, encoding the parent
+     */
+    template<class Node, class Pointers>
+    class NodeLinks<Node, true, Pointers>: public NodeTypes {
+    public:
+        explicit NodeLinks(Type type): word(type) {}
+
+        NodeLinks(const NodeLinks & other): NodeTypes(other), word(other.type()) { setParent(other.parent()); }
+
+        NodeLinks & operator=(const NodeLinks & other) {
+            word = other.type();
+            setParent(other.parent());
+            return *this;
+        }
+
+        Node * parent()                  const { return static_cast<Node *>(Pointers::decode(this, word & ~typeMask)); }
+        void   setParent(Node * parent)        { word = Pointers::encode(this, parent) | (word & typeMask); }
+        Type   type()                    const { return static_cast<Type>(word & typeMask); }
+        void   setType(Type type)              { word = (word & ~typeMask) | type; }
+
+    private:
+        enum { typeMask = 3 };
+
+        /**
+         * Fails to compile if pointers may use the bits taken by the type.
+         */
+        typedef char alignmentCheck[__alignof__(void *) > typeMask ? 1 : -1];
+
+        /**
+         * The encoded parent combined with the type.
+         */
+        std::size_t word;
+    };
+
+    /**
+     * @brief The compile time options of the tree used by the map and the set.
+     *
+     * If InlineNodes is greater than zero, the first nodes (and the sentinels) are
+     * placed inside of the tree object itself, so that small containers do not need
+     * to allocate any memory. Once the inline nodes are exhausted, further nodes are
+     * obtained from the allocator. The inline nodes cannot change their owner: swapping
+     * two such containers copies the inline elements to allocated nodes first, which may
+     * throw and invalidates the iterators and references to the inline elements.
+     *
+     * The Stats policy is notified of every comparison, rotation, recolouring, rebalancing
+     * step and visited node. The default policy does nothing, so that the notifications
+     * are optimized away entirely; tree_stats counts them.
+     *
+     * If CompactNodes is true, the colour of a node is packed into its parent pointer, which
+     * saves a word per node.
+     *
+     * The Pointers policy defines how the nodes and the tree point to the nodes. With
+     * offset_pointers and a region_allocator, a whole map or set can be placed in a memory
+     * region shared by several processes; the inline nodes are not supported then, and the
+     * statistics policy must not collect anything for the tree to be searched read-only.
+     *
+     * @tparam InlineNodes the count of elements stored without allocation
+     * @tparam Stats the policy collecting the hot path counters, see tree_stats
+     * @tparam CompactNodes whether to pack the colour of the nodes into their parent pointer
+     * @tparam Pointers the node pointer policy, see raw_pointers and offset_pointers
+     */
+    template<std::size_t InlineNodes = 0, class Stats = no_tree_stats, bool CompactNodes = false, class Pointers = raw_pointers>
+    struct tree_options {
+        enum { inlineNodes = InlineNodes, compactNodes = CompactNodes };
+        typedef Stats    statsType;
+        typedef Pointers pointersType;
+
+    private:
+        enum { relocatable = is_same<Pointers, offset_pointers>::value };
+
+        /**
+         * Fails to compile if offset_pointers are combined with inline nodes or statistics.
+         */
+        typedef char relocatableCheck[!relocatable || (InlineNodes == 0 && is_same<Stats, no_tree_stats>::value) ? 1 : -1];
+    };
+
+    /**
+     * @brief Fixed storage for a number of nodes, located inside of the owning object.
+     *
+     * Released nodes are kept in a free list threaded through the unused slots.
+     *
+     * @tparam Node the type of the stored nodes
+     * @tparam Count the count of nodes that can be stored
+     */
+    template<class Node, std::size_t Count>
+    class InlineNodePool {
+    public:
+        InlineNodePool(): freeList(NULL), used(0) {}
+
+        /**
+         * Returns an unused slot or NULL if all slots are in use.
+         *
+         * @return The address of an unconstructed node or NULL.
+         */
+        Node * acquire() {
+            if (freeList != NULL) {
+                void * slot = freeList;
+                freeList = *static_cast<void **>(slot);
+                return static_cast<Node *>(slot);
+            } else if (used < Count) {
+                return reinterpret_cast<Node *>(storage.bytes) + used++;
+            }
+            return NULL;
+        }
+
+        /**
+         * Returns the given slot to this pool if it belongs to it.
+         *
+         * @param node The address of an already destroyed node.
+         * @return Whether the node belonged to this pool.
+         */
+        bool release(Node * node) {
+            if (!owns(node)) return false;
+            *reinterpret_cast<void **>(node) = freeList;
+            freeList = node;
+            return true;
+        }
+
+        /**
+         * Returns whether the given node is located in this pool.
+         *
+         * @param node The node to be checked.
+         * @return Whether the node is one of the slots of this pool.
+         */
+        bool owns(const Node * node) const {
+            const Node * begin = reinterpret_cast<const Node *>(storage.bytes);
+            return node >= begin && node < begin + Count;
+        }
+
+        /**
+         * Stores the addresses of the slots currently in use into the given array.
+         *
+         * @param nodes The array, with room for Count nodes.
+         * @return The count of stored nodes.
+         */
+        std::size_t inUse(Node ** nodes) const {
+            bool released[Count] = {};
+            for (void * slot = freeList; slot != NULL; slot = *static_cast<void **>(slot)) {
+                released[static_cast<Node *>(slot) - reinterpret_cast<const Node *>(storage.bytes)] = true;
+            }
+            std::size_t n = 0;
+            for (std::size_t i = 0; i < used; ++i) {
+                if (!released[i]) nodes[n++] = const_cast<Node *>(reinterpret_cast<const Node *>(storage.bytes)) + i;
+            }
+            return n;
+        }
+
+    private:
+        /**
+         * The raw storage of the nodes, aligned for any fundamental type.
+         */
+        union {
+            char          bytes[Count * sizeof(Node)];
+            void *        pointerAlign;
+            long          longAlign;
+            long double   floatAlign;
+        } storage;
+        /**
+         * The first released slot, whose first bytes point to the next one.
+         */
+        void *      freeList;
+        /**
+         * The count of slots handed out at least once.
+         */
+        std::size_t used;
+
+        InlineNodePool(const InlineNodePool &);
+        InlineNodePool & operator=(const InlineNodePool &);
+    };
+
+    /**
+     * The empty pool, used if no nodes should be stored inline.
+     *
+     * @tparam Node the type of the nodes
+     */
+    template<class Node>
+    class InlineNodePool<Node, 0> {
+    public:
+        Node *      acquire()                  { return NULL;  }
+        bool        release(Node *)            { return false; }
+        bool        owns(const Node *)   const { return false; }
+        std::size_t inUse(Node **)       const { return 0;     }
+    };
+
+    /**
+     * @brief Runs the subtree builds of a bulk load one after the other on the calling thread.
+     */
+    struct serial_executor {
+        /**
+         * Returns the depth below which the subtrees are built as independent tasks, zero as
+         * the whole tree is built at once.
+         *
+         * @return the split depth
+         */
+        std::size_t depth() const { return 0; }
+
+        /**
+         * Calls the given body once for all tasks.
+         *
+         * @param count the count of tasks
+         * @param body the body, called with the first and past the last index of the tasks
+         */
+        template<class Body>
+        void operator()(std::size_t count, Body & body) const { body(0, count); }
+    };
+
+    /**
+     * @brief A part of a tree handed to one thread: either a single node or a whole subtree.
+     *
+     * The parts are visited in order by recursing into the children, without following the
+     * parent pointers, so that no two threads touch the same node.
+     *
+     * @tparam Reference the reference type passed to the visiting function
+     * @tparam NodeType the pointer type of the nodes
+     */
+    template<class Reference, class NodeType>
+    class tree_range {
+    public:
+        tree_range(): node(NULL), subtree(false) {}
+
+        /**
+         * Constructs a range of the given node or of its whole subtree.
+         *
+         * @param node the node
+         * @param subtree whether the subtree of the node belongs to the range
+         */
+        tree_range(NodeType node, bool subtree): node(node), subtree(subtree) {}
+
+        /**
+         * Returns whether this range covers a whole subtree rather than a single node.
+         *
+         * @return whether this range is a subtree
+         */
+        bool is_subtree() const { return subtree; }
+
+        /**
+         * Calls the given function for every element of this range, in order.
+         *
+         * @param f the function to be called
+         */
+        template<class Function>
+        void visit(Function & f) const {
+            if (subtree) {
+                visitSubtree(node, f);
+            } else {
+                f(static_cast<Reference>(node->content));
+            }
+        }
+
+    private:
+        /**
+         * The node or the root of the subtree.
+         */
+        NodeType node;
+        /**
+         * Whether the whole subtree of the node belongs to this range.
+         */
+        bool     subtree;
+
+        template<class Function>
+        static void visitSubtree(NodeType node, Function & f) {
+            for (; node != NULL && node->type() != NodeTypes::SENTINEL; node = node->right) {
+                visitSubtree(node->left, f);
+                f(static_cast<Reference>(node->content));
+            }
+        }
+    };
+
     /**
      * This class holds a tree structure.
      *
      * @tparam T the type of the contents to be held by this tree
      * @tparam Compare the comparator function that is used to sort the contents
      * @tparam Allocator the allocator used to rebind
+     * @tparam Options the compile time options, see tree_options
      */
     template<class T,
              class Compare,
-             class Allocator>
+             class Allocator,
+             class Options = tree_options<> >
     class Tree {
         /**
          * A node of the tree.
          */
-        struct Node {
-            /**
-             * The types specifying the type of the node.
-             */
-            enum Type {
-                /**
-                 * Indicating the node is red.
-                 */
-                RED,
-                /**
-                 * Indicating the node is black.
-                 */
-                BLACK,
-                /**
-                 * Indicating the node is a NIL node (which are considered to be black).
-                 */
-                NIL,
-                /**
-                 * Indicating the node is a sentinel (which are considered to be black).
-                 */
-                SENTINEL
-            };
+        struct Node: public NodeLinks<Node, Options::compactNodes, typename Options::pointersType> {
+            typedef NodeLinks<Node, Options::compactNodes, typename Options::pointersType> links;
+            typedef typename Options::pointersType::template pointer<Node>::type         link;
 
             /**
              * The type of the value the node can hold.
@@ -56,19 +507,11 @@ namespace ft {
             /**
              * A pointer to the left child of this node.
              */
-            Node * left;
-            /**
-             * A pointer to the parent of this node.
-             */
-            Node * root;
+            link left;
             /**
              * A pointer to the right child of this node.
              */
-            Node * right;
-            /**
-             * The type of this node.
-             */
-            Type type;
+            link right;
             /**
              * The actual content of this node.
              */
@@ -82,7 +525,7 @@ namespace ft {
              * @param sentinel Optionally marks this node as a sentinel node.
              */
             explicit Node(bool sentinel = false)
-                : left(NULL), root(NULL), right(NULL), type(sentinel ? SENTINEL : RED), content() {}
+                : links(sentinel ? links::SENTINEL : links::RED), left(NULL), right(NULL), content() {}
 
             /**
              * @brief Initializes this node using the given content.
@@ -92,7 +535,7 @@ namespace ft {
              * @param content The content this node will store.
              */
             explicit Node(const valueType & content)
-                : left(NULL), root(NULL), right(NULL), type(RED), content(content) {}
+                : links(links::RED), left(NULL), right(NULL), content(content) {}
 
             /**
              * Copy constructor. Initializes all values with the ones of the other Node.
@@ -100,7 +543,7 @@ namespace ft {
              * @param other The other node to copy the values from.
              */
             Node(const Node & other)
-                : left(other.left), root(other.root), right(other.right), type(other.type), content(other.content) {}
+                : links(other), left(other.left), right(other.right), content(other.content) {}
 
             /**
              * Trivial destructor.
@@ -119,12 +562,12 @@ namespace ft {
              */
             Node & operator=(const Node & other) {
                 if (&other != this) {
+                    links::operator=(other);
                     left    = other.left;
-                    root    = other.root;
                     right   = other.right;
-                    type    = other.type;
                     content = other.content;
                 }
+                return *this;
             }
         };
 
@@ -153,6 +596,14 @@ namespace ft {
          * The const type of the used Nodes.
          */
         typedef Node * const                                     constNodeType;
+        /**
+         * The type of the pointers to the nodes stored in the nodes and in this tree.
+         */
+        typedef typename Node::link                              linkType;
+        /**
+         * The const type of the stored pointers to the nodes.
+         */
+        typedef const linkType                                   constLinkType;
         /**
          * The type of the compare object.
          */
@@ -170,9 +621,11 @@ namespace ft {
          * Default constructor. Initializes this tree with a NULL root node.
          *
          * @param comp The compare object to be used to sort the contents of this tree.
+         * @param allocator The allocator of the container, rebound to allocate the nodes.
          */
-        explicit Tree(Compare comp)
-            : root(NULL), beginSentinel(emptySentinel()), endSentinel(beginSentinel), alloc(allocatorType()), compare(comp), count(0) {
+        explicit Tree(Compare comp, Allocator allocator = Allocator())
+            : root(NULL), beginSentinel(NULL), endSentinel(NULL), alloc(allocator), compare(comp), count(0) {
+            beginSentinel = endSentinel = emptySentinel();
         }
 
         /**
@@ -180,11 +633,15 @@ namespace ft {
          *
          * @param other The other tree to copy.
          */
-        Tree(const Tree & other): root(NULL), alloc(other.alloc), compare(other.compare), count(other.count) {
-            if (other.root != NULL) {
-                recursiveCopy(&root, other.root, NULL);
-                beginSentinel = findBeginSentinel();
-                endSentinel   = findEndSentinel();
+        Tree(const Tree & other)
+            : root(NULL), beginSentinel(NULL), endSentinel(NULL), alloc(other.alloc), compare(other.compare), count(other.count) {
+            nodeType recycled = NULL,
+                     sentinel = NULL;
+            try {
+                copyNodesFrom(other, recycled, sentinel);
+            } catch (...) {
+                discardRecycled(recycled);
+                throw;
             }
         }
 
@@ -194,20 +651,36 @@ namespace ft {
        ~Tree() { internalClear(); }
 
         /**
-         * Copy assignment operator. Clears this tree and copies the given tree deeply.
+         * @brief Copy assignment operator. Copies the given tree deeply.
+         *
+         * The nodes of this tree are destroyed but kept, the copies are constructed in them.
+         * Only the difference in size is allocated or deallocated, assigning a tree of the
+         * same size does not use the allocator at all. The end sentinel is kept as it is, so
+         * that this tree is left empty without constructing anything if copying an element
+         * throws.
          *
          * @param other The other tree to copy.
          * @return A reference to this tree.
          */
         Tree & operator=(const Tree & other) {
             if (&other != this) {
-                internalClear();
-                if (other.root != NULL) {
-                    recursiveCopy(&root, other.root, NULL);
-                    beginSentinel = findBeginSentinel();
-                    endSentinel   = findEndSentinel();
+                nodeType recycled = NULL,
+                         sentinel = endSentinel;
+                if (root != NULL) {
+                    unlink(sentinel);
+                    harvest(root, recycled);
+                }
+                root = beginSentinel = endSentinel = NULL;
+                count = 0;
+                try {
+                    copyNodesFrom(other, recycled, sentinel);
+                } catch (...) {
+                    beginSentinel = endSentinel = sentinel;
+                    discardRecycled(recycled);
+                    throw;
                 }
                 count = other.count;
+                discardRecycled(recycled);
             }
             return *this;
         }
@@ -217,20 +690,46 @@ namespace ft {
          */
         void clear() {
             if (root != NULL) {
-                recursiveDestroy(root);
+                if (!skipDestroy) {
+                    recursiveDestroy(root);
+                }
                 beginSentinel = endSentinel;
-                endSentinel->root = endSentinel->left = endSentinel->right = NULL;
+                endSentinel->left = endSentinel->right = NULL;
+                endSentinel->setParent(NULL);
                 root = NULL;
             }
             count = 0;
         }
 
         /**
-         * Swaps this tree with the other one.
+         * @brief Swaps this tree with the other one.
+         *
+         * If Options has inline nodes, the elements stored in them are copied to allocated
+         * nodes first: the swap may then throw, in which case both trees are left unchanged,
+         * and the iterators and references to those elements are invalidated.
          *
          * @param other The other tree to exchange the values with.
          */
         void swap(Tree & other) {
+            if (Options::inlineNodes > 0 && &other != this) {
+                // The nodes stored inline cannot change their owner, they are moved out first.
+                nodeType originals[inlineSlots == 0 ? 1 : inlineSlots],
+                         copies[inlineSlots == 0 ? 1 : inlineSlots],
+                         otherOriginals[inlineSlots == 0 ? 1 : inlineSlots],
+                         otherCopies[inlineSlots == 0 ? 1 : inlineSlots];
+
+                const std::size_t n = copyInlineNodes(originals, copies);
+                std::size_t otherN;
+                try {
+                    otherN = other.copyInlineNodes(otherOriginals, otherCopies);
+                } catch (...) {
+                    discardNodes(copies, n);
+                    throw;
+                }
+                adoptCopies(originals, copies, n);
+                other.adoptCopies(otherOriginals, otherCopies, otherN);
+            }
+            std::swap(alloc, other.alloc);
             nodeType tmpRoot          = root,
                      tmpBeginSentinel = beginSentinel,
                      tmpEndSentinel   = endSentinel;
@@ -307,7 +806,7 @@ namespace ft {
          * @return An iterator pointing to the found node or to the end of the tree.
          */
         iteratorType find(const contentType & value) {
-            ft::pair<nodeType, nodeType *> result = find(value, &root);
+            ft::pair<nodeType, linkType *> result = search(value);
             if (*result.second == result.first && result.first != NULL) {
                 return iteratorType(result.first);
             }
@@ -324,7 +823,7 @@ namespace ft {
          * @return An iterator pointing to the found node or to the end of the tree.
          */
         constIteratorType find(const contentType & value) const {
-            ft::pair<constNodeType, constNodeType *> result = find(value, &root);
+            ft::pair<constNodeType, constLinkType *> result = search(value);
             if (*result.second == result.first && result.first != NULL) {
                 return constIteratorType(result.first);
             }
@@ -339,7 +838,7 @@ namespace ft {
          * @return A reference to that content.
          */
         contentType & findOrThrow(const contentType & c) {
-            ft::pair<nodeType, nodeType *> result = find(c, &root);
+            ft::pair<nodeType, linkType *> result = search(c);
             if (*result.second == result.first && result.first != NULL) {
                 return result.first->content;
             }
@@ -354,7 +853,7 @@ namespace ft {
          * @return A reference to that content.
          */
         const contentType & findOrThrow(const contentType & c) const {
-            ft::pair<constNodeType, constNodeType *> result = find(c, &root);
+            ft::pair<constNodeType, constLinkType *> result = search(c);
             if (*result.second == result.first && result.first != NULL) {
                 return result.first->content;
             }
@@ -370,7 +869,7 @@ namespace ft {
          * @return A reference to the content of the found or inserted node.
          */
         contentType & findOrInsert(const contentType & c) {
-            ft::pair<nodeType, nodeType *> result = find(c, &root);
+            ft::pair<nodeType, linkType *> result = search(c);
             if (*result.second == result.first && result.first != NULL) {
                 return result.first->content;
             } else {
@@ -395,7 +894,7 @@ namespace ft {
          * existing node and a boolean value representing whether the value has been inserted or not.
          */
         ft::pair<iteratorType, bool> insert(const contentType & value) {
-            ft::pair<nodeType, nodeType *> position = find(value, &root);
+            ft::pair<nodeType, linkType *> position = search(value);
             return coreInsert(position, value);
         }
 
@@ -411,7 +910,7 @@ namespace ft {
         iteratorType insert(iteratorType hint, const contentType & value) {
             if (hint.base() != beginSentinel) {
                 --hint;
-                const bool lower          = compare(value, *hint);
+                const bool lower          = isLess(value, *hint);
                 const bool insertSideNull = (lower ? hint.base()->left : hint.base()->right) == NULL;
                 if (canInsert(hint.base(), value) && insertSideNull) {
                     return coreInsert(ft::make_pair(hint.base(), lower ? &hint.base()->left : &hint.base()->right), value).first;
@@ -438,44 +937,44 @@ namespace ft {
                 nodeType            movedUp = NULL;
                 typename Node::Type wasType = Node::SENTINEL;
                 if (toDelete->left == NULL || toDelete->right == NULL) {
-                    wasType = toDelete->type;
+                    wasType = toDelete->type();
                     movedUp = deleteSingleChildNode(toDelete);
                 } else if (toDelete->right == endSentinel) {
-                    wasType = toDelete->type;
-                    rotateReplace(toDelete->root, toDelete, toDelete->left);
+                    wasType = toDelete->type();
+                    rotateReplace(toDelete->parent(), toDelete, toDelete->left);
                     movedUp = toDelete->left;
-                    endSentinel->root = movedUp;
+                    endSentinel->setParent(movedUp);
                     findMaximum(movedUp)->right = endSentinel;
                 } else {
                     nodeType successor = findMinimum(toDelete->right);
 
-                    nodeType            tmpRoot  = toDelete->root;
+                    nodeType            tmpRoot  = toDelete->parent();
                     nodeType            tmpLeft  = toDelete->left;
                     nodeType            tmpRight = toDelete->right;
-                    typename Node::Type tmpType  = toDelete->type;
+                    typename Node::Type tmpType  = toDelete->type();
 
                     toDelete->left  = successor->left;
-                    toDelete->type  = successor->type;
+                    toDelete->setType(successor->type());
                     toDelete->right = successor->right;
-                    toDelete->root  = successor->root == toDelete ? successor : successor->root;
+                    toDelete->setParent(successor->parent() == toDelete ? successor : successor->parent());
 
                     successor->left  = tmpLeft;
-                    successor->root  = tmpRoot;
-                    successor->type  = tmpType;
+                    successor->setParent(tmpRoot);
+                    successor->setType(tmpType);
                     successor->right = tmpRight == successor ? toDelete : tmpRight;
 
                     if (successor->left != NULL) {
-                        successor->left->root = successor;
+                        successor->left->setParent(successor);
                     }
                     if (successor->right != NULL) {
-                        successor->right->root = successor;
+                        successor->right->setParent(successor);
                     }
-                    if (successor->root != NULL) {
-                        (toDelete == successor->root->right ? successor->root->right : successor->root->left) = successor;
+                    if (successor->parent() != NULL) {
+                        (toDelete == successor->parent()->right ? successor->parent()->right : successor->parent()->left) = successor;
                     }
 
                     movedUp = deleteSingleChildNode(toDelete);
-                    wasType = toDelete->type;
+                    wasType = toDelete->type();
                     if (toDelete == root) {
                         root = successor;
                     }
@@ -483,10 +982,10 @@ namespace ft {
                 deleteNode(toDelete);
                 if (wasType != Node::RED) {
                     rebalanceDelete(movedUp);
-                    if (movedUp->type == Node::NIL) {
-                        rotateReplace(movedUp->root, movedUp, NULL);
+                    if (movedUp->type() == Node::NIL) {
+                        rotateReplace(movedUp->parent(), movedUp, NULL);
                         alloc.destroy(movedUp);
-                        alloc.deallocate(movedUp, sizeof(Node));
+                        deallocateNode(movedUp);
                     }
                 }
                 --count;
@@ -541,6 +1040,260 @@ namespace ft {
             return constIteratorType(upperBound(value, root));
         }
 
+        /**
+         * Returns the memory taken by the nodes of this tree. Everything but the contents of
+         * the nodes, including the sentinels, is counted as overhead.
+         *
+         * @return The payload and the overhead in bytes.
+         */
+        memory_report memoryUsage() const {
+            const sizeType sentinels = endSentinel == NULL ? 0 : beginSentinel == endSentinel ? 1 : 2;
+            return memory_report(count * sizeof(T), count * (sizeof(Node) - sizeof(T)) + sentinels * sizeof(Node));
+        }
+
+        /**
+         * Returns the shape of this tree and the counters of the statistics policy. Measuring
+         * the height visits every node.
+         *
+         * @return The statistics of this tree.
+         */
+        tree_statistics statistics() const {
+            tree_statistics result;
+            result.height     = measure(root, result.black_height, result.black_balanced);
+            result.node_count = count;
+            result.counters   = stats.counters();
+            return result;
+        }
+
+        /**
+         * Resets the counters of the statistics policy.
+         */
+        void resetStatistics() { stats.reset(); }
+
+        /**
+         * @brief Cuts this tree into disjoint ranges, written to the given output in order.
+         *
+         * The nodes above the given depth become ranges of their own, the nodes at the given
+         * depth ranges of their whole subtree. As the tree is balanced, there are at most
+         * 2^(depth + 1) - 1 ranges, the subtrees holding similar counts of elements.
+         *
+         * @param depth the depth of the subtrees
+         * @param out the output of the ranges
+         * @return the end of the output
+         */
+        template<class Range, class OutputIt>
+        OutputIt split(sizeType depth, OutputIt out) const {
+            return splitNode<Range>(root, depth, out);
+        }
+
+        /**
+         * @brief Builds the nodes of a sorted range bottom up.
+         *
+         * The range is cut at its middle element recursively, which becomes the parent of
+         * the trees built from both halves, so the tree is as balanced as possible. All nodes
+         * are black, except for the ones on the last level if it is not full. The subtrees
+         * below the split depth do not depend on each other and can be built concurrently,
+         * the nodes above them and the sentinels are added by finish. If copying an element
+         * throws, the subtrees built so far are destroyed with the loader, the tree stays empty.
+         *
+         * @tparam RandomIt the type of the iterators of the range
+         */
+        template<class RandomIt>
+        class BulkLoad {
+        public:
+            /**
+             * Clears the given tree and prepares loading the given range into it. The nodes
+             * are only built concurrently if allocating them is thread safe, that is by the
+             * std::allocator without nodes stored inline.
+             *
+             * @param tree the tree to be loaded
+             * @param first the beginning of the range, sorted and free of equivalent elements
+             * @param count the length of the range
+             * @param depth the requested split depth
+             */
+            BulkLoad(Tree & tree, RandomIt first, sizeType count, sizeType depth)
+                : tree(tree), first(first), count(count), depth(concurrentNodes ? (depth < 16 ? depth : 16) : 0),
+                  redDepth(0), bounds(NULL), roots(NULL) {
+                tree.clear();
+                for (sizeType full = count + 1; full > 1; full /= 2) ++redDepth;
+                bounds = new sizeType[2 * subtrees()];
+                try {
+                    roots = new nodeType[subtrees()]();
+                } catch (...) {
+                    delete[] bounds;
+                    throw;
+                }
+                sizeType index = 0;
+                collect(0, count, 0, index);
+            }
+
+           ~BulkLoad() {
+                for (sizeType i = 0; i < subtrees(); ++i) {
+                    if (roots[i] != NULL) tree.recursiveDestroy(roots[i]);
+                }
+                delete[] roots;
+                delete[] bounds;
+            }
+
+            /**
+             * Returns the count of the independent subtrees.
+             *
+             * @return the count of the subtrees
+             */
+            sizeType subtrees() const { return sizeType(1) << depth; }
+
+            /**
+             * Builds the given subtrees.
+             *
+             * @param begin the index of the first subtree
+             * @param end the index past the last subtree
+             */
+            void operator()(std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    sizeType unused = 0;
+                    roots[i] = build(bounds[2 * i], bounds[2 * i + 1], depth, unused, false);
+                }
+            }
+
+            /**
+             * Builds the nodes above the subtrees, then attaches the sentinels.
+             */
+            void finish() {
+                if (count == 0) return;
+
+                sizeType index = 0;
+                nodeType top   = build(0, count, 0, index, true);
+                nodeType begin;
+                try {
+                    begin = tree.emptySentinel();
+                } catch (...) {
+                    tree.recursiveDestroy(top);
+                    throw;
+                }
+                nodeType minimum = top, maximum = top;
+                for (; minimum->left  != NULL; minimum = minimum->left);
+                for (; maximum->right != NULL; maximum = maximum->right);
+                minimum->left = begin;
+                begin->setParent(minimum);
+                maximum->right = tree.endSentinel;
+                tree.endSentinel->setParent(maximum);
+                tree.beginSentinel = begin;
+                tree.root          = top;
+                tree.count         = count;
+            }
+
+        private:
+            /**
+             * Whether the nodes may be allocated by several threads at once.
+             */
+            enum { concurrentNodes = is_same<allocatorType, std::allocator<Node> >::value && Options::inlineNodes == 0 };
+
+            Tree &     tree;
+            RandomIt   first;
+            sizeType   count;
+            /**
+             * The depth of the roots of the independent subtrees.
+             */
+            sizeType   depth;
+            /**
+             * The depth of the red nodes, the count of the full levels.
+             */
+            sizeType   redDepth;
+            /**
+             * The bounds of the part of the range of every subtree.
+             */
+            sizeType * bounds;
+            /**
+             * The built subtrees not yet linked into the tree.
+             */
+            nodeType * roots;
+
+            BulkLoad(const BulkLoad &);
+            BulkLoad & operator=(const BulkLoad &);
+
+            /**
+             * Stores the bounds of the subtrees at the split depth below the given part.
+             */
+            void collect(sizeType low, sizeType high, sizeType level, sizeType & index) {
+                if (level == depth) {
+                    bounds[2 * index]     = low;
+                    bounds[2 * index + 1] = high;
+                    ++index;
+                } else if (low == high) {
+                    collect(low, low, level + 1, index);
+                    collect(low, low, level + 1, index);
+                } else {
+                    const sizeType middle = low + (high - low) / 2;
+                    collect(low, middle, level + 1, index);
+                    collect(middle + 1, high, level + 1, index);
+                }
+            }
+
+            /**
+             * Builds the tree of the given part of the range. Above the split depth, the
+             * subtrees already built are linked in instead.
+             *
+             * @param low the index of the first element
+             * @param high the index past the last element
+             * @param level the depth of the root of the tree to be built
+             * @param index the index of the next built subtree
+             * @param top whether the nodes above the split depth are built
+             * @return the root of the built tree, NULL if the part is empty
+             */
+            nodeType build(sizeType low, sizeType high, sizeType level, sizeType & index, bool top) {
+                if (top && level == depth) {
+                    nodeType subtree = roots[index];
+                    roots[index++] = NULL;
+                    return subtree;
+                }
+                if (low == high) {
+                    if (top) index += sizeType(1) << (depth - level);
+                    return NULL;
+                }
+                const sizeType middle = low + (high - low) / 2;
+                nodeType left = build(low, middle, level + 1, index, top);
+                nodeType node = NULL;
+                try {
+                    node = tree.allocateNode();
+                    try {
+                        tree.alloc.construct(node, Node(first[middle]));
+                    } catch (...) {
+                        tree.deallocateNode(node);
+                        throw;
+                    }
+                } catch (...) {
+                    if (left != NULL) tree.recursiveDestroy(left);
+                    throw;
+                }
+                node->setType(level == redDepth ? Node::RED : Node::BLACK);
+                node->left = left;
+                if (left != NULL) left->setParent(node);
+                try {
+                    node->right = build(middle + 1, high, level + 1, index, top);
+                } catch (...) {
+                    tree.recursiveDestroy(node);
+                    throw;
+                }
+                if (node->right != NULL) node->right->setParent(node);
+                return node;
+            }
+        };
+
+        /**
+         * Replaces the contents of this tree by the given sorted range, building the nodes
+         * bottom up without any comparison or rotation.
+         *
+         * @param first the beginning of the range, sorted and free of equivalent elements
+         * @param last the end of the range
+         * @param executor runs the builds of the subtrees, see serial_executor
+         */
+        template<class RandomIt, class Executor>
+        void assignSorted(RandomIt first, RandomIt last, Executor & executor) {
+            BulkLoad<RandomIt> load(*this, first, static_cast<sizeType>(last - first), executor.depth());
+            executor(load.subtrees(), load);
+            load.finish();
+        }
+
         /**
          * Returns the maximal count of nodes this tree can hold.
          *
@@ -553,31 +1306,274 @@ namespace ft {
         }
 
     private:
+        /**
+         * Whether the nodes can be abandoned instead of being destroyed one by one, as their
+         * destruction does nothing and the allocator releases its memory in bulk.
+         */
+        enum { skipDestroy = allocator_has_trivial_deallocate<allocatorType>::value
+                          && is_trivially_destructible<T>::value
+                          && Options::inlineNodes == 0 };
+        /**
+         * The count of nodes stored inside of this object, including both sentinels.
+         */
+        enum { inlineSlots = Options::inlineNodes == 0 ? 0 : Options::inlineNodes + 2 };
+
+        /**
+         * @brief The allocator of the nodes together with the nodes stored inside of the tree.
+         *
+         * The pool is a base class, so that the empty one takes no space. Copies share the
+         * allocator but never the pool, every tree keeps its own slots.
+         */
+        class NodeAllocator: public allocatorType, public InlineNodePool<Node, inlineSlots> {
+        public:
+            typedef InlineNodePool<Node, inlineSlots> poolType;
+
+            template<class A>
+            explicit NodeAllocator(const A & allocator): allocatorType(allocator), poolType() {}
+            NodeAllocator(const NodeAllocator & other): allocatorType(other), poolType() {}
+
+            NodeAllocator & operator=(const NodeAllocator & other) {
+                allocatorType::operator=(other);
+                return *this;
+            }
+
+            poolType & pool() { return *this; }
+        };
+
         /**
          * The root Node of this tree.
          */
-        nodeType      root;
+        linkType      root;
         /**
          * A pointer to the element preceding the first element of this tree.
          */
-        nodeType      beginSentinel;
+        linkType      beginSentinel;
         /**
          * A pointer to the element past the last element of this tree.
          */
-        nodeType      endSentinel;
+        linkType      endSentinel;
         /**
          * The allocator used to allocate nodes.
          */
-        allocatorType alloc;
+        NodeAllocator alloc;
         /**
          * The compare object used to sort the contents of this tree.
          */
         compareType   compare;
+        /**
+         * The statistics policy, notified from the hot paths. Mutable, as searches are counted too.
+         */
+        mutable typename Options::statsType stats;
         /**
          * The count of stored elements.
          */
         sizeType      count;
 
+        /**
+         * Compares the given values using the compare object, notifying the statistics policy.
+         *
+         * @param lhs The left hand side value.
+         * @param rhs The right hand side value.
+         * @return Whether the left hand side value is ordered before the right hand side one.
+         */
+        inline bool isLess(const contentType & lhs, const contentType & rhs) const {
+            stats.comparison();
+            return compare(lhs, rhs);
+        }
+
+        /**
+         * Changes the colour of the given node, notifying the statistics policy.
+         *
+         * @param node The node to be recoloured.
+         * @param type The new colour of the node.
+         */
+        inline void paint(nodeType node, typename Node::Type type) {
+            stats.recolour();
+            node->setType(type);
+        }
+
+        /**
+         * Returns storage for a single node, taken from the inline pool if possible.
+         *
+         * @return The address of an unconstructed node.
+         */
+        inline nodeType allocateNode() {
+            nodeType node = alloc.pool().acquire();
+            return node != NULL ? node : alloc.allocate(1);
+        }
+
+        /**
+         * Releases the storage of the given already destroyed node.
+         *
+         * @param node The node whose storage to release.
+         */
+        inline void deallocateNode(nodeType node) {
+            if (!alloc.pool().release(node)) {
+                alloc.deallocate(node, 1);
+            }
+        }
+
+        /**
+         * Copies the nodes of this tree stored inline into allocated storage. The copies are
+         * linked into this tree by adoptCopies().
+         *
+         * @param originals Receives the nodes stored inline.
+         * @param copies Receives their copies.
+         * @return The count of copied nodes.
+         */
+        std::size_t copyInlineNodes(nodeType * originals, nodeType * copies) {
+            const std::size_t n = alloc.pool().inUse(originals);
+            std::size_t i = 0;
+            try {
+                for (; i < n; ++i) {
+                    copies[i] = alloc.allocate(1);
+                    try {
+                        alloc.construct(copies[i], *originals[i]);
+                    } catch (...) {
+                        alloc.deallocate(copies[i], 1);
+                        throw;
+                    }
+                }
+            } catch (...) {
+                discardNodes(copies, i);
+                throw;
+            }
+            return n;
+        }
+
+        /**
+         * Destroys and deallocates the given nodes, which do not belong to this tree.
+         *
+         * @param nodes The nodes.
+         * @param n The count of nodes.
+         */
+        void discardNodes(nodeType * nodes, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                alloc.destroy(nodes[i]);
+                alloc.deallocate(nodes[i], 1);
+            }
+        }
+
+        /**
+         * Replaces the given nodes of this tree by their copies, releasing the originals.
+         *
+         * @param originals The nodes of this tree.
+         * @param copies Their copies, made by copyInlineNodes().
+         * @param n The count of nodes.
+         */
+        void adoptCopies(nodeType * originals, nodeType * copies, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                nodeType from   = originals[i],
+                         to     = copies[i],
+                         parent = from->parent();
+
+                static_cast<typename Node::links &>(*to) = *from;
+                to->left  = from->left;
+                to->right = from->right;
+                if (parent != NULL) {
+                    (parent->left == from ? parent->left : parent->right) = to;
+                }
+                if (to->left  != NULL) to->left->setParent(to);
+                if (to->right != NULL) to->right->setParent(to);
+                if (root          == from) root          = to;
+                if (beginSentinel == from) beginSentinel = to;
+                if (endSentinel   == from) endSentinel   = to;
+                alloc.destroy(from);
+                alloc.pool().release(from);
+            }
+        }
+
+        /**
+         * Returns the first of the given destroyed nodes, or newly allocated storage if there
+         * is none left.
+         *
+         * @param recycled The list of destroyed nodes, linked through their first bytes.
+         * @return The address of an unconstructed node.
+         */
+        inline nodeType reuseNode(nodeType & recycled) {
+            if (recycled == NULL) {
+                return allocateNode();
+            }
+            nodeType node = recycled;
+            recycled = *reinterpret_cast<nodeType *>(static_cast<void *>(node));
+            return node;
+        }
+
+        /**
+         * Destroys the given node and all nodes below it, including the sentinels, and adds
+         * their storage to the given list.
+         *
+         * @param node The node to be destroyed.
+         * @param recycled The list of destroyed nodes, linked through their first bytes.
+         */
+        void harvest(nodeType node, nodeType & recycled) {
+            if (node->left  != NULL) { harvest(node->left,  recycled); }
+            if (node->right != NULL) { harvest(node->right, recycled); }
+            alloc.destroy(node);
+            *reinterpret_cast<nodeType *>(static_cast<void *>(node)) = recycled;
+            recycled = node;
+        }
+
+        /**
+         * Releases the storage of the given destroyed nodes.
+         *
+         * @param recycled The list of destroyed nodes, empty afterwards.
+         */
+        void discardRecycled(nodeType & recycled) {
+            while (recycled != NULL) {
+                deallocateNode(reuseNode(recycled));
+            }
+        }
+
+        /**
+         * Detaches the given node from its parent and from its children.
+         *
+         * @param node The node, or NULL.
+         */
+        static void unlink(nodeType node) {
+            if (node == NULL) return;
+            nodeType parent = node->parent();
+            if (parent != NULL) {
+                (parent->left == node ? parent->left : parent->right) = NULL;
+            }
+            node->left = node->right = NULL;
+            node->setParent(NULL);
+        }
+
+        /**
+         * Copies the nodes of the other tree into this empty tree, including the sentinels.
+         * If copying an element throws, the copies made so far are destroyed and added to
+         * the given list, this tree stays empty.
+         *
+         * @param other The tree to copy.
+         * @param recycled The destroyed nodes to be used before allocating new ones.
+         * @param sentinel An unlinked sentinel to be used for the first sentinel, or NULL.
+         *                 Set to NULL once used, kept unlinked if copying an element throws.
+         */
+        void copyNodesFrom(const Tree & other, nodeType & recycled, nodeType & sentinel) {
+            if (other.root != NULL) {
+                const nodeType spare = sentinel;
+                try {
+                    recursiveCopy(&root, other.root, NULL, recycled, sentinel);
+                } catch (...) {
+                    if (spare != NULL && sentinel == NULL) {
+                        unlink(spare);
+                        sentinel = spare;
+                    }
+                    if (root != NULL) {
+                        harvest(root, recycled);
+                        root = NULL;
+                    }
+                    throw;
+                }
+                beginSentinel = findBeginSentinel();
+                endSentinel   = findEndSentinel();
+            } else {
+                beginSentinel = endSentinel = sentinel != NULL ? sentinel : emptySentinel(reuseNode(recycled));
+                sentinel = NULL;
+            }
+        }
+
         /**
          * Clears everything in this tree, including any sentinels.
          */
@@ -585,7 +1581,7 @@ namespace ft {
             clear();
             if (endSentinel != NULL) {
                 alloc.destroy(endSentinel);
-                alloc.deallocate(endSentinel, sizeof(Node));
+                deallocateNode(endSentinel);
                 endSentinel = beginSentinel = NULL;
             }
         }
@@ -598,27 +1594,103 @@ namespace ft {
          * @param node The node to destroy.
          */
         void recursiveDestroy(nodeType node) {
-            if (node->left  != NULL)                                        { recursiveDestroy(node->left);  }
-            if (node->right != NULL && node->right->type != Node::SENTINEL) { recursiveDestroy(node->right); }
+            if (node->left  != NULL)                                          { recursiveDestroy(node->left);  }
+            if (node->right != NULL && node->right->type() != Node::SENTINEL) { recursiveDestroy(node->right); }
             alloc.destroy(node);
-            alloc.deallocate(node, sizeof(Node));
+            deallocateNode(node);
         }
 
         /**
          * @brief Copies the given (sub-) tree recursively.
          *
-         * Firstly the given node is copied. Then its children are copied.
+         * Firstly the given node is copied. Then its children are copied. A node is linked
+         * to its parent once it has been constructed, its children once they have been
+         * copied, so that a partial copy can be destroyed if copying an element throws.
          *
          * @param dst The destination of the new tree.
          * @param src The tree to copy.
+         * @param recycled The destroyed nodes to be used before allocating new ones.
+         * @param sentinel An unlinked sentinel to be used for the first sentinel, or NULL.
+         */
+        nodeType recursiveCopy(linkType * dst, nodeType src, nodeType parent, nodeType & recycled, nodeType & sentinel) {
+            nodeType node;
+            if (src->type() == Node::SENTINEL && sentinel != NULL) {
+                node     = sentinel;
+                sentinel = NULL;
+            } else {
+                node = reuseNode(recycled);
+                try {
+                    alloc.construct(node, *src);
+                } catch (...) {
+                    *reinterpret_cast<nodeType *>(static_cast<void *>(node)) = recycled;
+                    recycled = node;
+                    throw;
+                }
+            }
+            node->left  = NULL;
+            node->right = NULL;
+            node->setParent(parent);
+            *dst = node;
+            if (src->left  != NULL) { recursiveCopy(&node->left,  src->left,  node, recycled, sentinel); }
+            if (src->right != NULL) { recursiveCopy(&node->right, src->right, node, recycled, sentinel); }
+            return node;
+        }
+
+        /**
+         * Writes the ranges of the subtree of the given node down to the given depth.
+         */
+        template<class Range, class OutputIt>
+        static OutputIt splitNode(nodeType node, sizeType depth, OutputIt out) {
+            if (node == NULL || node->type() == Node::SENTINEL) return out;
+            if (depth == 0) {
+                *out = Range(node, true);
+                return ++out;
+            }
+            out  = splitNode<Range>(node->left, depth - 1, out);
+            *out = Range(node, false);
+            return splitNode<Range>(node->right, depth - 1, ++out);
+        }
+
+        /**
+         * Searches the whole tree for the given content.
+         *
+         * @param c The content to be found.
+         * @return A pair with the node containing the element and an insertion point.
+         */
+        inline ft::pair<nodeType, linkType *> search(const contentType & c) {
+            stats.search();
+            return find(c, &root);
+        }
+
+        /**
+         * Searches the whole tree for the given content.
+         *
+         * @param c The content to be found.
+         * @return A pair with the node containing the element and an insertion point.
          */
-        nodeType recursiveCopy(nodeType * dst, nodeType src, nodeType parent) {
-            *dst = alloc.allocate(sizeof(Node));
-            alloc.construct(*dst, *src);
-            (*dst)->root = parent;
-            if (src->left  != NULL) { (*dst)->left  = recursiveCopy(&(*dst)->left,  src->left,  *dst); }
-            if (src->right != NULL) { (*dst)->right = recursiveCopy(&(*dst)->right, src->right, *dst); }
-            return *dst;
+        inline ft::pair<constNodeType, constLinkType *> search(const contentType & c) const {
+            stats.search();
+            return find(c, &root);
+        }
+
+        /**
+         * Returns the count of levels of the given (sub-) tree, the sentinels not counted, and
+         * measures the count of black nodes on every path from its root to a leaf.
+         *
+         * @param node The root of the (sub-) tree.
+         * @param blackHeight Set to the greatest count of black nodes on a path.
+         * @param balanced Cleared if two paths have different counts of black nodes.
+         * @return The height of the given (sub-) tree.
+         */
+        static sizeType measure(nodeType node, sizeType & blackHeight, bool & balanced) {
+            blackHeight = 0;
+            if (node == NULL || node->type() == Node::SENTINEL) return 0;
+            sizeType leftBlack, rightBlack;
+            const sizeType left  = measure(node->left,  leftBlack,  balanced),
+                           right = measure(node->right, rightBlack, balanced);
+            balanced    = balanced && leftBlack == rightBlack;
+            blackHeight = (leftBlack > rightBlack ? leftBlack : rightBlack) + (node->type() == Node::BLACK ? 1 : 0);
+            return 1 + (left > right ? left : right);
         }
 
         /**
@@ -631,15 +1703,16 @@ namespace ft {
          * @param begin The (sub-) tree to be searched.
          * @return A pair with the node containing the element and an insertion point.
          */
-        ft::pair<nodeType, nodeType *> find(const contentType & c, nodeType * begin) {
+        ft::pair<nodeType, linkType *> find(const contentType & c, linkType * begin) {
             if (*begin != NULL) {
-                if (compare(c, (*begin)->content)) {
-                    return ((*begin)->left == NULL || (*begin)->left->type == Node::SENTINEL)
-                    /* true:  */ ? ft::make_pair(*begin, &(*begin)->left)
+                stats.step();
+                if (isLess(c, (*begin)->content)) {
+                    return ((*begin)->left == NULL || (*begin)->left->type() == Node::SENTINEL)
+                    /* true:  */ ? ft::make_pair<nodeType, linkType *>(*begin, &(*begin)->left)
                     /* false: */ : find(c, &(*begin)->left);
-                } else if (compare((*begin)->content, c)) {
-                    return ((*begin)->right == NULL || (*begin)->right->type == Node::SENTINEL)
-                    /* true:  */ ? ft::make_pair(*begin, &(*begin)->right)
+                } else if (isLess((*begin)->content, c)) {
+                    return ((*begin)->right == NULL || (*begin)->right->type() == Node::SENTINEL)
+                    /* true:  */ ? ft::make_pair<nodeType, linkType *>(*begin, &(*begin)->right)
                     /* false: */ : find(c, &(*begin)->right);
                 }
             }
@@ -656,15 +1729,16 @@ namespace ft {
          * @param begin The (sub-) tree to be searched.
          * @return A pair with the node containing the element and an insertion point.
          */
-        ft::pair<constNodeType, constNodeType *> find(const contentType & c, constNodeType * begin) const {
+        ft::pair<constNodeType, constLinkType *> find(const contentType & c, constLinkType * begin) const {
             if (*begin != NULL) {
-                if (compare(c, (*begin)->content)) {
-                    return ((*begin)->left == NULL || (*begin)->left->type == Node::SENTINEL)
-                    /* true:  */ ? ft::make_pair<constNodeType, constNodeType *>(*begin, &(*begin)->left)
+                stats.step();
+                if (isLess(c, (*begin)->content)) {
+                    return ((*begin)->left == NULL || (*begin)->left->type() == Node::SENTINEL)
+                    /* true:  */ ? ft::make_pair<constNodeType, constLinkType *>(*begin, &(*begin)->left)
                     /* false: */ : find(c, &(*begin)->left);
-                } else if (compare((*begin)->content, c)) {
-                    return ((*begin)->right == NULL || (*begin)->right->type == Node::SENTINEL)
-                    /* true:  */ ? ft::make_pair<constNodeType, constNodeType *>(*begin, &(*begin)->right)
+                } else if (isLess((*begin)->content, c)) {
+                    return ((*begin)->right == NULL || (*begin)->right->type() == Node::SENTINEL)
+                    /* true:  */ ? ft::make_pair<constNodeType, constLinkType *>(*begin, &(*begin)->right)
                     /* false: */ : find(c, &(*begin)->right);
                 }
             }
@@ -701,11 +1775,11 @@ namespace ft {
          * @return Whether the value can be inserted according to the sorting at the given position.
          */
         inline bool canInsert(nodeType node, const contentType & value) {
-            while (node != root && node->root != NULL) {
-                if (!compare(value, node->content)) {
+            while (node != root && node->parent() != NULL) {
+                if (!isLess(value, node->content)) {
                     return false;
                 }
-                node = node->root;
+                node = node->parent();
             }
             return true;
         }
@@ -721,18 +1795,18 @@ namespace ft {
          * that already consists of the given value and a boolean value representing the information
          * whether the value has been inserted or not.
          */
-        ft::pair<iteratorType, bool> coreInsert(ft::pair<nodeType, nodeType *> position, const contentType & value) {
+        ft::pair<iteratorType, bool> coreInsert(ft::pair<nodeType, linkType *> position, const contentType & value) {
             if (position.first == NULL || position.first != *position.second) {
                 iteratorType retIt;
                 Node tmp(value);
-                tmp.root = position.first;
+                tmp.setParent(position.first);
                 if (isEmpty()) {
                     // Create the root and init sentinels
-                    *position.second = alloc.allocate(sizeof(Node));
+                    *position.second = allocateNode();
                     try {
                         alloc.construct(*position.second, tmp);
                     } catch (...) {
-                        alloc.deallocate(*position.second, sizeof(Node));
+                        deallocateNode(*position.second);
                         throw;
                     }
                     retIt = iteratorType(*position.second);
@@ -740,27 +1814,27 @@ namespace ft {
                         initSentinels();
                     } catch (...) {
                         alloc.destroy(*position.second);
-                        alloc.deallocate(*position.second, sizeof(Node));
+                        deallocateNode(*position.second);
                         throw;
                     }
                 } else {
                     // Make sure to not lose the sentinels
                     nodeType maybeSentinel = *position.second;
                     const bool right = maybeSentinel == position.first->right;
-                    nodeType newOne = alloc.allocate(sizeof(Node));
+                    nodeType newOne = allocateNode();
                     if (maybeSentinel != NULL) {
                         if (right) {
                             tmp.right = maybeSentinel;
                         } else {
                             tmp.left = maybeSentinel;
                         }
-                        maybeSentinel->root = newOne;
+                        maybeSentinel->setParent(newOne);
                     }
                     *position.second = newOne;
                     try {
                         alloc.construct(*position.second, tmp);
                     } catch (...) {
-                        alloc.deallocate(*position.second, sizeof(Node));
+                        deallocateNode(*position.second);
                         throw;
                     }
                     retIt = iteratorType(*position.second);
@@ -786,7 +1860,7 @@ namespace ft {
                 (parent->right == oldChild ? parent->right : parent->left) = newChild;
             }
             if (newChild != NULL) {
-                newChild->root = parent;
+                newChild->setParent(parent);
             }
         }
         
@@ -796,14 +1870,15 @@ namespace ft {
          * @param node The node to rotate around.
          */
         inline void rotateRight(nodeType node) {
-            nodeType parent    = node->root,
+            stats.rotation();
+            nodeType parent    = node->parent(),
                      leftChild = node->left;
             node->left = leftChild->right;
             if (leftChild->right != NULL) {
-                leftChild->right->root = node;
+                leftChild->right->setParent(node);
             }
             leftChild->right = node;
-            node->root = leftChild;
+            node->setParent(leftChild);
             rotateReplace(parent, node, leftChild);
         }
         
@@ -813,14 +1888,15 @@ namespace ft {
          * @param node The node to rotate around.
          */
         inline void rotateLeft(nodeType node) {
-            nodeType parent     = node->root,
+            stats.rotation();
+            nodeType parent     = node->parent(),
                      rightChild = node->right;
             node->right = rightChild->left;
             if (rightChild->left != NULL) {
-                rightChild->left->root = node;
+                rightChild->left->setParent(node);
             }
             rightChild->left = node;
-            node->root = rightChild;
+            node->setParent(rightChild);
             rotateReplace(parent, node, rightChild);
         }
 
@@ -831,7 +1907,7 @@ namespace ft {
          * @return The found uncle or NULL if not found.
          */
         inline nodeType getUncle(nodeType node) {
-            nodeType grandParent = node->root;
+            nodeType grandParent = node->parent();
             return grandParent->right == node ? grandParent->left : grandParent->right;
         }
         
@@ -846,20 +1922,20 @@ namespace ft {
          */
         inline nodeType deleteSingleChildNode(nodeType node) {
             if (node->right != NULL) {
-                rotateReplace(node->root, node, node->right);
+                rotateReplace(node->parent(), node, node->right);
                 return node->right;
             } else if (node->left != NULL) {
-                rotateReplace(node->root, node, node->left);
+                rotateReplace(node->parent(), node, node->left);
                 return node->left;
             } else {
                 nodeType newOne = NULL;
-                if (node->type != Node::RED) {
+                if (node->type() != Node::RED) {
                     Node tmp(true);
-                    tmp.type = Node::NIL;
-                    newOne = alloc.allocate(sizeof(Node));
+                    tmp.setType(Node::NIL);
+                    newOne = allocateNode();
                     alloc.construct(newOne, tmp);
                 }
-                rotateReplace(node->root, node, newOne);
+                rotateReplace(node->parent(), node, newOne);
                 return newOne;
             }
         }
@@ -872,11 +1948,12 @@ namespace ft {
         inline void rootDeletion() {
             alloc.destroy(root);
             alloc.destroy(beginSentinel);
-            alloc.deallocate(root,          sizeof(Node));
-            alloc.deallocate(beginSentinel, sizeof(Node));
+            deallocateNode(root);
+            deallocateNode(beginSentinel);
             root = NULL;
             beginSentinel = endSentinel;
-            endSentinel->right = endSentinel->left = endSentinel->root = NULL;
+            endSentinel->right = endSentinel->left = NULL;
+            endSentinel->setParent(NULL);
         }
         
         /**
@@ -889,7 +1966,7 @@ namespace ft {
         inline void deleteNode(nodeType node) {
             if (node != NULL) {
                 alloc.destroy(node);
-                alloc.deallocate(node, sizeof(Node));
+                deallocateNode(node);
             }
         }
         
@@ -899,20 +1976,21 @@ namespace ft {
          * @param node The inserted node.
          */
         void rebalance(nodeType node) {
-            nodeType parent = node->root;
-            if (parent == NULL || parent->type == Node::BLACK) {
+            stats.fixup();
+            nodeType parent = node->parent();
+            if (parent == NULL || parent->type() == Node::BLACK) {
                 return;
             }
-            nodeType grandParent = parent->root;
+            nodeType grandParent = parent->parent();
             if (grandParent == NULL) {
-                parent->type = Node::BLACK;
+                paint(parent, Node::BLACK);
                 return;
             }
             nodeType uncle = getUncle(parent);
-            if (uncle != NULL && uncle->type == Node::RED) {
-                parent->type = Node::BLACK;
-                grandParent->type = Node::RED;
-                uncle->type = Node::BLACK;
+            if (uncle != NULL && uncle->type() == Node::RED) {
+                paint(parent, Node::BLACK);
+                paint(grandParent, Node::RED);
+                paint(uncle, Node::BLACK);
                 rebalance(grandParent);
             } else if (parent == grandParent->left) {
                 if (node == parent->right) {
@@ -920,16 +1998,16 @@ namespace ft {
                     parent = node;
                 }
                 rotateRight(grandParent);
-                parent->type = Node::BLACK;
-                grandParent->type = Node::RED;
+                paint(parent, Node::BLACK);
+                paint(grandParent, Node::RED);
             } else {
                 if (node == parent->left) {
                     rotateRight(parent);
                     parent = node;
                 }
                 rotateLeft(grandParent);
-                parent->type = Node::BLACK;
-                grandParent->type = Node::RED;
+                paint(parent, Node::BLACK);
+                paint(grandParent, Node::RED);
             }
         }
 
@@ -939,8 +2017,8 @@ namespace ft {
          * @param node The node to be checked.
          * @return Whether the given node can be treaten as a black node.
          */
-        inline bool isBlack(nodeType node) { return node == NULL || node->type == Node::SENTINEL
-                                                                 || node->type == Node::BLACK;
+        inline bool isBlack(nodeType node) { return node == NULL || node->type() == Node::SENTINEL
+                                                                 || node->type() == Node::BLACK;
                                            }
         
         /**
@@ -950,8 +2028,8 @@ namespace ft {
          * @return Whether at least one of the children of the given node is a sentinel,
          */
         inline bool hasSentinel(nodeType node) {
-            return (node->left  != NULL && node->left->type  == Node::SENTINEL)
-                || (node->right != NULL && node->right->type == Node::SENTINEL);
+            return (node->left  != NULL && node->left->type()  == Node::SENTINEL)
+                || (node->right != NULL && node->right->type() == Node::SENTINEL);
         }
         
         /**
@@ -961,7 +2039,7 @@ namespace ft {
          * @return The sibling of the given node.
          */
         inline nodeType getSibling(nodeType node) {
-            nodeType parent = node->root;
+            nodeType parent = node->parent();
             return node == parent->left ? parent->right
                                         : parent->left;
         }
@@ -973,12 +2051,12 @@ namespace ft {
          * @param sibling The sibling of the given node.
          */
         inline void balanceRedSibling(nodeType node, nodeType sibling) {
-            sibling->type = Node::BLACK;
-            node->root->type = Node::RED;
-            if (node == node->root->left) {
-                rotateLeft(node->root);
+            paint(sibling, Node::BLACK);
+            paint(node->parent(), Node::RED);
+            if (node == node->parent()->left) {
+                rotateLeft(node->parent());
             } else {
-                rotateRight(node->root);
+                rotateRight(node->parent());
             }
         }
         
@@ -989,26 +2067,26 @@ namespace ft {
          * @param sibling The sibling of the given node.
          */
         inline void balanceRedSiblingBlackChild(nodeType node, nodeType sibling) {
-            const bool isLeft = node == node->root->left;
+            const bool isLeft = node == node->parent()->left;
             if (isLeft && isBlack(sibling->right)) {
-                sibling->left->type = Node::BLACK;
-                sibling->type       = Node::RED;
+                paint(sibling->left, Node::BLACK);
+                paint(sibling,       Node::RED);
                 rotateRight(sibling);
-                sibling = node->root->right;
+                sibling = node->parent()->right;
             } else if (!isLeft && isBlack(sibling->left)) {
-                sibling->right->type = Node::BLACK;
-                sibling->type        = Node::RED;
+                paint(sibling->right, Node::BLACK);
+                paint(sibling,        Node::RED);
                 rotateLeft(sibling);
-                sibling = node->root->left;
+                sibling = node->parent()->left;
             }
-            sibling->type    = node->root->type;
-            node->root->type = Node::BLACK;
+            paint(sibling,        node->parent()->type());
+            paint(node->parent(), Node::BLACK);
             if (isLeft) {
-                sibling->right->type = Node::BLACK;
-                rotateLeft(node->root);
+                paint(sibling->right, Node::BLACK);
+                rotateLeft(node->parent());
             } else {
-                sibling->left->type  = Node::BLACK;
-                rotateRight(node->root);
+                paint(sibling->left,  Node::BLACK);
+                rotateRight(node->parent());
             }
         }
         
@@ -1018,20 +2096,21 @@ namespace ft {
          * @param node The node where to begin the rebalancing.
          */
         void rebalanceDelete(nodeType node) {
+            stats.fixup();
             if (node == root) {
                 return;
             }
             nodeType sibling = getSibling(node);
-            if (sibling->type == Node::RED) {
+            if (sibling->type() == Node::RED) {
                 balanceRedSibling(node, sibling);
                 sibling = getSibling(node);
             }
             if (isBlack(sibling->left) && isBlack(sibling->right)) {
-                sibling->type = Node::RED;
-                if (node->root->type == Node::RED) {
-                    node->root->type = Node::BLACK;
+                paint(sibling, Node::RED);
+                if (node->parent()->type() == Node::RED) {
+                    paint(node->parent(), Node::BLACK);
                 } else {
-                    rebalanceDelete(node->root);
+                    rebalanceDelete(node->parent());
                 }
             } else {
                 balanceRedSiblingBlackChild(node, sibling);
@@ -1045,7 +2124,7 @@ namespace ft {
          */
         nodeType findBeginSentinel() {
             nodeType tmp = root;
-            for (; tmp != NULL && tmp->type != Node::SENTINEL && tmp->left != NULL; tmp = tmp->left);
+            for (; tmp != NULL && tmp->type() != Node::SENTINEL && tmp->left != NULL; tmp = tmp->left);
             return tmp;
         }
 
@@ -1056,7 +2135,7 @@ namespace ft {
          */
         nodeType findEndSentinel() {
             nodeType tmp = root;
-            for (; tmp != NULL && tmp->type != Node::SENTINEL && tmp->right != NULL; tmp = tmp->right);
+            for (; tmp != NULL && tmp->type() != Node::SENTINEL && tmp->right != NULL; tmp = tmp->right);
             return tmp;
         }
 
@@ -1066,12 +2145,21 @@ namespace ft {
          * @return A new sentinel node.
          */
         nodeType emptySentinel() {
+            return emptySentinel(allocateNode());
+        }
+
+        /**
+         * Constructs an empty sentinel node in the given storage.
+         *
+         * @param ret The storage of the sentinel.
+         * @return The new sentinel node.
+         */
+        nodeType emptySentinel(nodeType ret) {
             Node tmp(true);
-            nodeType ret = alloc.allocate(sizeof(Node));
             try {
                 alloc.construct(ret, tmp);
             } catch (...) {
-                alloc.deallocate(ret, sizeof(Node));
+                deallocateNode(ret);
                 throw;
             }
             return ret;
@@ -1082,9 +2170,9 @@ namespace ft {
          */
          void initSentinels() {
              root->left = emptySentinel();
-             root->left->root = root;
+             root->left->setParent(root);
              root->right = endSentinel;
-             endSentinel->root = root;
+             endSentinel->setParent(root);
              beginSentinel = root->left;
          }
 
@@ -1098,8 +2186,10 @@ namespace ft {
          */
         nodeType upperBound(const contentType & value, nodeType begin) const {
             nodeType result = end().base();
-            while (begin != NULL && begin->type != Node::SENTINEL) {
-                if (compare(value, begin->content)) {
+            stats.search();
+            while (begin != NULL && begin->type() != Node::SENTINEL) {
+                stats.step();
+                if (isLess(value, begin->content)) {
                     result = begin;
                     begin = begin->left;
                 } else {
@@ -1120,8 +2210,10 @@ namespace ft {
          */
         nodeType lowerBound(const contentType & value, nodeType begin) const {
             nodeType result = end().base();
-            while (begin != NULL && begin->type != Node::SENTINEL) {
-                if (!compare(begin->content, value)) {
+            stats.search();
+            while (begin != NULL && begin->type() != Node::SENTINEL) {
+                stats.step();
+                if (!isLess(begin->content, value)) {
                     result = begin;
                     begin = begin->left;
                 } else {
@@ -29,6 +29,12 @@ namespace ft {
     typedef ft::integral_constant<bool, true> true_type;
     typedef ft::integral_constant<bool, false> false_type;
 
+    template<class T, class U>
+    struct is_same: public false_type {};
+
+    template<class T>
+    struct is_same<T, T>: public true_type {};
+
     template<class T>
     struct is_integral: public integral_constant<bool, false> {};
 
@@ -163,6 +169,25 @@ namespace ft {
 
     template<>
     struct is_integral<const volatile wchar_t>: public integral_constant<bool, true> {};
+
+    /**
+     * Whether destroying an object of type T does nothing, so that the destructor call can be omitted.
+     */
+    template<class T>
+    struct is_trivially_destructible: public integral_constant<bool, __has_trivial_destructor(T)> {};
+
+    /**
+     * Whether default initializing an object of type T leaves its memory untouched.
+     */
+    template<class T>
+    struct is_trivially_default_constructible: public integral_constant<bool, __has_trivial_constructor(T)> {};
+
+    /**
+     * Whether objects of type T may be copied and assigned by copying their bytes.
+     */
+    template<class T>
+    struct is_trivially_copyable: public integral_constant<bool, __has_trivial_copy(T) && __has_trivial_assign(T)
+                                                                && __has_trivial_destructor(T)> {};
 }
 
 #endif //FT_CONTAINERS_TYPE_TRAITS_HPP
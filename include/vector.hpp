@@ -5,22 +5,110 @@
 #ifndef FT_CONTAINERS_VECTOR_HPP
 #define FT_CONTAINERS_VECTOR_HPP
 
+#include <cstring>
 #include <memory>
 #include <limits>
 #include <stdexcept>
 #include "algorithm.hpp"
 #include "iterator.hpp"
+#include "memory.hpp"
 #include "type_traits.hpp"
 
 namespace ft {
+    /**
+     * A growth policy for the vector, multiplying the capacity by Numerator / Denominator
+     * whenever more memory is needed. The memory is never released automatically.
+     *
+     * @tparam Numerator The numerator of the growth factor.
+     * @tparam Denominator The denominator of the growth factor.
+     */
+    template <std::size_t Numerator = 2, std::size_t Denominator = 1>
+    struct growth_factor {
+        /**
+         * Returns the capacity to be allocated in order to store at least the required count of objects.
+         *
+         * @param capacity The current capacity.
+         * @param required The count of objects that need to fit.
+         * @param maxSize The maximum count of objects.
+         * @param objectSize The size of one object in bytes.
+         * @return The new capacity.
+         */
+        static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t maxSize, std::size_t objectSize) {
+            (void) objectSize;
+            const std::size_t next = capacity > maxSize / Numerator * Denominator ? maxSize
+                                                                                  : capacity / Denominator * Numerator
+                                                                                  + capacity % Denominator * Numerator / Denominator;
+            return next < required ? required : next;
+        }
+
+        /**
+         * Returns the capacity the memory should be shrunk to after objects have been removed.
+         *
+         * @param size The count of remaining objects.
+         * @param capacity The current capacity.
+         * @return The capacity to shrink to, the current capacity to keep the memory.
+         */
+        static std::size_t shrink(std::size_t size, std::size_t capacity) {
+            (void) size;
+            return capacity;
+        }
+    };
+
+    /**
+     * A growth policy for the vector, using the Base policy until the memory reaches ThresholdBytes.
+     * Above that size, the memory grows by steps of ThresholdBytes, rounded to whole pages, so that
+     * a reallocation needs at most ThresholdBytes on top of the old and the new memory.
+     *
+     * @tparam ThresholdBytes The size in bytes from which on the memory grows linearly.
+     * @tparam PageSize The size of one page of memory in bytes.
+     * @tparam Base The growth policy used below the threshold.
+     */
+    template <std::size_t ThresholdBytes = (1 << 26), std::size_t PageSize = 4096, class Base = growth_factor<2, 1> >
+    struct page_growth {
+        static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t maxSize, std::size_t objectSize) {
+            if (capacity * objectSize < ThresholdBytes) {
+                return Base::grow(capacity, required, maxSize, objectSize);
+            }
+            const std::size_t step = ThresholdBytes / objectSize;
+            std::size_t next = capacity > maxSize - step ? maxSize : capacity + step;
+            if (next < required) {
+                next = required;
+            }
+            const std::size_t bytes = (next * objectSize + PageSize - 1) / PageSize * PageSize;
+            return bytes / objectSize > maxSize ? maxSize : bytes / objectSize;
+        }
+
+        static std::size_t shrink(std::size_t size, std::size_t capacity) {
+            return Base::shrink(size, capacity);
+        }
+    };
+
+    /**
+     * A growth policy for the vector, growing like the Base policy and releasing the spare memory
+     * once less than a quarter of it is used. The remaining capacity is twice the count of objects.
+     *
+     * @tparam Base The growth policy used to grow the memory.
+     */
+    template <class Base = growth_factor<2, 1> >
+    struct shrink_hysteresis {
+        static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t maxSize, std::size_t objectSize) {
+            return Base::grow(capacity, required, maxSize, objectSize);
+        }
+
+        static std::size_t shrink(std::size_t size, std::size_t capacity) {
+            return size < capacity / 4 ? size * 2 : capacity;
+        }
+    };
+
     /**
      * A class that holds a number of objects of type T. It is similar to an array, yet
      * more flexible, as more elements can be appended or removed at any time.
      *
      * @tparam T The type of the contained objects.
      * @tparam Allocator The allocator to use, by default the std::allocator.
+     * @tparam Growth The policy deciding the capacity, by default doubling it.
      */
-    template <class T, class Allocator = std::allocator<T> >
+    template <class T, class Allocator = std::allocator<T>, class Growth = growth_factor<2, 1> >
     class vector {
     public:
         typedef T                                    value_type;
@@ -100,38 +188,64 @@ namespace ft {
          * Destroys this vector. Deallocates all memory previously hold by this instance.
          */
         ~vector() {
-            clear();
+            destroyRange(start, start + object_count);
             if (start != NULL) {
                 alloc.deallocate(start, memory_capacity);
             }
         }
 
         /**
-         * Removes all objects of this instance and copies the contents of the other given vector.
+         * Replaces the contents of this vector by a copy of the contents of the given vector. The
+         * objects already held are assigned to, the memory is reused if it is big enough.
          *
          * @param other The vector to copy.
          * @return A pointer to this instance.
          */
         vector & operator=(const vector & other) {
-            clear();
-            insert(begin(), other.begin(), other.end());
+            if (&other != this) {
+                assignForward(other.data(), other.size());
+            }
             return *this;
         }
 
         /**
-         * Removes all objects held by this vector and stores the given count amount of copies of
-         * the given value.
+         * Replaces the contents of this vector by the given count amount of copies of the given
+         * value. The objects already held are assigned to, the memory is reused if it is big enough.
          *
          * @param count The amount of copies to be stored.
          * @param value The value to be copied.
          */
         void assign(size_type count, const T & value) {
-            clear();
-            insert(begin(), count, value);
+            if (count > max_size()) throw std::length_error("ft::vector<T>::assign: Too much elements to be assigned!");
+            if (count > capacity()) {
+                pointer fresh = alloc.allocate(count);
+                pointer p     = fresh;
+                try {
+                    for (; p != fresh + count; ++p) {
+                        alloc.construct(p, value);
+                    }
+                } catch (...) {
+                    destroyRange(fresh, p);
+                    alloc.deallocate(fresh, count);
+                    throw;
+                }
+                replaceMemory(fresh, count);
+            } else if (count > size()) {
+                std::fill(start, start + object_count, value);
+                for (; object_count < count; ++object_count) {
+                    alloc.construct(start + object_count, value);
+                }
+            } else {
+                std::fill(start, start + count, value);
+                destroyRange(start + count, start + object_count);
+            }
+            object_count = count;
         }
 
         /**
-         * Removes all objects held by this vector and stores a copy of the given range.
+         * Replaces the contents of this vector by a copy of the given range. If the range can be
+         * passed more than once, the objects already held are assigned to and the memory is reused
+         * if it is big enough.
          *
          * @tparam InputIt The type of the iterator.
          * @param first The beginning of the range.
@@ -139,8 +253,7 @@ namespace ft {
          */
         template <class InputIt>
         void assign(InputIt first, InputIt last) {
-            clear();
-            insert(begin(), first, last);
+            assignDispatch(first, last, ft::integral_constant<bool, ft::is_integral<InputIt>::value>());
         }
 
         /**
@@ -364,31 +477,16 @@ namespace ft {
         void reserve(size_type new_cap) {
             if (new_cap > max_size()) throw std::length_error("ft::vector<T>::reserve: Too much elements to be reserved!");
             if (new_cap > capacity()) {
-                pointer tmp = alloc.allocate(new_cap);
-                for (pointer p = tmp; p < tmp + object_count; ++p) {
-                    try {
-                        alloc.construct(p, *(start + (p - tmp)));
-                    } catch (...) {
-                        --p;
-                        while (p --> tmp) {
-                            alloc.destroy(p);
-                        }
-                        alloc.deallocate(tmp, new_cap);
-                        throw;
-                    }
-                }
-                for (pointer p = start; p < start + object_count; ++p) {
-                    alloc.destroy(p);
-                }
-                /*for (iterator it = begin(); it != end(); ++it) {
-                    alloc.construct(tmp + (it - begin()), *it);
-                    alloc.destroy(start + (it - begin()));
-                }*/
-                if (start != NULL) {
-                    alloc.deallocate(start, memory_capacity);
-                }
-                memory_capacity = new_cap;
-                start = tmp;
+                reallocate(new_cap);
+            }
+        }
+
+        /**
+         * Releases the memory not used by the objects currently held by this vector.
+         */
+        void shrink_to_fit() {
+            if (capacity() > size()) {
+                reallocate(size());
             }
         }
 
@@ -402,12 +500,22 @@ namespace ft {
         }
 
         /**
-         * Removes all objects from this vector. The allocated memory stays allocated.
+         * Returns the memory taken by the objects and the unused capacity of this vector.
+         *
+         * @return The payload and the overhead in bytes.
+         */
+        memory_report memory_usage() const {
+            return memory_report(object_count * sizeof(T), (memory_capacity - object_count) * sizeof(T));
+        }
+
+        /**
+         * Removes all objects from this vector. The allocated memory stays allocated, unless
+         * the growth policy releases the spare memory, as shrink_hysteresis does.
          */
         void clear() {
-            while (size() > 0) {
-                pop_back();
-            }
+            destroyRange(start, start + object_count);
+            object_count = 0;
+            releaseSpare();
         }
 
         /**
@@ -463,7 +571,7 @@ namespace ft {
                 }
             }
             --object_count;
-            return pos;
+            return releaseSpare(pos);
         }
 
         /**
@@ -487,7 +595,7 @@ namespace ft {
                 }
             }
             object_count -= dist;
-            return end() - e;
+            return releaseSpare(end() - e);
         }
 
         /**
@@ -497,7 +605,7 @@ namespace ft {
          */
         void push_back(const T & value) {
             if (size() + 1 > capacity()) {
-                reserve((size() > 0 ? size() : 1) * 2);
+                reserve(recommend(size() + 1));
             }
             try {
                 alloc.construct(start + object_count, value);
@@ -513,6 +621,7 @@ namespace ft {
         void pop_back() {
             --object_count;
             alloc.destroy(start + object_count);
+            releaseSpare();
         }
 
         /**
@@ -526,14 +635,35 @@ namespace ft {
          */
         void resize(size_type count, T value = T()) {
             if (count < size()) {
-                while (size() > count) {
-                    pop_back();
-                }
+                destroyRange(start + count, start + object_count);
+                object_count = count;
+                releaseSpare();
             } else if (count > size()) {
                 insert(end(), count - size(), value);
             }
         }
 
+        /**
+         * Resizes this vector to hold count amount of objects. Unlike resize, the appended objects
+         * are default initialized: if T is trivially default constructible, their memory is left
+         * uninitialized, so they have to be assigned before being read.
+         *
+         * @param count The new count of elements.
+         */
+        void resize_uninitialized(size_type count) {
+            if (count < size()) {
+                destroyRange(start + count, start + object_count);
+                object_count = count;
+                releaseSpare();
+            } else if (count > size()) {
+                if (capacity() < count) {
+                    reserve(recommend(count));
+                }
+                defaultConstructRange(start + object_count, start + count, ft::is_trivially_default_constructible<T>());
+                object_count = count;
+            }
+        }
+
         /**
          * Exchanges the contents of this vector with the contents of the given other vector.
          *
@@ -551,6 +681,14 @@ namespace ft {
             other.memory_capacity = tmpMC;
         }
 
+    protected:
+        /**
+         * Returns the allocator used by this instance, for derived containers to adjust it.
+         *
+         * @return The allocator used by this instance.
+         */
+        Allocator & allocatorReference() { return alloc; }
+
     private:
         /**
          * The allocator to be used for all memory related operations.
@@ -572,12 +710,177 @@ namespace ft {
          */
         size_type object_count;
 
+        template<class Integer>
+        void assignDispatch(Integer count, Integer value, ft::true_type) {
+            assign(static_cast<size_type>(count), static_cast<T>(value));
+        }
+
+        template<class InputIt>
+        void assignDispatch(InputIt first, InputIt last, ft::false_type) {
+            assignRange(first, last, typename ft::iterator_traits<InputIt>::iterator_category());
+        }
+
+        template<class InputIt>
+        void assignRange(InputIt first, InputIt last, std::forward_iterator_tag) {
+            assignForward(unwrap(first), static_cast<size_type>(ft::distance(first, last)));
+        }
+
+        template<class InputIt>
+        void assignRange(InputIt first, InputIt last, ft::forward_iterator_tag) {
+            assignForward(unwrap(first), static_cast<size_type>(ft::distance(first, last)));
+        }
+
         template<class InputIt>
-        void insertRand(iterator pos, InputIt first, InputIt last) {
+        void assignRange(InputIt first, InputIt last, std::input_iterator_tag) {
+            clear();
+            insertInput(begin(), first, last);
+        }
+
+        template<class InputIt>
+        void assignRange(InputIt first, InputIt last, ft::input_iterator_tag) {
+            clear();
+            insertInput(begin(), first, last);
+        }
+
+        /**
+         * Returns the given iterator, or the pointer it wraps if it is an iterator of a vector, so
+         * that contiguous ranges can be copied in bulk.
+         *
+         * @param it The iterator.
+         * @return The iterator or the pointer wrapped by it.
+         */
+        template<class InputIt>
+        static InputIt       unwrap(InputIt it)                      { return it;        }
+        static const_pointer unwrap(pointer it)                      { return it;        }
+        static const_pointer unwrap(__wrap_iter<pointer> it)         { return it.base(); }
+        static const_pointer unwrap(__wrap_iter<const_pointer> it)   { return it.base(); }
+
+        /**
+         * Replaces the contents of this vector by a copy of the given count of objects. The first
+         * objects are assigned to the ones already held, the remaining ones are constructed or the
+         * spare ones destroyed. New memory is allocated only if the capacity is too small.
+         *
+         * @param first The beginning of the objects to be copied.
+         * @param count The count of objects to be copied.
+         */
+        template<class ForwardIt>
+        void assignForward(ForwardIt first, size_type count) {
+            if (count > max_size()) throw std::length_error("ft::vector<T>::assign: Too much elements to be assigned!");
+            if (count > capacity()) {
+                pointer fresh = alloc.allocate(count);
+                try {
+                    constructCopies(fresh, first, count);
+                } catch (...) {
+                    alloc.deallocate(fresh, count);
+                    throw;
+                }
+                replaceMemory(fresh, count);
+            } else if (count > size()) {
+                first = assignCopies(start, first, object_count);
+                constructCopies(start + object_count, first, count - object_count);
+            } else {
+                assignCopies(start, first, count);
+                destroyRange(start + count, start + object_count);
+            }
+            object_count = count;
+        }
+
+        /**
+         * Destroys the objects, releases the memory and takes the given memory instead, which
+         * already holds the new objects.
+         *
+         * @param memory The new memory.
+         * @param new_cap The capacity of the new memory.
+         */
+        void replaceMemory(pointer memory, size_type new_cap) {
+            destroyRange(start, start + object_count);
+            if (start != NULL) {
+                alloc.deallocate(start, memory_capacity);
+            }
+            start           = memory;
+            memory_capacity = new_cap;
+        }
+
+        /**
+         * Assigns copies of the given count of objects to the objects at the given destination.
+         *
+         * @param dst The objects to be assigned to.
+         * @param first The beginning of the objects to be copied.
+         * @param count The count of objects.
+         * @return An iterator past the copied objects.
+         */
+        template<class ForwardIt>
+        static ForwardIt assignCopies(pointer dst, ForwardIt first, size_type count) {
+            for (; count > 0; --count, ++dst, ++first) {
+                *dst = *first;
+            }
+            return first;
+        }
+
+        static const_pointer assignCopies(pointer dst, const_pointer first, size_type count) {
+            return assignCopies(dst, first, count, ft::is_trivially_copyable<T>());
+        }
+
+        static const_pointer assignCopies(pointer dst, const_pointer first, size_type count, ft::true_type) {
+            if (count > 0) {
+                std::memmove(static_cast<void *>(dst), static_cast<const void *>(first), count * sizeof(T));
+            }
+            return first + count;
+        }
+
+        static const_pointer assignCopies(pointer dst, const_pointer first, size_type count, ft::false_type) {
+            return assignCopies<const_pointer>(dst, first, count);
+        }
+
+        /**
+         * Copy constructs the given count of objects into the given uninitialized memory. If a
+         * constructor throws, the objects constructed so far are destroyed.
+         *
+         * @param dst The uninitialized memory.
+         * @param first The beginning of the objects to be copied.
+         * @param count The count of objects.
+         */
+        template<class ForwardIt>
+        void constructCopies(pointer dst, ForwardIt first, size_type count) {
+            pointer p = dst;
+            try {
+                for (; p != dst + count; ++p, ++first) {
+                    alloc.construct(p, *first);
+                }
+            } catch (...) {
+                destroyRange(dst, p);
+                throw;
+            }
+        }
+
+        void constructCopies(pointer dst, const_pointer first, size_type count) {
+            constructCopies(dst, first, count, ft::is_trivially_copyable<T>());
+        }
+
+        void constructCopies(pointer dst, const_pointer first, size_type count, ft::true_type) {
+            if (count > 0) {
+                std::memcpy(static_cast<void *>(dst), static_cast<const void *>(first), count * sizeof(T));
+            }
+        }
+
+        void constructCopies(pointer dst, const_pointer first, size_type count, ft::false_type) {
+            constructCopies<const_pointer>(dst, first, count);
+        }
+
+        /**
+         * Inserts a copy of the given multi-pass range. The range is measured beforehand, so that
+         * the memory is reserved and the following objects are moved only once.
+         *
+         * @param pos The position where to insert the objects.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        template<class ForwardIt>
+        void insertForward(iterator pos, ForwardIt first, ForwardIt last) {
             long p = pos - begin();
             size_type count = ft::distance(first, last);
             if (capacity() < size() + count) {
-                reserve(capacity() * 2 < size() + count ? size() + count : capacity() * 2);
+                reserve(recommend(size() + count));
             }
             iterator src = end() - 1;
             iterator dst = end() + count - 1;
@@ -597,21 +900,37 @@ namespace ft {
             object_count += count;
         }
 
+        /**
+         * Inserts a copy of the given single-pass range. The objects are appended first and then
+         * rotated into place, so that the following objects are moved only once.
+         *
+         * @param pos The position where to insert the objects.
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
         template<class InputIt>
         void insertInput(iterator pos, InputIt first, InputIt last) {
-            for (; first != last; ++first) {
-                pos = insert(pos, *first) + 1;
+            const difference_type offset  = pos - begin();
+            const size_type       oldSize = size();
+            try {
+                for (; first != last; ++first) {
+                    push_back(*first);
+                }
+            } catch (...) {
+                erase(begin() + oldSize, end());
+                throw;
             }
+            ft::rotate(begin() + offset, begin() + oldSize, end());
         }
 
         template<class InputIt>
-        void coreInsert(iterator pos, InputIt first, InputIt last, std::random_access_iterator_tag) {
-            insertRand(pos, first, last);
+        void coreInsert(iterator pos, InputIt first, InputIt last, std::forward_iterator_tag) {
+            insertForward(pos, first, last);
         }
 
         template<class InputIt>
-        void coreInsert(iterator pos, InputIt first, InputIt last, ft::random_access_iterator_tag) {
-            insertRand(pos, first, last);
+        void coreInsert(iterator pos, InputIt first, InputIt last, ft::forward_iterator_tag) {
+            insertForward(pos, first, last);
         }
 
         template<class InputIt>
@@ -638,7 +957,7 @@ namespace ft {
             }
             long p = pos - begin();
             if (capacity() < size() + count) {
-                reserve(capacity() * 2 < size() + count ? size() + count : capacity() * 2);
+                reserve(recommend(size() + count));
             }
             iterator src = end() - 1;
             iterator dst = end() + count - 1;
@@ -659,6 +978,127 @@ namespace ft {
             return src - count;
         }
 
+        /**
+         * Returns the capacity to be reserved according to the growth policy in order to store the
+         * required count of objects.
+         *
+         * @param required The count of objects that need to fit.
+         * @return The capacity to be reserved.
+         */
+        inline size_type recommend(size_type required) const {
+            if (required > max_size()) throw std::length_error("ft::vector<T>::reserve: Too much elements to be reserved!");
+            return Growth::grow(capacity(), required, max_size(), sizeof(T));
+        }
+
+        /**
+         * Shrinks the memory if the growth policy asks to do so.
+         */
+        inline void releaseSpare() {
+            const size_type new_cap = Growth::shrink(size(), capacity());
+            if (new_cap < capacity()) {
+                reallocate(new_cap);
+            }
+        }
+
+        /**
+         * Shrinks the memory if the growth policy asks to do so.
+         *
+         * @param pos An iterator to be preserved.
+         * @return The given iterator, pointing into the possibly moved memory.
+         */
+        inline iterator releaseSpare(iterator pos) {
+            const difference_type offset = pos - begin();
+            releaseSpare();
+            return begin() + offset;
+        }
+
+        /**
+         * Moves the objects of this vector into newly allocated memory of the given capacity, which
+         * needs to be at least the size of this vector.
+         *
+         * @param new_cap The capacity of the new memory.
+         */
+        void reallocate(size_type new_cap) {
+            reallocate(new_cap, ft::integral_constant<bool, ft::allocator_can_reallocate<Allocator>::value
+                                                         && ft::is_trivially_relocatable<T>::value>());
+        }
+
+        /**
+         * Lets the allocator move the memory, the objects are relocated by their bytes.
+         *
+         * @param new_cap The capacity of the new memory.
+         */
+        void reallocate(size_type new_cap, ft::true_type) {
+            if (start == NULL || new_cap == 0) {
+                reallocate(new_cap, ft::false_type());
+            } else {
+                start = alloc.reallocate(start, memory_capacity, new_cap);
+                memory_capacity = new_cap;
+            }
+        }
+
+        /**
+         * Copies the objects into newly allocated memory.
+         *
+         * @param new_cap The capacity of the new memory.
+         */
+        void reallocate(size_type new_cap, ft::false_type) {
+            pointer tmp = new_cap > 0 ? alloc.allocate(new_cap) : NULL;
+            for (pointer p = tmp; p < tmp + object_count; ++p) {
+                try {
+                    alloc.construct(p, *(start + (p - tmp)));
+                } catch (...) {
+                    destroyRange(tmp, p);
+                    alloc.deallocate(tmp, new_cap);
+                    throw;
+                }
+            }
+            destroyRange(start, start + object_count);
+            if (start != NULL) {
+                alloc.deallocate(start, memory_capacity);
+            }
+            memory_capacity = new_cap;
+            start = tmp;
+        }
+
+        /**
+         * Destroys the objects in the given range. Compiles to nothing if T is trivially destructible.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        inline void destroyRange(pointer first, pointer last) {
+            destroyRange(first, last, ft::is_trivially_destructible<T>());
+        }
+
+        inline void destroyRange(pointer, pointer, ft::true_type) {}
+
+        inline void destroyRange(pointer first, pointer last, ft::false_type) {
+            for (; first != last; ++first) {
+                alloc.destroy(first);
+            }
+        }
+
+        /**
+         * Default initializes the objects in the given uninitialized range.
+         *
+         * @param first The beginning of the range.
+         * @param last The end of the range.
+         */
+        inline void defaultConstructRange(pointer, pointer, ft::true_type) {}
+
+        void defaultConstructRange(pointer first, pointer last, ft::false_type) {
+            pointer p = first;
+            try {
+                for (; p != last; ++p) {
+                    alloc.construct(p, T());
+                }
+            } catch (...) {
+                destroyRange(first, p);
+                throw;
+            }
+        }
+
         template<class InputIt>
         void initInputRange(InputIt first, InputIt last) {
             for (; first != last; ++first) {
@@ -674,7 +1114,6 @@ namespace ft {
                 try {
                     vector::alloc.construct(i, *first);
                 } catch (...) {
-                    --i;
                     while (i --> start) {
                         vector::alloc.destroy(i);
                     }
@@ -705,47 +1144,38 @@ namespace ft {
         }
     };
 
-    template <class T, class Alloc>
-    bool operator==(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs) {
-        if (lhs.size() != rhs.size()) return false;
-        for (typename vector<T, Alloc>::const_iterator lit = lhs.begin(),
-                                                       rit = rhs.begin();
-             lit != lhs.end();
-             ++lit, ++rit) {
-            if (*lit != *rit) {
-                return false;
-            }
-        }
-        return true;
+    template <class T, class Alloc, class Growth>
+    bool operator==(const vector<T, Alloc, Growth> & lhs, const vector<T, Alloc, Growth> & rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template <class T, class Alloc>
-    bool operator!=(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs) {
+    template <class T, class Alloc, class Growth>
+    bool operator!=(const vector<T, Alloc, Growth> & lhs, const vector<T, Alloc, Growth> & rhs) {
         return !(lhs == rhs);
     }
 
-    template <class T, class Alloc>
-    bool operator<(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs) {
-        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    template <class T, class Alloc, class Growth>
+    bool operator<(const vector<T, Alloc, Growth> & lhs, const vector<T, Alloc, Growth> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) < 0;
     }
 
-    template <class T, class Alloc>
-    bool operator<=(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs) {
-        return lhs < rhs || lhs == rhs;
+    template <class T, class Alloc, class Growth>
+    bool operator<=(const vector<T, Alloc, Growth> & lhs, const vector<T, Alloc, Growth> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) <= 0;
     }
 
-    template <class T, class Alloc>
-    bool operator>(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs) {
-        return rhs < lhs;
+    template <class T, class Alloc, class Growth>
+    bool operator>(const vector<T, Alloc, Growth> & lhs, const vector<T, Alloc, Growth> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) > 0;
     }
 
-    template <class T, class Alloc>
-    bool operator>=(const vector<T, Alloc> & lhs, const vector<T, Alloc> & rhs) {
-        return rhs < lhs || lhs == rhs;
+    template <class T, class Alloc, class Growth>
+    bool operator>=(const vector<T, Alloc, Growth> & lhs, const vector<T, Alloc, Growth> & rhs) {
+        return ft::lexicographical_compare_3way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()) >= 0;
     }
 
-    template <class T, class Alloc>
-    void swap(vector<T, Alloc> & lhs, vector<T, Alloc> & rhs) {
+    template <class T, class Alloc, class Growth>
+    void swap(vector<T, Alloc, Growth> & lhs, vector<T, Alloc, Growth> & rhs) {
         lhs.swap(rhs);
     }
 }
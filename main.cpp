@@ -22,13 +22,48 @@
 #include <set>
 #include "set.hpp"
 
+#include <deque>
+#include "deque.hpp"
+
+#include <queue>
+#include "queue.hpp"
+
+#include <algorithm>
+#include "algorithm.hpp"
+
+#include "frozen_map.hpp"
+#include "frozen_set.hpp"
+#include "small_vector.hpp"
+#include "concurrent.hpp"
+#include "parallel.hpp"
+#include "serialize.hpp"
+#include "region_allocator.hpp"
+#include "counting_allocator.hpp"
+#include "mmap_allocator.hpp"
+#include "incremental_vector.hpp"
+#include "arena_allocator.hpp"
+
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
 #include <string>
 #include <sstream>
+#include <pthread.h>
+#include <sched.h>
 
 #define ARRAY_SIZE 32000
 
+/**
+ * Whether the ft containers are tested. Their extensions are then tested as well, against
+ * the same results computed using the standard library in the std build.
+ */
+static const bool testingFt = ft::is_same<NS::vector<int>, ft::vector<int> >::value;
+
 /**
  * An array with some strings.
  */
@@ -124,6 +159,17 @@ static inline void setup() {
     std::cout << std::boolalpha;
 }
 
+/**
+ * Compares the given pairs by their first value only.
+ *
+ * @param lhs The first pair.
+ * @param rhs The second pair.
+ * @return Whether the first value of the first pair is less.
+ */
+static inline bool compareFirst(const NS::pair<int, std::string> & lhs, const NS::pair<int, std::string> & rhs) {
+    return lhs.first < rhs.first;
+}
+
 static inline void testVector() {
     NS::vector<std::string> vec;
     std::cout << "Vector assign" << std::endl;
@@ -134,6 +180,45 @@ static inline void testVector() {
     vec.insert(vec.begin(), stringArray + 1, stringArray + ARRAY_SIZE - 1);
     printInfo(vec);
 
+    std::cout << "Vector insert bidirectional range" << std::endl;
+    NS::set<std::string> sorted(stringArray, stringArray + ARRAY_SIZE / 8);
+    vec.insert(vec.begin() + vec.size() / 2, sorted.begin(), sorted.end());
+    printInfo(vec);
+
+    std::cout << "Vector insert input range" << std::endl;
+    std::istringstream words("Some words read one after another from a stream");
+    vec.insert(vec.begin() + 3, std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    printInfo(vec);
+
+    std::cout << "Vector assign shorter range" << std::endl;
+    vec.assign(stringArray + 5, stringArray + 25);
+    printInfo(vec);
+
+    std::cout << "Vector assign longer vector" << std::endl;
+    vec = NS::vector<std::string>(stringArray, stringArray + 40);
+    printInfo(vec);
+
+    std::cout << "Vector assign count" << std::endl;
+    vec.assign(7, stringArray[3]);
+    printInfo(vec);
+
+    std::cout << "Vector assign own range" << std::endl;
+    vec.insert(vec.end(), stringArray, stringArray + 10);
+    vec.assign(vec.begin() + 4, vec.end() - 2);
+    printInfo(vec);
+
+    std::cout << "Vector assign input range" << std::endl;
+    std::istringstream more("Words assigned from a stream");
+    vec.assign(std::istream_iterator<std::string>(more), std::istream_iterator<std::string>());
+    printInfo(vec);
+
+    std::cout << "Vector assign integers" << std::endl;
+    NS::vector<int> numbers(intArray, intArray + 30);
+    numbers.assign(intArray + 10, intArray + 15);
+    printInfo(numbers);
+    numbers.assign(12, 5);
+    printInfo(numbers);
+
     std::cout << "Vector clear" << std::endl;
     vec.clear();
     std::cout << "Empty: " << vec.empty() << std::endl
@@ -142,6 +227,372 @@ static inline void testVector() {
 
 }
 
+static inline void testVectorResize() {
+    std::cout << "Vector resize_uninitialized" << std::endl;
+    if (testingFt) {
+        ft::vector<int> numbers(intArray, intArray + 100);
+        numbers.resize_uninitialized(300);
+        for (int i = 100; i < 300; ++i) {
+            numbers[i] = intArray[ARRAY_SIZE - i];
+        }
+        printInfo(numbers);
+        numbers.resize_uninitialized(50);
+        printInfo(numbers);
+
+        ft::vector<std::string> strings(stringArray, stringArray + 10);
+        strings.resize_uninitialized(20);
+        printInfo(strings);
+        strings.resize_uninitialized(5);
+        printInfo(strings);
+    } else {
+        std::vector<int> numbers(intArray, intArray + 100);
+        numbers.resize(300);
+        for (int i = 100; i < 300; ++i) {
+            numbers[i] = intArray[ARRAY_SIZE - i];
+        }
+        printInfo(numbers);
+        numbers.resize(50);
+        printInfo(numbers);
+
+        std::vector<std::string> strings(stringArray, stringArray + 10);
+        strings.resize(20);
+        printInfo(strings);
+        strings.resize(5);
+        printInfo(strings);
+    }
+}
+
+/**
+ * Appends the given count of integers to the given vector and checks after every reallocation
+ * that the capacity has grown as computed by the given function.
+ *
+ * @param v The vector.
+ * @param count The count of integers to be appended.
+ * @param expected Computes the capacity expected after a reallocation from the one before.
+ * @return Whether the vector has grown as expected.
+ */
+template<class Vector>
+static inline bool growsAsExpected(Vector & v, int count, std::size_t (*expected)(std::size_t, std::size_t)) {
+    bool grown = true;
+    for (int i = 0; i < count; ++i) {
+        const std::size_t capacity = v.capacity();
+        v.push_back(intArray[i]);
+        grown = grown && (v.capacity() == capacity || v.capacity() == expected(capacity, v.size()));
+    }
+    return grown;
+}
+
+static inline std::size_t threeHalves(std::size_t capacity, std::size_t required) {
+    return capacity * 3 / 2 < required ? required : capacity * 3 / 2;
+}
+
+static inline std::size_t pageSteps(std::size_t capacity, std::size_t required) {
+    return capacity * sizeof(int) < 4096 ? (capacity * 2 < required ? required : capacity * 2) : capacity + 4096 / sizeof(int);
+}
+
+static inline void testVectorGrowth() {
+    std::cout << "Vector growth policies" << std::endl;
+    bool grown = true, shrunk = true, released = true;
+    if (testingFt) {
+        ft::vector<int, std::allocator<int>, ft::growth_factor<3, 2> > factor;
+        grown = growsAsExpected(factor, 1000, threeHalves);
+        printInfo(factor);
+
+        ft::vector<int, std::allocator<int>, ft::page_growth<4096, 4096> > paged;
+        grown = grown && growsAsExpected(paged, 5000, pageSteps);
+        printInfo(paged);
+
+        ft::allocation_stats stats;
+        {
+            typedef ft::counting_allocator<int> Allocator;
+            ft::vector<int, Allocator, ft::shrink_hysteresis<> > hysteresis((Allocator(stats)));
+            for (int i = 0; i < 1000; ++i) {
+                hysteresis.push_back(intArray[i]);
+            }
+            while (!hysteresis.empty()) {
+                const std::size_t capacity = hysteresis.capacity();
+                hysteresis.pop_back();
+                shrunk = shrunk && hysteresis.capacity() == (hysteresis.size() < capacity / 4 ? 2 * hysteresis.size() : capacity);
+            }
+            hysteresis.insert(hysteresis.end(), intArray, intArray + 100);
+            hysteresis.erase(hysteresis.begin() + 10, hysteresis.end());
+            shrunk = shrunk && hysteresis.capacity() == 20;
+            printInfo(hysteresis);
+            stats.allocations = 0;
+        }
+        released = stats.allocations == 0 && stats.live_bytes == 0;
+    } else {
+        std::vector<int> factor(intArray, intArray + 1000), paged(intArray, intArray + 5000), hysteresis(intArray, intArray + 10);
+        printInfo(factor);
+        printInfo(paged);
+        printInfo(hysteresis);
+    }
+    std::cout << "Grown as expected: "       << grown    << std::endl
+              << "Shrunk as expected: "      << shrunk   << std::endl
+              << "Released on destruction: " << released << std::endl << std::endl;
+
+    std::cout << "Vector shrink_to_fit" << std::endl;
+    bool fitted = true;
+    if (testingFt) {
+        ft::vector<std::string> strings(stringArray, stringArray + 1000);
+        strings.erase(strings.begin() + 10, strings.end());
+        strings.shrink_to_fit();
+        fitted = strings.capacity() == 10;
+        printInfo(strings);
+        strings.clear();
+        strings.shrink_to_fit();
+        fitted = fitted && strings.capacity() == 0;
+        strings.push_back(stringArray[1]);
+        printInfo(strings);
+    } else {
+        std::vector<std::string> strings(stringArray, stringArray + 10);
+        printInfo(strings);
+        strings.clear();
+        strings.push_back(stringArray[1]);
+        printInfo(strings);
+    }
+    std::cout << "Fitted: " << fitted << std::endl << std::endl;
+}
+
+static inline void testMmapAllocator() {
+    std::cout << "Vector with mmap_allocator" << std::endl;
+    bool kept = true;
+    if (testingFt) {
+        ft::vector<int, ft::mmap_allocator<int, 4096> > numbers;
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            numbers.push_back(intArray[ARRAY_SIZE - 1 - i]);
+        }
+        numbers.erase(numbers.begin() + 100, numbers.end() - 100);
+        printInfo(numbers);
+        numbers.shrink_to_fit();
+        numbers.insert(numbers.begin() + 50, intArray, intArray + ARRAY_SIZE / 2);
+        printInfo(numbers);
+
+        ft::vector<std::string, ft::mmap_allocator<std::string, 4096> > strings(stringArray, stringArray + 200);
+        strings.insert(strings.end(), stringArray + 1000, stringArray + 3000);
+        printInfo(strings);
+
+        ft::mmap_allocator<int, 4096> alloc;
+        int * block = alloc.allocate(2048);
+        std::memcpy(block, intArray, 2048 * sizeof(int));
+        block = alloc.reallocate(block, 2048, 1 << 20);
+        block[(1 << 20) - 1] = 1;
+        kept = std::memcmp(block, intArray, 2048 * sizeof(int)) == 0;
+        block = alloc.reallocate(block, 1 << 20, 512);
+        kept = kept && std::memcmp(block, intArray, 512 * sizeof(int)) == 0;
+        alloc.deallocate(block, 512);
+    } else {
+        std::vector<int> numbers;
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            numbers.push_back(intArray[ARRAY_SIZE - 1 - i]);
+        }
+        numbers.erase(numbers.begin() + 100, numbers.end() - 100);
+        printInfo(numbers);
+        numbers.insert(numbers.begin() + 50, intArray, intArray + ARRAY_SIZE / 2);
+        printInfo(numbers);
+
+        std::vector<std::string> strings(stringArray, stringArray + 200);
+        strings.insert(strings.end(), stringArray + 1000, stringArray + 3000);
+        printInfo(strings);
+    }
+    std::cout << "Kept by reallocate: " << kept << std::endl << std::endl;
+}
+
+/**
+ * Pushes and pops elements, reserves and changes elements of the given vector, copies it and
+ * assigns it to the copy, printing all of them.
+ *
+ * @param v The vector, empty.
+ * @param values The values to be pushed, 1000 of them.
+ * @param migrating Set to whether the vector was migrating while being used, if it can do so.
+ */
+template<class Vector>
+static inline void useGrowingVector(Vector & v, const typename Vector::value_type * values, bool (*migrating)(const Vector &)) {
+    bool migrated = false;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(values[i]);
+        if (i % 10 == 9) {
+            v.pop_back();
+            v.pop_back();
+        }
+        if (i == 600) {
+            v.reserve(5000);
+        }
+        if (i % 100 == 50) {
+            v[v.size() / 2] = v.front();
+            migrated = migrated || migrating(v);
+        }
+    }
+    Vector copy(v);
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(values[999 - i]);
+    }
+    printInfo(v);
+    printInfo(copy);
+    std::cout << "Equal: " << (v == copy) << ", less: " << (copy < v) << std::endl;
+    copy = v;
+    v.pop_back();
+    printInfo(copy);
+    std::cout << "Equal: " << (v == copy) << ", less: " << (v < copy) << std::endl
+              << "Used while migrating: " << migrated << std::endl << std::endl;
+}
+
+template<class Vector>
+static inline bool isMigrating(const Vector & v) { return v.is_migrating(); }
+
+template<class Vector>
+static inline bool alwaysMigrating(const Vector &) { return true; }
+
+static inline void testIncrementalVector() {
+    static int numbers[1000];
+    for (int i = 0; i < 1000; ++i) {
+        numbers[i] = intArray[random() % ARRAY_SIZE];
+    }
+
+    std::cout << "Incremental vector" << std::endl;
+    if (testingFt) {
+        ft::incremental_vector<int> integers;
+        useGrowingVector(integers, numbers, isMigrating);
+        ft::incremental_vector<std::string, std::allocator<std::string>, 1> strings;
+        useGrowingVector(strings, stringArray, isMigrating);
+    } else {
+        std::vector<int> integers;
+        useGrowingVector(integers, numbers, alwaysMigrating);
+        std::vector<std::string> strings;
+        useGrowingVector(strings, stringArray, alwaysMigrating);
+    }
+}
+
+/**
+ * Inserts the given keys into the given map, erases every third of them again and prints it.
+ *
+ * @param m The map.
+ * @param keys The keys, 2000 of them.
+ */
+template<class Map>
+static inline void fillAndThin(Map & m, const int * keys) {
+    for (int i = 0; i < 2000; ++i) {
+        m[keys[i]] = stringArray[keys[i]];
+    }
+    for (int i = 0; i < 2000; i += 3) {
+        m.erase(keys[i]);
+    }
+    printInfoMap(m);
+}
+
+static inline void testArenaAllocator() {
+    int keys[2000];
+    for (int i = 0; i < 2000; ++i) {
+        keys[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+
+    std::cout << "Containers in an arena" << std::endl;
+    bool inPlace = true, released = true;
+    if (testingFt) {
+        ft::arena memory(64, 1024);
+        {
+            typedef ft::map<int, std::string, ft::less<int>, ft::arena_allocator<ft::pair<const int, std::string> > > Map;
+            Map m(ft::less<int>(), (ft::arena_allocator<ft::pair<const int, std::string> >(memory)));
+            fillAndThin(m, keys);
+
+            ft::set<int, ft::less<int>, ft::arena_allocator<int> > s(keys, keys + 2000, ft::less<int>(), ft::arena_allocator<int>(memory));
+            printInfo(s);
+
+            ft::deque<int, ft::arena_allocator<int> > d((ft::arena_allocator<int>(memory)));
+            for (int i = 0; i < 2000; ++i) {
+                d.push_front(keys[i]);
+            }
+            printInfo(d);
+        }
+        memory.release();
+        released = memory.bytes_used() == 0;
+
+        ft::arena big(1 << 16);
+        ft::vector<int, ft::arena_allocator<int> > v((ft::arena_allocator<int>(big)));
+        v.reserve(16);
+        const int * first = v.data();
+        for (int i = 0; i < 2000; ++i) {
+            v.push_back(keys[i]);
+        }
+        inPlace = v.data() == first && big.bytes_used() == v.capacity() * sizeof(int);
+        printInfo(v);
+    } else {
+        std::map<int, std::string> m;
+        fillAndThin(m, keys);
+        printInfo(std::set<int>(keys, keys + 2000));
+        std::deque<int> d;
+        for (int i = 0; i < 2000; ++i) {
+            d.push_front(keys[i]);
+        }
+        printInfo(d);
+        printInfo(std::vector<int>(keys, keys + 2000));
+    }
+    std::cout << "Grown in place: " << inPlace  << std::endl
+              << "Released: "       << released << std::endl << std::endl;
+}
+
+/**
+ * The tag of the statistics of the counted maps.
+ */
+struct CountedMaps {};
+
+static inline void testCountingAllocator() {
+    int keys[1000];
+    for (int i = 0; i < 1000; ++i) {
+        keys[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+
+    std::cout << "Counted allocations" << std::endl;
+    bool reported = true, peaked = true, released = true;
+    if (testingFt) {
+        ft::allocation_stats & mapStats = ft::tag_allocation_stats<CountedMaps>();
+        ft::allocation_stats   vectorStats, setStats;
+        mapStats.reset();
+        {
+            typedef ft::counting_allocator<int> Allocator;
+            ft::vector<int, Allocator> v((Allocator(vectorStats)));
+            for (int i = 0; i < 1000; ++i) {
+                v.push_back(keys[i]);
+            }
+            reported = v.memory_usage().total_bytes() == vectorStats.live_bytes
+                    && v.memory_usage().payload_bytes == 1000 * sizeof(int);
+            peaked   = vectorStats.peak_bytes == (1024 + 512) * sizeof(int);
+            printInfo(v);
+
+            ft::map<int, std::string, ft::less<int>, ft::counting_allocator<ft::pair<const int, std::string>, CountedMaps> > m;
+            ft::set<int, ft::less<int>, ft::counting_allocator<int> > s((ft::less<int>()), ft::counting_allocator<int>(setStats));
+            for (int i = 0; i < 1000; ++i) {
+                m[keys[i]] = stringArray[keys[i]];
+                s.insert(keys[i] / 2);
+            }
+            m.erase(m.begin(), m.find(keys[0]));
+            reported = reported && m.memory_usage().total_bytes() == mapStats.live_bytes
+                                && s.memory_usage().total_bytes() == setStats.live_bytes
+                                && m.memory_usage().payload_bytes == m.size() * sizeof(ft::pair<const int, std::string>);
+            peaked   = peaked && mapStats.peak_bytes > mapStats.live_bytes;
+            printInfoMap(m);
+            printInfo(s);
+        }
+        released = vectorStats.live_bytes == 0 && mapStats.live_bytes == 0 && setStats.live_bytes == 0
+                && vectorStats.allocations == vectorStats.deallocations && mapStats.allocations == mapStats.deallocations;
+    } else {
+        std::vector<int> v(keys, keys + 1000);
+        printInfo(v);
+        std::map<int, std::string> m;
+        std::set<int> s;
+        for (int i = 0; i < 1000; ++i) {
+            m[keys[i]] = stringArray[keys[i]];
+            s.insert(keys[i] / 2);
+        }
+        m.erase(m.begin(), m.find(keys[0]));
+        printInfoMap(m);
+        printInfo(s);
+    }
+    std::cout << "Reported: " << reported << std::endl
+              << "Peaked: "   << peaked   << std::endl
+              << "Released: " << released << std::endl << std::endl;
+}
+
 static inline void testMap() {
     NS::map<int, std::string> m;
     std::cout << "Map assign" << std::endl;
@@ -160,6 +611,116 @@ static inline void testMap() {
     printInfoMap(m);
 }
 
+/**
+ * A value whose copy constructor throws once a given count of copies has been made.
+ */
+struct FragileValue {
+    /**
+     * The count of copies still allowed, negative for no limit.
+     */
+    static int copiesLeft;
+    /**
+     * The count of values currently constructed.
+     */
+    static int alive;
+
+    int value;
+
+    explicit FragileValue(int value = 0): value(value) { ++alive; }
+
+    FragileValue(const FragileValue & other): value(other.value) {
+        if (copiesLeft == 0) throw std::runtime_error("FragileValue: No copies left!");
+        if (copiesLeft > 0) --copiesLeft;
+        ++alive;
+    }
+
+   ~FragileValue() { --alive; }
+};
+
+int FragileValue::copiesLeft = -1;
+int FragileValue::alive      = 0;
+
+/**
+ * @brief A compare object for FragileValues throwing once the shared count of comparisons
+ * left runs out.
+ */
+struct ExhaustibleLess {
+    int * comparisonsLeft;
+
+    explicit ExhaustibleLess(int * comparisonsLeft): comparisonsLeft(comparisonsLeft) {}
+
+    bool operator()(const FragileValue & lhs, const FragileValue & rhs) const {
+        if ((*comparisonsLeft)-- == 0) throw std::runtime_error("ExhaustibleLess: No comparisons left!");
+        return lhs.value < rhs.value;
+    }
+};
+
+static inline std::ostream & operator<<(std::ostream & out, const FragileValue & v) {
+    return out << v.value;
+}
+
+/**
+ * Assigns the given source to the given destination with the copies limited to the given
+ * count, then checks that the destination is left empty and usable if the assignment threw.
+ *
+ * @param dst The destination of the assignment.
+ * @param src The source of the assignment.
+ * @param copies The count of copies allowed.
+ * @return Whether the assignment threw and left an empty, usable map.
+ */
+template<class Map>
+static inline bool assignFragile(Map & dst, const Map & src, int copies) {
+    bool threw = false;
+    FragileValue::copiesLeft = copies;
+    try {
+        dst = src;
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    FragileValue::copiesLeft = -1;
+    const bool empty = dst.empty() && dst.begin() == dst.end();
+    dst[1] = FragileValue(1);
+    return threw && empty && dst.size() == 1;
+}
+
+static inline void testMapCopyFailure() {
+    std::cout << "Map copy throwing" << std::endl;
+    bool recovered = true, copyThrew = false;
+    if (testingFt) {
+        ft::map<int, FragileValue> small, big;
+        for (int i = 0; i < 10; ++i) {
+            small[intArray[i]] = FragileValue(i);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            big[intArray[i] * 3] = FragileValue(i);
+        }
+        ft::map<int, FragileValue> smallCopy(small), bigCopy(big);
+        recovered = assignFragile(smallCopy, big, 500);
+        recovered = assignFragile(bigCopy, small, 5) && recovered;
+        recovered = assignFragile(bigCopy, big, 0) && recovered;
+        FragileValue::copiesLeft = 700;
+        try {
+            ft::map<int, FragileValue> copy(big);
+        } catch (const std::runtime_error &) {
+            copyThrew = true;
+        }
+        FragileValue::copiesLeft = -1;
+        smallCopy = big;
+        printInfoMap(smallCopy);
+        printInfoMap(bigCopy);
+    } else {
+        std::map<int, FragileValue> big, single;
+        for (int i = 0; i < 1000; ++i) {
+            big[intArray[i] * 3] = FragileValue(i);
+        }
+        single[1] = FragileValue(1);
+        copyThrew = true;
+        printInfoMap(big);
+        printInfoMap(single);
+    }
+    std::cout << "Recovered: " << recovered << ", copy threw: " << copyThrew << std::endl << std::endl;
+}
+
 static inline void testStack() {
     NS::stack<std::string, NS::vector<std::string> > st;
     std::cout << "Stack push" << std::endl;
@@ -176,6 +737,137 @@ static inline void testStack() {
     std::cout << std::endl;
 }
 
+static inline void testDeque() {
+    NS::deque<std::string> d;
+    std::cout << "Deque push_back and push_front" << std::endl;
+    for (unsigned long i = 0; i < ARRAY_SIZE; ++i) {
+        if (random() % 2 == 0) {
+            d.push_back(stringArray[i]);
+        } else {
+            d.push_front(stringArray[i]);
+        }
+    }
+    printInfo(d);
+
+    std::cout << "Deque insert" << std::endl;
+    d.insert(d.begin() + d.size() / 3, stringArray, stringArray + ARRAY_SIZE / 8);
+    d.insert(d.end() - d.size() / 3, 5, stringArray[0]);
+    printInfo(d);
+
+    std::cout << "Deque erase" << std::endl;
+    d.erase(d.begin() + 7, d.begin() + d.size() / 2);
+    d.erase(d.end() - 3);
+    printInfo(d);
+
+    std::cout << "Deque pop_front and pop_back" << std::endl;
+    for (unsigned long i = 0; i < ARRAY_SIZE / 8; ++i) {
+        d.pop_front();
+        d.pop_back();
+    }
+    std::cout << "Front: '" << d.front() << "', back: '" << d.back() << "', [42]: '" << d[42] << "'" << std::endl;
+    printInfo(d);
+
+    NS::stack<std::string, NS::deque<std::string> > st(d);
+    std::cout << "Stack on deque size: " << st.size() << ", top: '" << st.top() << "'" << std::endl;
+    st.pop();
+    std::cout << "Stack on deque top after pop: '" << st.top() << "'" << std::endl << std::endl;
+}
+
+static inline void testPriorityQueue() {
+    std::cout << "Priority queue from range" << std::endl;
+    NS::priority_queue<std::string> q(stringArray, stringArray + ARRAY_SIZE / 2);
+    std::cout << "Priority queue push" << std::endl;
+    for (unsigned long i = 0; i < ARRAY_SIZE / 2; ++i) {
+        q.push(stringArray[random() % ARRAY_SIZE]);
+    }
+
+    std::cout << "Priority queue size: " << q.size()                      << std::endl
+              << "Priority queue top() and pop() while queue not empty()" << std::endl;
+    while (!q.empty()) {
+        std::cout << q.top() << std::endl;
+        q.pop();
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Pops all elements of the given queue, printing them.
+ *
+ * @param q The queue.
+ */
+template<class Queue>
+static inline void printDrained(Queue & q) {
+    std::cout << "Size: " << q.size() << std::endl;
+    while (!q.empty()) {
+        std::cout << q.top() << std::endl;
+        q.pop();
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Replaces the top of the given queue by the given values, then pushes the given range to it
+ * and prints all of its elements.
+ *
+ * @param q The queue.
+ * @param values The values replacing the top, 2000 of them.
+ * @param first The beginning of the range to be pushed.
+ * @param last The end of the range to be pushed.
+ */
+template<class Queue>
+static inline void replaceAndPushRange(Queue & q, const int * values, const int * first, const int * last) {
+    for (int i = 0; i < 2000; ++i) {
+        q.replace_top(values[i]);
+    }
+    q.push_range(first, last);
+    printDrained(q);
+}
+
+/**
+ * Does the same as replaceAndPushRange, using pop, push and push only.
+ */
+template<class Queue>
+static inline void popAndPushRange(Queue & q, const int * values, const int * first, const int * last) {
+    for (int i = 0; i < 2000; ++i) {
+        q.pop();
+        q.push(values[i]);
+    }
+    for (; first != last; ++first) {
+        q.push(*first);
+    }
+    printDrained(q);
+}
+
+static inline void testPriorityQueueExtensions() {
+    int numbers[ARRAY_SIZE / 8], values[2000];
+    for (int i = 0; i < ARRAY_SIZE / 8; ++i) {
+        numbers[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+    for (int i = 0; i < 2000; ++i) {
+        values[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+    const int count = ARRAY_SIZE / 8;
+    const int * ranges[] = { numbers + count / 2, numbers + count / 2 + 10, numbers + count };
+
+    std::cout << "Priority queue replace_top and push_range" << std::endl;
+    for (int r = 0; r < 2; ++r) {
+        if (testingFt) {
+            ft::priority_queue<int> binary(numbers, numbers + count / 2);
+            replaceAndPushRange(binary, values, ranges[0], ranges[r + 1]);
+            ft::priority_queue<int, ft::vector<int>, ft::less<int>, 4> quaternary(numbers, numbers + count / 2);
+            replaceAndPushRange(quaternary, values, ranges[0], ranges[r + 1]);
+            ft::priority_queue<int, ft::vector<int>, std::greater<int>, 8> octonary(numbers, numbers + count / 2);
+            replaceAndPushRange(octonary, values, ranges[0], ranges[r + 1]);
+        } else {
+            std::priority_queue<int> binary(numbers, numbers + count / 2), quaternary(numbers, numbers + count / 2);
+            std::priority_queue<int, std::vector<int>, std::greater<int> > octonary(numbers, numbers + count / 2);
+            popAndPushRange(binary, values, ranges[0], ranges[r + 1]);
+            popAndPushRange(quaternary, values, ranges[0], ranges[r + 1]);
+            popAndPushRange(octonary, values, ranges[0], ranges[r + 1]);
+        }
+    }
+}
+
 static inline void testSet() {
     NS::set<int> s;
     std::cout << "Set assign" << std::endl;
@@ -187,13 +879,983 @@ static inline void testSet() {
     printInfo(s);
 }
 
+static inline void testAlgorithm() {
+    NS::vector<int> numbers;
+    for (unsigned long i = 0; i < ARRAY_SIZE; ++i) {
+        numbers.push_back(intArray[random() % ARRAY_SIZE] - ARRAY_SIZE / 2);
+    }
+    std::cout << "Sort integers" << std::endl;
+    NS::sort(numbers.begin(), numbers.end());
+    printInfo(numbers);
+
+    std::cout << "Unique integers" << std::endl;
+    numbers.erase(NS::unique(numbers.begin(), numbers.end()), numbers.end());
+    printInfo(numbers);
+
+    std::cout << "Binary search integers" << std::endl;
+    for (int i = 0; i < 64; ++i) {
+        const int value = intArray[random() % ARRAY_SIZE] - ARRAY_SIZE / 2;
+        std::cout << value << ": " << NS::binary_search(numbers.begin(), numbers.end(), value)
+                  << ", lower bound at " << NS::lower_bound(numbers.begin(), numbers.end(), value) - numbers.begin()
+                  << ", upper bound at " << NS::upper_bound(numbers.begin(), numbers.end(), value) - numbers.begin() << std::endl;
+    }
+
+    NS::vector<std::string> words;
+    for (unsigned long i = 0; i < ARRAY_SIZE; ++i) {
+        words.push_back(stringArray[random() % ARRAY_SIZE]);
+    }
+    NS::deque<std::string> d(words.begin(), words.end());
+    std::cout << "Nth element of strings" << std::endl;
+    NS::nth_element(words.begin(), words.begin() + ARRAY_SIZE / 3, words.end());
+    std::cout << "Nth: '" << words[ARRAY_SIZE / 3] << "'" << std::endl;
+
+    std::cout << "Partial sort strings" << std::endl;
+    NS::partial_sort(words.begin(), words.begin() + ARRAY_SIZE / 8, words.end());
+    words.resize(ARRAY_SIZE / 8);
+    printInfo(words);
+
+    std::cout << "Sort strings" << std::endl;
+    NS::sort(d.begin(), d.end());
+    printInfo(d);
+
+    std::cout << "Stable sort pairs" << std::endl;
+    NS::vector<NS::pair<int, std::string> > byKey(pairs, pairs + ARRAY_SIZE);
+    for (NS::vector<NS::pair<int, std::string> >::iterator it = byKey.begin(); it != byKey.end(); ++it) {
+        it->first %= 100;
+    }
+    NS::stable_sort(byKey.begin(), byKey.end(), compareFirst);
+    for (NS::vector<NS::pair<int, std::string> >::const_iterator it = byKey.begin(); it != byKey.end(); ++it) {
+        std::cout << it->first << ": '" << it->second << "'" << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "Stable sort with a throwing compare object" << std::endl;
+    NS::vector<FragileValue> values;
+    for (unsigned long i = 0; i < ARRAY_SIZE / 32; ++i) {
+        values.push_back(FragileValue(intArray[random() % ARRAY_SIZE] % 100));
+    }
+    for (int limit = 64; limit <= 16384; limit *= 2) {
+        NS::vector<FragileValue> v(values);
+        const int before = FragileValue::alive;
+        int comparisonsLeft = limit;
+        bool threw = false;
+        try {
+            NS::stable_sort(v.begin(), v.end(), ExhaustibleLess(&comparisonsLeft));
+        } catch (const std::runtime_error &) {
+            threw = true;
+        }
+        bool sorted = true;
+        for (std::size_t i = 1; !threw && i < v.size(); ++i) {
+            sorted = sorted && !(v[i].value < v[i - 1].value);
+        }
+        std::cout << limit << " comparisons: temporaries destroyed " << (FragileValue::alive == before)
+                  << ", sorted unless thrown " << sorted << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Prints the results of looking up the given keys in the given map.
+ *
+ * @param m The map, the values of which are printed by their first member.
+ * @param keys The keys to be looked up.
+ * @param count The count of keys.
+ */
+template<class Map>
+static inline void printLookups(const Map & m, const int * keys, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        typename Map::const_iterator lower = m.lower_bound(keys[i]),
+                                     upper = m.upper_bound(keys[i]);
+        std::cout << keys[i] << ": count " << m.count(keys[i]);
+        if (m.find(keys[i]) != m.end()) {
+            std::cout << ", value " << m.find(keys[i])->second.first;
+        }
+        std::cout << ", lower bound " << (lower == m.end() ? -1 : lower->first)
+                  << ", upper bound " << (upper == m.end() ? -1 : upper->first) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Fills the given map with every third key, mapped to the pairs of the given values.
+ */
+template<class Map, class First, class Second>
+static inline Map & fillSparse(Map & m, const First * firsts, const Second * seconds) {
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        m[3 * i] = typename Map::mapped_type(firsts[i], seconds[i]);
+    }
+    return m;
+}
+
+/**
+ * A compare object sorting ascending or descending, depending on its state.
+ */
+struct OrderedBy {
+    bool descending;
+
+    explicit OrderedBy(bool descending = false): descending(descending) {}
+
+    bool operator()(int lhs, int rhs) const { return descending ? rhs < lhs : lhs < rhs; }
+};
+
+/**
+ * Prints the results of looking up the given keys in the given set.
+ *
+ * @param s The set.
+ * @param keys The keys to be looked up.
+ * @param count The count of keys.
+ */
+template<class Set>
+static inline void printSetLookups(const Set & s, const int * keys, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        typename Set::const_iterator lower = s.lower_bound(keys[i]),
+                                     upper = s.upper_bound(keys[i]);
+        std::cout << keys[i] << ": count " << s.count(keys[i])
+                  << ", lower bound " << (lower == s.end() ? -1 : *lower)
+                  << ", upper bound " << (upper == s.end() ? -1 : *upper) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+static inline void testFrozenMap() {
+    static int         numbers[ARRAY_SIZE];
+    static std::string names[ARRAY_SIZE];
+    int keys[512];
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        numbers[i] = static_cast<int>(random() % ARRAY_SIZE);
+        names[i]   = stringArray[random() % ARRAY_SIZE];
+    }
+    for (int i = 0; i < 512; ++i) {
+        keys[i] = static_cast<int>(random() % (3 * ARRAY_SIZE + 2)) - 1;
+    }
+
+    std::cout << "Frozen map lookups, pairs of integers" << std::endl;
+    if (testingFt) {
+        ft::map<int, ft::pair<int, int> > m;
+        fillSparse(m, numbers, intArray);
+        const ft::frozen_map<int, ft::pair<int, int> > frozen(m.begin(), m.end());
+        printLookups(frozen, keys, 512);
+    } else {
+        std::map<int, std::pair<int, int> > m;
+        printLookups(fillSparse(m, numbers, intArray), keys, 512);
+    }
+
+    std::cout << "Frozen map lookups, strings" << std::endl;
+    if (testingFt) {
+        ft::map<int, ft::pair<int, std::string> > m;
+        fillSparse(m, intArray, names);
+        const ft::frozen_map<int, ft::pair<int, std::string> > frozen(m.begin(), m.end());
+        printLookups(frozen, keys, 512);
+    } else {
+        std::map<int, std::pair<int, std::string> > m;
+        printLookups(fillSparse(m, intArray, names), keys, 512);
+    }
+
+    std::cout << "Frozen maps with stateful compare objects, swapped" << std::endl;
+    if (testingFt) {
+        typedef ft::map<int, ft::pair<int, int>, OrderedBy> Map;
+        Map ascending, descending((OrderedBy(true)));
+        fillSparse(ascending, numbers, intArray);
+        fillSparse(descending, intArray, numbers);
+        ft::frozen_map<int, ft::pair<int, int>, OrderedBy> first  = ascending.freeze(),
+                                                           second = descending.freeze();
+        first.swap(second);
+        std::cout << "Descending: " << first.key_comp()(1, 0) << ", " << second.key_comp()(1, 0) << std::endl;
+        printLookups(first, keys, 128);
+        printLookups(second, keys, 128);
+    } else {
+        typedef std::map<int, std::pair<int, int>, OrderedBy> Map;
+        Map first, second((OrderedBy(true)));
+        fillSparse(first, numbers, intArray);
+        fillSparse(second, intArray, numbers);
+        first.swap(second);
+        std::cout << "Descending: " << first.key_comp()(1, 0) << ", " << second.key_comp()(1, 0) << std::endl;
+        printLookups(first, keys, 128);
+        printLookups(second, keys, 128);
+    }
+
+    std::cout << "Frozen sets" << std::endl;
+    if (testingFt) {
+        ft::set<int> s(numbers, numbers + ARRAY_SIZE);
+        const ft::frozen_set<int> frozen = s.freeze();
+        printInfo(frozen);
+        printSetLookups(frozen, keys, 512);
+    } else {
+        std::set<int> s(numbers, numbers + ARRAY_SIZE);
+        printInfo(s);
+        printSetLookups(s, keys, 512);
+    }
+}
+
+/**
+ * Grows two maps by a few entries at a time, swapping them after every step.
+ *
+ * @param keys The keys to be inserted, 64 of them.
+ */
+template<class Map>
+static inline void swapSmallMaps(const int * keys) {
+    Map a, b;
+    for (int i = 0; i < 64; i += 8) {
+        for (int j = i; j < i + 4; ++j) {
+            a[keys[j]] = stringArray[keys[j]];
+            b[keys[j + 4]] = stringArray[keys[j + 4] + 16];
+        }
+        a.erase(keys[i + 4]);
+        a.swap(b);
+        printInfoMap(a);
+        printInfoMap(b);
+    }
+}
+
+static inline void testInlineMap() {
+    int keys[64];
+    for (int i = 0; i < 64; ++i) {
+        keys[i] = static_cast<int>(random() % 16);
+    }
+
+    std::cout << "Swap maps with inline nodes" << std::endl;
+    if (testingFt) {
+        swapSmallMaps<ft::map<int, std::string, ft::less<int>, std::allocator<ft::pair<const int, std::string> >, ft::tree_options<4> > >(keys);
+    } else {
+        swapSmallMaps<std::map<int, std::string> >(keys);
+    }
+}
+
+/**
+ * Grows two vectors past the inline capacity of a small_vector, copying and swapping them.
+ *
+ * @param indices The indices of the strings to be stored, 24 of them.
+ */
+template<class Vector>
+static inline void growSmallVectors(const int * indices) {
+    Vector a, b;
+    for (int i = 0; i < 24; i += 4) {
+        a.push_back(stringArray[indices[i]]);
+        a.push_back(stringArray[indices[i + 1]]);
+        b.push_back(stringArray[indices[i + 2]]);
+        Vector copy(a);
+        copy.push_back(stringArray[indices[i + 3]]);
+        a.swap(b);
+        b = copy;
+        std::cout << "First: '" << *a.data() << "', last: '" << b.data()[b.size() - 1] << "'" << std::endl;
+        printInfo(a);
+        printInfo(b);
+    }
+}
+
+static inline void testSmallVector() {
+    int indices[24];
+    for (int i = 0; i < 24; ++i) {
+        indices[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+
+    std::cout << "Small vector copy and swap" << std::endl;
+    if (testingFt) {
+        growSmallVectors<ft::small_vector<std::string, 4> >(indices);
+    } else {
+        growSmallVectors<std::vector<std::string> >(indices);
+    }
+}
+
+/**
+ * The work of one thread handing values over through a concurrent container.
+ *
+ * @tparam Container The type of the shared container.
+ */
+template<class Container>
+struct HandOff {
+    Container *  container;
+    std::size_t  capacity;
+    const int *  values;
+    std::size_t  count;
+    long         sum;
+    bool         sizeInRange;
+};
+
+template<class Container>
+static void * produce(void * arg) {
+    HandOff<Container> * work = static_cast<HandOff<Container> *>(arg);
+    for (std::size_t i = 0; i < work->count; ++i) {
+        while (!work->container->push(work->values[i])) {
+            sched_yield();
+        }
+        work->sizeInRange = work->sizeInRange && work->container->size() <= work->capacity;
+    }
+    return NULL;
+}
+
+template<class Container>
+static void * consume(void * arg) {
+    HandOff<Container> * work = static_cast<HandOff<Container> *>(arg);
+    int value;
+    for (std::size_t i = 0; i < work->count; ++i) {
+        while (!work->container->pop(value)) {
+            sched_yield();
+        }
+        work->sum += value;
+        work->sizeInRange = work->sizeInRange && work->container->size() <= work->capacity;
+    }
+    return NULL;
+}
+
+/**
+ * Hands the given values over from the given count of producing threads to as many consuming
+ * threads, and prints the sum of the received values.
+ *
+ * @param container The shared container.
+ * @param capacity The capacity of the container.
+ * @param values The values to be handed over.
+ * @param count The count of values, a multiple of the count of threads.
+ * @param threads The count of producing threads.
+ */
+template<class Container>
+static inline void handOver(Container & container, std::size_t capacity, const int * values, std::size_t count, std::size_t threads) {
+    std::vector<pthread_t>           ids(2 * threads);
+    std::vector<HandOff<Container> > work(2 * threads);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        HandOff<Container> job = { &container, capacity, values + i % threads * (count / threads), count / threads, 0, true };
+        work[i] = job;
+        pthread_create(&ids[i], NULL, i < threads ? produce<Container> : consume<Container>, &work[i]);
+    }
+    long sum = 0;
+    bool sizeInRange = true;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        pthread_join(ids[i], NULL);
+        sum += work[i].sum;
+        sizeInRange = sizeInRange && work[i].sizeInRange;
+    }
+    std::cout << "Sum: " << sum << ", size in range: " << sizeInRange << ", final size: " << container.size() << std::endl;
+}
+
+/**
+ * Prints what handOver() prints for the given values.
+ */
+static inline void printHandOver(const int * values, std::size_t count) {
+    long sum = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    std::cout << "Sum: " << sum << ", size in range: " << true << ", final size: " << 0 << std::endl;
+}
+
+static inline void testConcurrent() {
+    static int values[4096];
+    for (int i = 0; i < 4096; ++i) {
+        values[i] = intArray[random() % ARRAY_SIZE];
+    }
+
+    std::cout << "Concurrent stack, 4 -> 4 threads" << std::endl;
+    if (testingFt) {
+        ft::treiber_stack<int> stack(64);
+        handOver(stack, 64, values, 4096, 4);
+    } else {
+        printHandOver(values, 4096);
+    }
+
+    std::cout << "Concurrent queue, 1 -> 1 thread" << std::endl;
+    if (testingFt) {
+        ft::spsc_queue<int> queue(64);
+        handOver(queue, 64, values, 4096, 1);
+    } else {
+        printHandOver(values, 4096);
+    }
+
+    std::cout << "Concurrent queue, 4 -> 4 threads" << std::endl;
+    if (testingFt) {
+        ft::mpmc_queue<int> queue(64);
+        handOver(queue, 64, values, 4096, 4);
+    } else {
+        printHandOver(values, 4096);
+    }
+}
+
+/**
+ * Adds two values, throwing once the sum exceeds the given limit.
+ */
+struct LimitedPlus {
+    long limit;
+
+    explicit LimitedPlus(long limit): limit(limit) {}
+
+    long operator()(long lhs, long rhs) const {
+        if (lhs + rhs > limit) throw std::overflow_error("Sum over the limit");
+        return lhs + rhs;
+    }
+};
+
+static inline void testParallel() {
+    static long        numbers[65536];
+    static std::string words[40000];
+    for (int i = 0; i < 65536; ++i) {
+        numbers[i] = intArray[random() % ARRAY_SIZE];
+    }
+    for (int i = 0; i < 40000; ++i) {
+        words[i] = stringArray[random() % ARRAY_SIZE];
+    }
+    const long *    first = numbers;
+    ft::thread_pool pool(4);
+
+    std::cout << "Parallel sort integers" << std::endl;
+    if (testingFt) {
+        ft::vector<long> v(numbers, numbers + 65536);
+        ft::parallel::sort(pool, v.begin(), v.end());
+        printInfo(v);
+    } else {
+        std::vector<long> v(numbers, numbers + 65536);
+        std::sort(v.begin(), v.end());
+        printInfo(v);
+    }
+
+    std::cout << "Parallel sort strings" << std::endl;
+    if (testingFt) {
+        ft::vector<std::string> v(words, words + 40000);
+        ft::parallel::sort(pool, v.begin(), v.end(), std::greater<std::string>());
+        printInfo(v);
+    } else {
+        std::vector<std::string> v(words, words + 40000);
+        std::sort(v.begin(), v.end(), std::greater<std::string>());
+        printInfo(v);
+    }
+
+    std::cout << "Parallel reduce" << std::endl;
+    for (int length = 0; length <= 65536; length += 16383) {
+        const long sum = testingFt ? ft::parallel::reduce(pool, first, first + length, 42L, ft::plus<long>())
+                                   : std::accumulate(numbers, numbers + length, 42L);
+        std::cout << length << ": " << sum << std::endl;
+    }
+
+    std::cout << "Parallel reduce throwing" << std::endl;
+    try {
+        const long sum = testingFt ? ft::parallel::reduce(pool, first, first + 65536, 0L, LimitedPlus(1000000))
+                                   : std::accumulate(numbers, numbers + 65536, 0L, LimitedPlus(1000000));
+        std::cout << "Sum: " << sum << std::endl;
+    } catch (const std::exception & exception) {
+        std::cout << "Caught: " << exception.what() << std::endl;
+    }
+    std::cout << "Sum after the exception: "
+              << (testingFt ? ft::parallel::reduce(pool, first, first + 65536, 0L, LimitedPlus(1L << 40))
+                            : std::accumulate(numbers, numbers + 65536, 0L, LimitedPlus(1L << 40))) << std::endl;
+
+    std::cout << "Parallel inclusive scan" << std::endl;
+    if (testingFt) {
+        ft::vector<long> v(65536);
+        ft::parallel::inclusive_scan(pool, first, first + 65536, v.begin(), ft::plus<long>());
+        printInfo(v);
+    } else {
+        std::vector<long> v(65536);
+        std::partial_sum(numbers, numbers + 65536, v.begin());
+        printInfo(v);
+    }
+}
+
+/**
+ * Whether the mapped value of the given element is even.
+ */
+struct EvenValue {
+    template<class Pair>
+    bool operator()(const Pair & element) const { return element.second % 2 == 0; }
+};
+
+/**
+ * Returns the mapped value of the given element.
+ */
+struct ValueOf {
+    template<class Pair>
+    long operator()(const Pair & element) const { return element.second; }
+};
+
+/**
+ * Adds the key to the mapped value of the given element.
+ */
+struct AddKey {
+    template<class Pair>
+    void operator()(Pair & element) const { element.second += element.first; }
+};
+
+/**
+ * Appends the keys of the elements it is called with.
+ */
+struct CollectKeys {
+    ft::vector<int> * keys;
+
+    explicit CollectKeys(ft::vector<int> * keys): keys(keys) {}
+
+    template<class Pair>
+    void operator()(const Pair & element) const { keys->push_back(element.first); }
+};
+
+/**
+ * Prints the results of the parallel algorithms on the given map and the set of its keys.
+ */
+template<class Map, class Set>
+static inline void printTreeAlgorithms(ft::thread_pool & pool, Map & m, const Set & s) {
+    std::cout << "Count of even values: " << ft::parallel::count_if(pool, m, EvenValue()) << std::endl;
+    std::cout << "Sum of the values: " << ft::parallel::transform_reduce(pool, m, 7L, ft::plus<long>(), ValueOf()) << std::endl;
+    std::cout << "Sum of the keys: " << ft::parallel::reduce(pool, s, 7L, ft::plus<long>()) << std::endl;
+    ft::parallel::for_each(pool, m, AddKey());
+    printInfoMap(m);
+}
+
+/**
+ * Prints what printTreeAlgorithms() prints, using the standard algorithms.
+ */
+template<class Map, class Set>
+static inline void printTreeAlgorithms(Map & m, const Set & s) {
+    long sum = 7;
+    for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it) {
+        sum += it->second;
+    }
+    std::cout << "Count of even values: " << std::count_if(m.begin(), m.end(), EvenValue()) << std::endl;
+    std::cout << "Sum of the values: " << sum << std::endl;
+    std::cout << "Sum of the keys: " << std::accumulate(s.begin(), s.end(), 7L) << std::endl;
+    std::for_each(m.begin(), m.end(), AddKey());
+    printInfoMap(m);
+}
+
+/**
+ * Looks up the keys it is called with in a map.
+ */
+template<class Map>
+struct FindIn {
+    const Map * m;
+
+    explicit FindIn(const Map & m): m(&m) {}
+
+    void operator()(int key) const { (void) m->find(key); }
+};
+
+static inline void testTreeStats() {
+    static int keys[ARRAY_SIZE];
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        keys[i] = intArray[random() % ARRAY_SIZE];
+    }
+
+    std::cout << "Tree statistics" << std::endl;
+    bool shaped = true, counted = true;
+    if (testingFt) {
+        typedef ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >, ft::tree_options<0, ft::tree_stats> > Map;
+        Map m;
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            m[keys[i]] = i;
+        }
+        for (int i = 0; i < ARRAY_SIZE; i += 2) {
+            m.erase(keys[i]);
+        }
+        ft::tree_statistics stats = m.stats();
+        std::size_t levels = 0;
+        for (std::size_t n = m.size(); n > 0; n /= 2) ++levels;
+        shaped  = stats.node_count == m.size() && stats.black_balanced
+               && stats.height >= levels && stats.height <= 2 * levels
+               && stats.black_height <= stats.height && 2 * stats.black_height >= stats.height;
+        counted = stats.counters.comparisons > 0 && stats.counters.rotations > 0
+               && stats.counters.recolours > 0 && stats.counters.fixups > 0;
+
+        m.reset_stats();
+        ft::thread_pool pool(4);
+        ft::vector<int> lookups(keys, keys + ARRAY_SIZE);
+        const Map & c = m;
+        ft::parallel::for_each(pool, lookups.begin(), lookups.end(), FindIn<Map>(c));
+        stats   = m.stats();
+        counted = counted && stats.counters.searches == ARRAY_SIZE && stats.counters.rotations == 0
+                          && stats.counters.search_steps >= ARRAY_SIZE
+                          && stats.counters.search_steps <= ARRAY_SIZE * (stats.height + 1);
+        printInfoMap(m);
+    } else {
+        std::map<int, int> m;
+        for (int i = 0; i < ARRAY_SIZE; ++i) {
+            m[keys[i]] = i;
+        }
+        for (int i = 0; i < ARRAY_SIZE; i += 2) {
+            m.erase(keys[i]);
+        }
+        printInfoMap(m);
+    }
+    std::cout << "Shaped like a red-black tree: " << shaped  << std::endl
+              << "Counted: "                      << counted << std::endl << std::endl;
+}
+
+/**
+ * Inserts, erases and looks up the given keys in the given map, then prints it, a copy of it
+ * and its reverse order.
+ *
+ * @param m The map, empty.
+ * @param keys The keys.
+ * @param count The count of keys, at least two.
+ */
+template<class Map>
+static inline void useMap(Map & m, const int * keys, int count) {
+    for (int i = 0; i < count; ++i) {
+        m.insert(typename Map::value_type(keys[i], stringArray[keys[i]]));
+    }
+    for (int i = 0; i < count; i += 3) {
+        m.erase(keys[i]);
+    }
+    for (int i = 1; i < count; i += 7) {
+        typename Map::iterator it = m.lower_bound(keys[i] - 5);
+        if (it != m.end()) {
+            it->second = stringArray[i];
+        }
+    }
+    Map copy(m);
+    copy.erase(copy.begin(), copy.find(keys[1]));
+    m = copy;
+    printInfoMap(m);
+    for (typename Map::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it) {
+        std::cout << it->first << " ";
+    }
+    std::cout << std::endl << std::endl;
+}
+
+static inline void testCompactNodes() {
+    int keys[4000];
+    for (int i = 0; i < 4000; ++i) {
+        keys[i] = static_cast<int>(random() % (ARRAY_SIZE / 4));
+    }
+
+    std::cout << "Map with compact nodes" << std::endl;
+    bool balanced = true;
+    if (testingFt) {
+        typedef std::allocator<ft::pair<const int, std::string> > Allocator;
+        ft::map<int, std::string, ft::less<int>, Allocator, ft::tree_options<0, ft::no_tree_stats, true> > compact;
+        useMap(compact, keys, 4000);
+        ft::map<int, std::string, ft::less<int>, Allocator, ft::tree_options<4, ft::no_tree_stats, true> > small;
+        useMap(small, keys, 6);
+        balanced = compact.stats().black_balanced && small.stats().black_balanced;
+    } else {
+        std::map<int, std::string> compact, small;
+        useMap(compact, keys, 4000);
+        useMap(small, keys, 6);
+    }
+    std::cout << "Balanced: " << balanced << std::endl << std::endl;
+}
+
+static inline void testParallelTree() {
+    static int keys[ARRAY_SIZE];
+    static int values[ARRAY_SIZE];
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        keys[i]   = intArray[random() % ARRAY_SIZE];
+        values[i] = intArray[random() % ARRAY_SIZE];
+    }
+    ft::thread_pool pool(4);
+
+    const int sizes[] = { 0, 1, 100, ARRAY_SIZE };
+    for (int i = 0; i < 4; ++i) {
+        std::cout << "Parallel algorithms on a map of " << sizes[i] << " insertions" << std::endl;
+        if (testingFt) {
+            ft::map<int, long> m;
+            ft::set<int>       s(keys, keys + sizes[i]);
+            for (int j = 0; j < sizes[i]; ++j) m[keys[j]] = values[j];
+            printTreeAlgorithms(pool, m, s);
+        } else {
+            std::map<int, long> m;
+            std::set<int>       s(keys, keys + sizes[i]);
+            for (int j = 0; j < sizes[i]; ++j) m[keys[j]] = values[j];
+            printTreeAlgorithms(m, s);
+        }
+    }
+
+    std::cout << "Split a map" << std::endl;
+    ft::map<int, long> m;
+    for (int i = 0; i < ARRAY_SIZE; ++i) m[keys[i]] = values[i];
+    for (ft::map<int, long>::size_type depth = 0; depth < 6; ++depth) {
+        ft::vector<int> visited, ordered;
+        if (testingFt) {
+            ft::vector<ft::map<int, long>::const_range_type> ranges((2 << depth) - 1);
+            const ft::map<int, long> & c = m;
+            ranges.erase(c.split(depth, ranges.begin()), ranges.end());
+            CollectKeys collect(&visited);
+            for (std::size_t i = 0; i < ranges.size(); ++i) ranges[i].visit(collect);
+            for (ft::map<int, long>::const_iterator it = m.begin(); it != m.end(); ++it) ordered.push_back(it->first);
+        }
+        std::cout << "Depth " << depth << ": " << m.size() << " elements, in order: " << (visited == ordered) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Loads a map and a set from the given keys and values, inserting them one by one into
+ * the standard containers.
+ */
+static inline void printBulkLoad(ft::thread_pool & pool, const int * keys, const int * values, int count) {
+    if (testingFt) {
+        ft::vector<ft::pair<int, int> > input;
+        for (int i = 0; i < count; ++i) input.push_back(ft::make_pair(keys[i], values[i]));
+        ft::map<int, int> m;
+        ft::set<int>      s;
+        m[-1] = -1;
+        ft::parallel::bulk_load(pool, m, input.begin(), input.end());
+        ft::parallel::bulk_load(pool, s, keys, keys + count);
+        printInfoMap(m);
+        printInfo(s);
+    } else {
+        std::map<int, int> m;
+        std::set<int>      s;
+        for (int i = 0; i < count; ++i) {
+            m.insert(std::make_pair(keys[i], values[i]));
+            s.insert(keys[i]);
+        }
+        printInfoMap(m);
+        printInfo(s);
+    }
+}
+
+/**
+ * Fills the given set from the given sorted keys, then inserts and erases some of them.
+ */
+template<class Set>
+static inline void changeSortedSet(Set & s, const int * keys, int count) {
+    for (int i = 0; i < count; i += 3) {
+        s.erase(keys[i]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        s.insert(2 * i * count / 8 + 1);
+    }
+    printInfo(s);
+}
+
+static inline void testBulkLoad() {
+    static int keys[ARRAY_SIZE];
+    static int values[ARRAY_SIZE];
+    static int distinct[ARRAY_SIZE];
+    for (int i = 0; i < ARRAY_SIZE; ++i) {
+        keys[i]     = intArray[random() % ARRAY_SIZE] % 5000;
+        values[i]   = intArray[random() % ARRAY_SIZE];
+        distinct[i] = (i * 7919) % ARRAY_SIZE;
+    }
+    ft::thread_pool pool(4);
+
+    const int sizes[] = { 0, 1, 100, ARRAY_SIZE };
+    for (int i = 0; i < 4; ++i) {
+        std::cout << "Bulk load " << sizes[i] << " elements with equal keys" << std::endl;
+        printBulkLoad(pool, keys, values, sizes[i]);
+    }
+    std::cout << "Bulk load " << ARRAY_SIZE << " distinct elements" << std::endl;
+    printBulkLoad(pool, distinct, values, ARRAY_SIZE);
+
+    for (int count = 0; count <= 40; ++count) {
+        std::cout << "Assign " << count << " sorted keys, then insert and erase" << std::endl;
+        const int * previous = intArray + 2 * count;
+        int evens[40];
+        for (int i = 0; i < count; ++i) evens[i] = 2 * i;
+        if (testingFt) {
+            ft::set<int> s(previous, previous + 3);
+            s.assign_sorted(evens, evens + count);
+            changeSortedSet(s, evens, count);
+        } else {
+            std::set<int> s(evens, evens + count);
+            changeSortedSet(s, evens, count);
+        }
+    }
+}
+
+/**
+ * Saves the given container to a snapshot and loads it into a new one.
+ *
+ * @param c The container to be saved.
+ * @return The loaded container.
+ */
+template<class Container>
+static inline Container roundTrip(const Container & c) {
+    Container loaded;
+    ft::save("snapshot.ft", c);
+    ft::load("snapshot.ft", loaded);
+    std::remove("snapshot.ft");
+    return loaded;
+}
+
+static inline void testSnapshot() {
+    static int         numbers[ARRAY_SIZE / 4];
+    static std::string words[ARRAY_SIZE / 4];
+    for (int i = 0; i < ARRAY_SIZE / 4; ++i) {
+        numbers[i] = intArray[random() % ARRAY_SIZE];
+        words[i]   = stringArray[random() % ARRAY_SIZE];
+        words[i].erase(0, random() % 40);
+    }
+    const int count = ARRAY_SIZE / 4;
+
+    std::cout << "Snapshot of vectors" << std::endl;
+    if (testingFt) {
+        printInfo(roundTrip(ft::vector<int>(numbers, numbers + count)));
+        printInfo(roundTrip(ft::vector<std::string>(words, words + count)));
+    } else {
+        printInfo(std::vector<int>(numbers, numbers + count));
+        printInfo(std::vector<std::string>(words, words + count));
+    }
+
+    std::cout << "Snapshot of sets" << std::endl;
+    if (testingFt) {
+        printInfo(roundTrip(ft::set<int>(numbers, numbers + count)));
+        printInfo(roundTrip(ft::set<std::string>(words, words + count)));
+    } else {
+        printInfo(std::set<int>(numbers, numbers + count));
+        printInfo(std::set<std::string>(words, words + count));
+    }
+
+    std::cout << "Snapshot of maps" << std::endl;
+    if (testingFt) {
+        ft::map<int, int>         integers;
+        ft::map<int, std::string> strings;
+        ft::map<std::string, int> byWord;
+        for (int i = 0; i < count; ++i) {
+            integers[numbers[i]] = i;
+            strings[numbers[i]]  = words[i];
+            byWord[words[i]]     = numbers[i];
+        }
+        printInfoMap(roundTrip(integers));
+        printInfoMap(roundTrip(strings));
+        printInfoMap(roundTrip(byWord));
+    } else {
+        std::map<int, int>         integers;
+        std::map<int, std::string> strings;
+        std::map<std::string, int> byWord;
+        for (int i = 0; i < count; ++i) {
+            integers[numbers[i]] = i;
+            strings[numbers[i]]  = words[i];
+            byWord[words[i]]     = numbers[i];
+        }
+        printInfoMap(integers);
+        printInfoMap(strings);
+        printInfoMap(byWord);
+    }
+
+    std::cout << "Snapshot loaded with another order" << std::endl;
+    bool rejected = true;
+    if (testingFt) {
+        ft::set<std::string>                           ascending(words, words + count);
+        ft::set<std::string, std::greater<std::string> > descending(words, words + 3);
+        ft::save("snapshot.ft", ascending);
+        try {
+            ft::load("snapshot.ft", descending);
+            rejected = false;
+        } catch (const ft::snapshot_error &) {}
+        std::remove("snapshot.ft");
+        rejected = rejected && descending.size() == 3;
+    }
+    std::cout << "Rejected: " << rejected << std::endl << std::endl;
+}
+
+/**
+ * Prints the results of looking up the given keys in the given map of integers.
+ *
+ * @param m The map.
+ * @param keys The keys to be looked up.
+ * @param count The count of keys.
+ */
+template<class Map>
+static inline void printIntegerLookups(const Map & m, const int * keys, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        typename Map::const_iterator found = m.find(keys[i]),
+                                     lower = m.lower_bound(keys[i]);
+        std::cout << keys[i] << ": value " << (found == m.end() ? -1 : found->second)
+                  << ", lower bound " << (lower == m.end() ? -1 : lower->first) << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+static inline void testRegion() {
+    int numbers[ARRAY_SIZE / 8], keys[256];
+    for (int i = 0; i < ARRAY_SIZE / 8; ++i) {
+        numbers[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+    for (int i = 0; i < 256; ++i) {
+        keys[i] = static_cast<int>(random() % ARRAY_SIZE);
+    }
+    const int count = ARRAY_SIZE / 8;
+
+    typedef ft::pair<const int, int>                                                  value_type;
+    typedef ft::tree_options<0, ft::no_tree_stats, true, ft::offset_pointers>         options;
+    typedef ft::map<int, int, ft::less<int>, ft::region_allocator<value_type>, options> RegionMap;
+
+    std::cout << "Map in a memory region, searched at another address" << std::endl;
+    bool reused = true,
+         sized  = true;
+    if (testingFt) {
+        const std::size_t size   = 1 << 20;
+        void *            memory = std::malloc(size);
+        void *            moved  = std::malloc(size);
+        bool accepted = false;
+        for (std::size_t small = 0; small <= 512; small += 8) {
+            try {
+                sized    = sized && ft::memory_region::create(memory, small)->bytes_free() < small;
+                accepted = true;
+            } catch (const std::bad_alloc &) {
+                sized = sized && !accepted;
+            }
+        }
+        sized = sized && accepted;
+        ft::memory_region * region = ft::memory_region::create(memory, size);
+        ft::region_allocator<RegionMap> alloc(*region);
+        RegionMap * m = new (alloc.allocate(1)) RegionMap(ft::less<int>(), ft::region_allocator<value_type>(*region));
+        region->set_root(m);
+        for (int i = 0; i < count; ++i) {
+            (*m)[numbers[i]] = i;
+        }
+        for (int i = 0; i < count; i += 3) {
+            m->erase(numbers[i]);
+        }
+
+        void * big   = region->allocate(1024);
+        void * guard = region->allocate(1);
+        const std::size_t untouched = region->bytes_free();
+        region->deallocate(big, 1024);
+        void * front = region->allocate(512);
+        void * back  = region->allocate(512);
+        reused = front == big && back == static_cast<char *>(big) + 512 && region->bytes_free() == untouched;
+        region->deallocate(back, 512);
+        region->deallocate(front, 512);
+        region->deallocate(guard, 1);
+
+        std::memcpy(moved, memory, size);
+        std::memset(memory, 0, size);
+        const ft::memory_region * view = ft::memory_region::attach(static_cast<const void *>(moved));
+        printInfoMap(*view->get_root<RegionMap>());
+        printIntegerLookups(*view->get_root<RegionMap>(), keys, 256);
+        std::free(moved);
+        std::free(memory);
+    } else {
+        std::map<int, int> m;
+        for (int i = 0; i < count; ++i) {
+            m[numbers[i]] = i;
+        }
+        for (int i = 0; i < count; i += 3) {
+            m.erase(numbers[i]);
+        }
+        printInfoMap(m);
+        printIntegerLookups(m, keys, 256);
+    }
+    std::cout << "Split blocks reused: " << reused << std::endl;
+    std::cout << "Regions too small for their bookkeeping rejected: " << sized << std::endl << std::endl;
+}
+
 int main() {
     setup();
 
     testVector();
+    testVectorResize();
+    testVectorGrowth();
+    testMmapAllocator();
+    testIncrementalVector();
+    testArenaAllocator();
+    testCountingAllocator();
     testStack();
     testMap();
+    testMapCopyFailure();
     testSet();
+    testDeque();
+    testPriorityQueue();
+    testPriorityQueueExtensions();
+    testAlgorithm();
+    testFrozenMap();
+    testInlineMap();
+    testSmallVector();
+    testConcurrent();
+    testParallel();
+    testTreeStats();
+    testCompactNodes();
+    testParallelTree();
+    testBulkLoad();
+    testSnapshot();
+    testRegion();
 
     std::cout << "--- End of ft_containers test main ---" << std::endl;
 }